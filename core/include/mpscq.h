@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Lock-free multi-producer/single-consumer queue
+ * @details     A bounded queue of fixed-size elements for any number of
+ *              producers, e.g. several ISRs and threads, and one consumer.
+ *              Producers reserve a slot with a compare-and-swap and publish
+ *              it through a per-slot sequence number, so interrupts are
+ *              never disabled by the queue itself. On cores without
+ *              native atomic instructions the compiler falls back to the
+ *              implementations in atomic_c11.c.
+ *
+ *              A producer that is preempted between reserving and
+ *              publishing its slot delays the consumer for all elements
+ *              behind that slot until it resumes.
+ *
+ *              With `core_thread_flags` the consumer can block on the
+ *              queue, see @ref mpscq_set_consumer().
+ *
+ * @see         spscq.h for a single producer
+ */
+
+#ifndef MPSCQ_H
+#define MPSCQ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __cplusplus
+#include "c11_atomics_compat.hpp"
+#else
+#include <stdatomic.h>
+#endif
+
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of one slot of a queue in bytes
+ *
+ * A slot holds a sequence number followed by the element, rounded up to
+ * keep the sequence numbers aligned.
+ *
+ * @param[in] elem_size Size of one element in bytes
+ */
+#define MPSCQ_SLOT_SIZE(elem_size) \
+    (((sizeof(atomic_uint) + (elem_size) + sizeof(atomic_uint) - 1) / \
+      sizeof(atomic_uint)) * sizeof(atomic_uint))
+
+/**
+ * @brief   Defines static storage for a queue
+ *
+ * @param[in] name      Name of the storage
+ * @param[in] elem_size Size of one element in bytes
+ * @param[in] num       Number of elements, a power of 2
+ */
+#define MPSCQ_BUF(name, elem_size, num) \
+    static atomic_uint name[((num) * MPSCQ_SLOT_SIZE(elem_size)) / \
+                            sizeof(atomic_uint)]
+
+/**
+ * @brief   Multi-producer/single-consumer queue
+ *
+ * @note    All members are internal, use the functions below.
+ */
+typedef struct {
+    uint8_t *buf;               /**< slot storage */
+    size_t elem_size;           /**< size of one element in bytes */
+    unsigned mask;              /**< number of elements - 1 */
+    unsigned reads;             /**< number of elements read (consumer) */
+    atomic_uint writes;         /**< number of slots reserved (producers) */
+#if defined(MODULE_CORE_THREAD_FLAGS) || defined(DOXYGEN)
+    thread_t *consumer;         /**< thread to notify on put */
+    thread_flags_t flag;        /**< flag to set for @ref mpscq_t::consumer */
+#endif
+} mpscq_t;
+
+/**
+ * @brief   Initializes a queue
+ *
+ * @pre `(q != NULL) && (buf != NULL) && (elem_size > 0)`
+ * @pre @p num is a power of 2 and does not exceed (`UINT_MAX` + 1) / 2
+ *
+ * @param[out] q        The queue
+ * @param[in] buf       Storage for @p num elements, defined with
+ *                      @ref MPSCQ_BUF()
+ * @param[in] elem_size Size of one element in bytes
+ * @param[in] num       Number of elements the queue can hold
+ */
+void mpscq_init(mpscq_t *q, void *buf, size_t elem_size, unsigned num);
+
+/**
+ * @brief   Adds an element to the queue
+ *
+ * May be called by any number of producers concurrently. If a consumer
+ * was set, it is notified.
+ *
+ * @param[in] q     The queue
+ * @param[in] elem  Element of mpscq_t::elem_size bytes to copy into @p q
+ *
+ * @return  0 on success
+ * @return  -1, if @p q is full
+ */
+int mpscq_put(mpscq_t *q, const void *elem);
+
+/**
+ * @brief   Removes the oldest published element from the queue
+ *
+ * Must only be called by the consumer.
+ *
+ * @param[in] q     The queue
+ * @param[out] elem Buffer of mpscq_t::elem_size bytes for the element
+ *
+ * @return  0 on success
+ * @return  -1, if @p q is empty or the oldest element is not published yet
+ */
+int mpscq_get(mpscq_t *q, void *elem);
+
+#if defined(MODULE_CORE_THREAD_FLAGS) || defined(DOXYGEN)
+/**
+ * @brief   Sets the thread to notify when an element is put into the queue
+ *
+ * Must be called before any producer starts.
+ *
+ * @param[in] q         The queue
+ * @param[in] consumer  The consuming thread, NULL to disable notifications
+ * @param[in] flag      Thread flag to set for @p consumer on put
+ */
+void mpscq_set_consumer(mpscq_t *q, thread_t *consumer, thread_flags_t flag);
+
+/**
+ * @brief   Removes the oldest element from the queue, blocking until one is
+ *          available
+ *
+ * @pre The calling thread was set with @ref mpscq_set_consumer()
+ *
+ * @param[in] q     The queue
+ * @param[out] elem Buffer of mpscq_t::elem_size bytes for the element
+ */
+void mpscq_get_blocking(mpscq_t *q, void *elem);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPSCQ_H */
+/** @} */
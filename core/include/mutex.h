@@ -11,6 +11,17 @@
  * @defgroup    core_sync_mutex Mutex
  * @ingroup     core_sync
  * @brief       Mutex for thread synchronization
+ *
+ * Waiting threads are woken up in the order of their priority. When a thread
+ * of high priority waits for a mutex held by a thread of low priority, any
+ * thread of a priority in between can delay the waiter indefinitely by
+ * preventing the owner from running (priority inversion). With the
+ * `core_mutex_priority_inheritance` module, the owner of a mutex runs with
+ * the priority of its highest priority waiter until it unlocks the mutex. If
+ * the owner itself waits for another mutex, the priority is passed on to the
+ * owner of that mutex as well (chained inheritance). A thread holding
+ * multiple mutexes runs with the highest priority of all their waiters, in
+ * any order of unlocking.
  * @{
  *
  * @file
@@ -25,6 +36,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "kernel_types.h"
 #include "list.h"
 
 #ifdef __cplusplus
@@ -41,18 +53,38 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(DOXYGEN) || defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE)
+    /**
+     * @brief   The thread holding the mutex, KERNEL_PID_UNDEF if unknown
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Entry in the list of mutexes held by the owner
+     * @internal
+     */
+    list_node_t owned;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, { NULL } }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, { NULL } }
+#else
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -73,6 +105,10 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->owned.next = NULL;
+#endif
 }
 
 /**
@@ -153,6 +153,23 @@ thread_t *sched_run(void);
  */
 void sched_set_status(thread_t *process, thread_status_t status);
 
+/**
+ * @brief   Change the priority of the specified thread
+ *
+ * If the thread is on the run queue, it is moved to the run queue of its new
+ * priority. The running thread stays at the head of its new run queue.
+ *
+ * Like sched_set_status(), this does not yield. Call sched_switch() or
+ * thread_yield_higher() afterwards if the change may require a different
+ * thread to run. Interrupts must be disabled.
+ *
+ * @param[in]   thread      Pointer to the thread control block of the
+ *                          targeted thread
+ * @param[in]   priority    The new priority of the thread. Must be less than
+ *                          @ref SCHED_PRIO_LEVELS.
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief       Yield if appropriate.
  *
@@ -233,6 +250,60 @@ typedef void (*sched_callback_t)(kernel_pid_t active, kernel_pid_t next);
 void sched_register_cb(sched_callback_t callback);
 #endif /* MODULE_SCHED_CB */
 
+#if IS_USED(MODULE_SCHED_RUNQ_CALLBACK) || defined(DOXYGEN)
+/**
+ * @brief   Scheduler runqueue change callback
+ *
+ * Called with interrupts disabled whenever a thread is added to or removed
+ * from a runqueue, or moved between runqueues. Must be provided by the
+ * module that uses `sched_runq_callback`, e.g. `sched_round_robin`.
+ *
+ * @param[in] prio  Priority of the runqueue that changed
+ */
+void sched_runq_callback(uint8_t prio);
+#endif
+
+/**
+ * @brief   Moves the first thread of a runqueue to its end
+ *
+ * Does not yield, call @ref thread_yield_higher() to let the new first
+ * thread run.
+ *
+ * @param[in] prio  Priority of the runqueue
+ */
+static inline void sched_runq_advance(uint8_t prio)
+{
+    clist_lpoprpush(&sched_runqueues[prio]);
+}
+
+/**
+ * @brief   Checks if a runqueue is empty
+ *
+ * @param[in] prio  Priority of the runqueue
+ *
+ * @return  1, if no thread of priority @p prio is runnable
+ * @return  0, otherwise
+ */
+static inline int sched_runq_is_empty(uint8_t prio)
+{
+    return sched_runqueues[prio].next == NULL;
+}
+
+/**
+ * @brief   Checks if a runqueue holds exactly one thread
+ *
+ * @param[in] prio  Priority of the runqueue
+ *
+ * @return  1, if exactly one thread of priority @p prio is runnable
+ * @return  0, otherwise
+ */
+static inline int sched_runq_exactly_one(uint8_t prio)
+{
+    clist_node_t *last = sched_runqueues[prio].next;
+
+    return (last != NULL) && (last->next == last);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Lock-free single-producer/single-consumer queue
+ * @details     A bounded queue of fixed-size elements for exactly one
+ *              producer and one consumer, e.g. an ISR handing data over to
+ *              a thread. Neither side disables interrupts; the read and
+ *              write counters are C11 atomics. On cores without native
+ *              atomic instructions the compiler falls back to the
+ *              implementations in atomic_c11.c.
+ *
+ *              With `core_thread_flags` the consumer can block on the
+ *              queue, see @ref spscq_set_consumer().
+ *
+ * @see         mpscq.h for multiple producers
+ */
+
+#ifndef SPSCQ_H
+#define SPSCQ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __cplusplus
+#include "c11_atomics_compat.hpp"
+#else
+#include <stdatomic.h>
+#endif
+
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Single-producer/single-consumer queue
+ *
+ * @note    All members are internal, use the functions below.
+ */
+typedef struct {
+    uint8_t *buf;               /**< element storage */
+    size_t elem_size;           /**< size of one element in bytes */
+    unsigned mask;              /**< number of elements - 1 */
+    atomic_uint reads;          /**< number of elements read (consumer) */
+    atomic_uint writes;         /**< number of elements written (producer) */
+#if defined(MODULE_CORE_THREAD_FLAGS) || defined(DOXYGEN)
+    thread_t *consumer;         /**< thread to notify on put */
+    thread_flags_t flag;        /**< flag to set for @ref spscq_t::consumer */
+#endif
+} spscq_t;
+
+/**
+ * @brief   Initializes a queue
+ *
+ * @pre `(q != NULL) && (buf != NULL) && (elem_size > 0)`
+ * @pre @p num is a power of 2 and does not exceed (`UINT_MAX` + 1) / 2
+ *
+ * @param[out] q        The queue
+ * @param[in] buf       Storage for at least `num * elem_size` bytes
+ * @param[in] elem_size Size of one element in bytes
+ * @param[in] num       Number of elements the queue can hold
+ */
+void spscq_init(spscq_t *q, void *buf, size_t elem_size, unsigned num);
+
+/**
+ * @brief   Adds an element to the queue
+ *
+ * Must only be called by the producer. If a consumer was set, it is
+ * notified.
+ *
+ * @param[in] q     The queue
+ * @param[in] elem  Element of spscq_t::elem_size bytes to copy into @p q
+ *
+ * @return  0 on success
+ * @return  -1, if @p q is full
+ */
+int spscq_put(spscq_t *q, const void *elem);
+
+/**
+ * @brief   Removes the oldest element from the queue
+ *
+ * Must only be called by the consumer.
+ *
+ * @param[in] q     The queue
+ * @param[out] elem Buffer of spscq_t::elem_size bytes for the element
+ *
+ * @return  0 on success
+ * @return  -1, if @p q is empty
+ */
+int spscq_get(spscq_t *q, void *elem);
+
+/**
+ * @brief   Gets the number of elements in the queue
+ *
+ * The result is only a snapshot if called by neither producer nor
+ * consumer.
+ *
+ * @param[in] q The queue
+ *
+ * @return  Number of elements in @p q
+ */
+unsigned spscq_avail(spscq_t *q);
+
+#if defined(MODULE_CORE_THREAD_FLAGS) || defined(DOXYGEN)
+/**
+ * @brief   Sets the thread to notify when an element is put into the queue
+ *
+ * Must be called before the producer starts.
+ *
+ * @param[in] q         The queue
+ * @param[in] consumer  The consuming thread, NULL to disable notifications
+ * @param[in] flag      Thread flag to set for @p consumer on put
+ */
+void spscq_set_consumer(spscq_t *q, thread_t *consumer, thread_flags_t flag);
+
+/**
+ * @brief   Removes the oldest element from the queue, blocking until one is
+ *          available
+ *
+ * @pre The calling thread was set with @ref spscq_set_consumer()
+ *
+ * @param[in] q     The queue
+ * @param[out] elem Buffer of spscq_t::elem_size bytes for the element
+ */
+void spscq_get_blocking(spscq_t *q, void *elem);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSCQ_H */
+/** @} */
@@ -165,9 +165,15 @@ struct _thread {
     clist_node_t rq_entry;          /**< run queue entry                */
 
 #if defined(MODULE_CORE_MSG) || defined(MODULE_CORE_THREAD_FLAGS) \
-    || defined(MODULE_CORE_MBOX) || defined(DOXYGEN)
-    void *wait_data;                /**< used by msg, mbox and thread
-                                         flags                          */
+    || defined(MODULE_CORE_MBOX) \
+    || defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    void *wait_data;                /**< used by msg, mbox, thread flags
+                                         and mutex priority inheritance */
+#endif
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    uint8_t base_priority;          /**< priority without inherited
+                                         priorities                     */
+    list_node_t mutexes;            /**< mutexes held by this thread    */
 #endif
 #if defined(MODULE_CORE_MSG) || defined(DOXYGEN)
     list_node_t msg_waiters;        /**< threads waiting for their message
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Lock-free multi-producer/single-consumer queue
+ *              implementation
+ *
+ * Each slot carries a sequence number. A slot at position `pos` is free for
+ * a producer if its sequence number is `pos`, and holds a published element
+ * for the consumer if it is `pos + 1`. The consumer frees a slot by setting
+ * it to `pos + num`, the position the slot will have in the next round.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "assert.h"
+#include "mpscq.h"
+
+static inline atomic_uint *_slot(mpscq_t *q, unsigned pos)
+{
+    return (atomic_uint *)&q->buf[(pos & q->mask) *
+                                  MPSCQ_SLOT_SIZE(q->elem_size)];
+}
+
+static inline void _notify(mpscq_t *q)
+{
+#ifdef MODULE_CORE_THREAD_FLAGS
+    if (q->consumer != NULL) {
+        thread_flags_set(q->consumer, q->flag);
+    }
+#else
+    (void)q;
+#endif
+}
+
+void mpscq_init(mpscq_t *q, void *buf, size_t elem_size, unsigned num)
+{
+    /* check if num is a power of 2 by comparing it to its complement */
+    assert((q != NULL) && (buf != NULL) && (elem_size > 0) &&
+           (num > 0) && (num == (num & ~(num - 1))));
+    q->buf = buf;
+    q->elem_size = elem_size;
+    q->mask = num - 1;
+    q->reads = 0;
+    atomic_init(&q->writes, 0);
+    for (unsigned i = 0; i < num; i++) {
+        atomic_init(_slot(q, i), i);
+    }
+#ifdef MODULE_CORE_THREAD_FLAGS
+    q->consumer = NULL;
+    q->flag = 0;
+#endif
+}
+
+int mpscq_put(mpscq_t *q, const void *elem)
+{
+    unsigned pos = atomic_load_explicit(&q->writes, memory_order_relaxed);
+    atomic_uint *slot;
+
+    while (1) {
+        int diff;
+
+        slot = _slot(q, pos);
+        diff = (int)(atomic_load_explicit(slot, memory_order_acquire) - pos);
+        if (diff == 0) {
+            /* slot is free, try to reserve it. On failure pos is updated */
+            if (atomic_compare_exchange_weak_explicit(&q->writes, &pos,
+                                                      pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            /* consumer has not freed the slot of the previous round */
+            return -1;
+        }
+        else {
+            /* another producer reserved the slot already */
+            pos = atomic_load_explicit(&q->writes, memory_order_relaxed);
+        }
+    }
+    memcpy(slot + 1, elem, q->elem_size);
+    /* publish the element to the consumer */
+    atomic_store_explicit(slot, pos + 1, memory_order_release);
+    _notify(q);
+    return 0;
+}
+
+int mpscq_get(mpscq_t *q, void *elem)
+{
+    unsigned pos = q->reads;
+    atomic_uint *slot = _slot(q, pos);
+
+    if (atomic_load_explicit(slot, memory_order_acquire) != (pos + 1)) {
+        return -1;
+    }
+    memcpy(elem, slot + 1, q->elem_size);
+    q->reads = pos + 1;
+    /* hand the slot to the producers of the next round */
+    atomic_store_explicit(slot, pos + q->mask + 1, memory_order_release);
+    return 0;
+}
+
+#ifdef MODULE_CORE_THREAD_FLAGS
+void mpscq_set_consumer(mpscq_t *q, thread_t *consumer, thread_flags_t flag)
+{
+    q->consumer = consumer;
+    q->flag = flag;
+}
+
+void mpscq_get_blocking(mpscq_t *q, void *elem)
+{
+    assert(q->consumer == thread_get_active());
+    /* flags are sticky, so an element published between mpscq_get() and
+     * waiting is not missed */
+    while (mpscq_get(q, elem) != 0) {
+        thread_flags_wait_any(q->flag);
+    }
+}
+#endif
@@ -34,6 +34,8 @@
 #include "irq.h"
 #include "cib.h"
 
+#include "trace.h"
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -101,6 +103,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
         return -1;
     }
 
+    trace_event(TRACE_EVENT_MSG_SEND, target_pid);
+
     thread_t *me = thread_get_active();
 
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
@@ -231,6 +235,9 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     m->sender_pid = KERNEL_PID_ISR;
 
     res = _msg_send_oneway(m, target_pid);
+    if (res >= 0) {
+        trace_event(TRACE_EVENT_MSG_SEND, target_pid);
+    }
 
     return res;
 }
@@ -253,6 +260,7 @@ int msg_send_bus(msg_t *m, msg_bus_t *bus)
         }
 
         if (_msg_send_oneway(m, subscriber->pid) > 0) {
+            trace_event(TRACE_EVENT_MSG_SEND, subscriber->pid);
             ++count;
         }
     }
@@ -278,7 +286,12 @@ int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
      * overwritten if the target is not in RECEIVE_BLOCKED */
     *reply = *m;
     /* msg_send blocks until reply received */
-    return _msg_send(reply, target_pid, true, state);
+    int res = _msg_send(reply, target_pid, true, state);
+
+    if (res > 0) {
+        trace_event(TRACE_EVENT_MSG_RECV, target_pid);
+    }
+    return res;
 }
 
 int msg_reply(msg_t *m, msg_t *reply)
@@ -299,6 +312,7 @@ int msg_reply(msg_t *m, msg_t *reply)
 
     DEBUG("msg_reply(): %" PRIkernel_pid ": Direct msg copy.\n",
           thread_getpid());
+    trace_event(TRACE_EVENT_MSG_SEND, target->pid);
     /* copy msg to target */
     msg_t *target_message = (msg_t *)target->wait_data;
     *target_message = *reply;
@@ -321,6 +335,7 @@ int msg_reply_int(msg_t *m, msg_t *reply)
         return -1;
     }
 
+    trace_event(TRACE_EVENT_MSG_SEND, target->pid);
     msg_t *target_message = (msg_t *)target->wait_data;
     *target_message = *reply;
     sched_set_status(target, STATUS_PENDING);
@@ -330,12 +345,20 @@ int msg_reply_int(msg_t *m, msg_t *reply)
 
 int msg_try_receive(msg_t *m)
 {
-    return _msg_receive(m, 0);
+    int res = _msg_receive(m, 0);
+
+    if (res > 0) {
+        trace_event(TRACE_EVENT_MSG_RECV, m->sender_pid);
+    }
+    return res;
 }
 
 int msg_receive(msg_t *m)
 {
-    return _msg_receive(m, 1);
+    int res = _msg_receive(m, 1);
+
+    trace_event(TRACE_EVENT_MSG_RECV, m->sender_pid);
+    return res;
 }
 
 static int _msg_receive(msg_t *m, int block)
@@ -20,6 +20,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <inttypes.h>
 
@@ -29,9 +30,114 @@
 #include "irq.h"
 #include "list.h"
 
+#include "trace.h"
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+/* Only mutexes with waiters are kept in the list of their owner: a thread may
+ * lock a mutex it never unlocks, e.g. one on its stack used to wait for an
+ * ISR, and must not leave a dangling list entry behind. */
+static inline void _link_owned(mutex_t *mutex, thread_t *owner)
+{
+    /* waiters that timed out may have left the mutex in the list */
+    list_remove(&owner->mutexes, &mutex->owned);
+    mutex->owned.next = owner->mutexes.next;
+    owner->mutexes.next = &mutex->owned;
+}
+
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    if (owner != NULL) {
+        mutex->owner = owner->pid;
+        if ((mutex->queue.next != NULL) &&
+            (mutex->queue.next != MUTEX_LOCKED)) {
+            _link_owned(mutex, owner);
+        }
+    }
+    else {
+        mutex->owner = KERNEL_PID_UNDEF;
+    }
+}
+
+static void _inherit_priority(mutex_t *mutex, uint8_t priority)
+{
+    thread_t *owner;
+
+    /* boost the owner and, if it waits for another mutex, that mutex' owner
+     * and so on */
+    while (((owner = thread_get(mutex->owner)) != NULL) &&
+           (owner->priority > priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: inheriting priority %" PRIu8
+              " to %" PRIkernel_pid "\n", thread_getpid(), priority,
+              owner->pid);
+        sched_change_priority(owner, priority);
+        if (owner->status != STATUS_MUTEX_BLOCKED) {
+            break;
+        }
+        mutex = owner->wait_data;
+        /* keep the waiting queue sorted by priority */
+        list_remove(&mutex->queue, (list_node_t *)&owner->rq_entry);
+        thread_add_to_list(&mutex->queue, owner);
+    }
+}
+
+/* Removes the mutex from its owner's list and recomputes the owner's
+ * priority from the waiters of the mutexes it still holds. Must be called
+ * before the mutex gets a new owner. Returns true if the priority of the
+ * owner was lowered. */
+static bool _restore_priority(mutex_t *mutex)
+{
+    thread_t *owner = thread_get(mutex->owner);
+    uint8_t priority;
+
+    if (owner == NULL) {
+        return false;
+    }
+    list_remove(&owner->mutexes, &mutex->owned);
+    /* the waiting queues are sorted, so the first waiter of each mutex still
+     * held determines the priority to keep */
+    priority = owner->base_priority;
+    for (list_node_t *n = owner->mutexes.next; n != NULL; n = n->next) {
+        mutex_t *held = container_of(n, mutex_t, owned);
+
+        if ((held->queue.next != NULL) && (held->queue.next != MUTEX_LOCKED)) {
+            thread_t *waiter = container_of((clist_node_t *)held->queue.next,
+                                            thread_t, rq_entry);
+            if (waiter->priority < priority) {
+                priority = waiter->priority;
+            }
+        }
+    }
+    if (owner->priority != priority) {
+        DEBUG("PID[%" PRIkernel_pid "]: restoring priority %" PRIu8 "\n",
+              owner->pid, priority);
+        sched_change_priority(owner, priority);
+        if (owner->status == STATUS_MUTEX_BLOCKED) {
+            /* keep the waiting queue sorted by priority */
+            mutex = owner->wait_data;
+            list_remove(&mutex->queue, (list_node_t *)&owner->rq_entry);
+            thread_add_to_list(&mutex->queue, owner);
+        }
+        return true;
+    }
+    return false;
+}
+#else
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    (void)mutex;
+    (void)owner;
+}
+
+static inline bool _restore_priority(mutex_t *mutex)
+{
+    (void)mutex;
+    return false;
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
 {
     unsigned irqstate = irq_disable();
@@ -41,6 +147,10 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        /* the owner is unknown if the mutex is taken from an ISR */
+        _set_owner(mutex, irq_is_in() ? NULL : thread_get_active());
+#endif
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               thread_getpid());
         irq_restore(irqstate);
@@ -58,10 +168,21 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        me->wait_data = mutex;
+        thread_t *owner = thread_get(mutex->owner);
+        if ((owner != NULL) && (mutex->queue.next->next == NULL)) {
+            /* first waiter */
+            _link_owned(mutex, owner);
+        }
+        _inherit_priority(mutex, me->priority);
+#endif
+        trace_event(TRACE_EVENT_MUTEX_WAIT, (uintptr_t)mutex);
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
          * We have the mutex now. */
+        trace_event(TRACE_EVENT_MUTEX_ACQUIRE, (uintptr_t)mutex);
         return 1;
     }
     else {
@@ -86,7 +207,14 @@ void mutex_unlock(mutex_t *mutex)
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
+        /* the owner may still be boosted by waiters that timed out */
+        bool lowered = _restore_priority(mutex);
+        _set_owner(mutex, NULL);
         irq_restore(irqstate);
+        if (lowered) {
+            /* let the scheduler decide if the owner may continue */
+            sched_switch(0);
+        }
         return;
     }
 
@@ -102,6 +230,9 @@ void mutex_unlock(mutex_t *mutex)
         mutex->queue.next = MUTEX_LOCKED;
     }
 
+    _restore_priority(mutex);
+    _set_owner(mutex, process);
+
     uint16_t process_priority = process->priority;
     irq_restore(irqstate);
     sched_switch(process_priority);
@@ -114,8 +245,10 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+        _restore_priority(mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
+            _set_owner(mutex, NULL);
         }
         else {
             list_node_t *next = list_remove_head(&mutex->queue);
@@ -126,6 +259,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+            _set_owner(mutex, process);
         }
     }
 
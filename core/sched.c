@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 
+#include "assert.h"
 #include "sched.h"
 #include "clist.h"
 #include "bitarithm.h"
@@ -32,6 +33,8 @@
 #include "mpu.h"
 #endif
 
+#include "trace.h"
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -191,6 +194,9 @@ thread_t *__attribute__((used)) sched_run(void)
         sched_active_pid = next_thread->pid;
         sched_active_thread = next_thread;
 
+        trace_event(TRACE_EVENT_SCHED, (previous_thread == NULL)
+                    ? KERNEL_PID_UNDEF : previous_thread->pid);
+
 #ifdef MODULE_SCHED_CB
         if (sched_cb) {
             sched_cb(KERNEL_PID_UNDEF, next_thread->pid);
@@ -224,6 +230,9 @@ void sched_set_status(thread_t *process, thread_status_t status)
             clist_rpush(&sched_runqueues[process->priority],
                         &(process->rq_entry));
             _set_runqueue_bit(process);
+#if IS_USED(MODULE_SCHED_RUNQ_CALLBACK)
+            sched_runq_callback(process->priority);
+#endif
         }
     }
     else {
@@ -236,12 +245,53 @@ void sched_set_status(thread_t *process, thread_status_t status)
             if (!sched_runqueues[process->priority].next) {
                 _clear_runqueue_bit(process);
             }
+#if IS_USED(MODULE_SCHED_RUNQ_CALLBACK)
+            sched_runq_callback(process->priority);
+#endif
         }
     }
 
     process->status = status;
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert((thread != NULL) && (priority < SCHED_PRIO_LEVELS));
+
+    if (thread->priority == priority) {
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid " priority %" PRIu8
+          " -> %" PRIu8 "\n", thread->pid, thread->priority, priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+#if IS_USED(MODULE_SCHED_RUNQ_CALLBACK)
+        uint8_t old_priority = thread->priority;
+#endif
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            _clear_runqueue_bit(thread);
+        }
+        thread->priority = priority;
+        /* the running thread is expected at the head of its run queue */
+        if (thread == thread_get_active()) {
+            clist_lpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        else {
+            clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        _set_runqueue_bit(thread);
+#if IS_USED(MODULE_SCHED_RUNQ_CALLBACK)
+        sched_runq_callback(old_priority);
+        sched_runq_callback(priority);
+#endif
+    }
+    else {
+        thread->priority = priority;
+    }
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = thread_get_active();
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Lock-free single-producer/single-consumer queue
+ *              implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "assert.h"
+#include "spscq.h"
+
+static inline void _notify(spscq_t *q)
+{
+#ifdef MODULE_CORE_THREAD_FLAGS
+    if (q->consumer != NULL) {
+        thread_flags_set(q->consumer, q->flag);
+    }
+#else
+    (void)q;
+#endif
+}
+
+void spscq_init(spscq_t *q, void *buf, size_t elem_size, unsigned num)
+{
+    /* check if num is a power of 2 by comparing it to its complement */
+    assert((q != NULL) && (buf != NULL) && (elem_size > 0) &&
+           (num > 0) && (num == (num & ~(num - 1))));
+    q->buf = buf;
+    q->elem_size = elem_size;
+    q->mask = num - 1;
+    atomic_init(&q->reads, 0);
+    atomic_init(&q->writes, 0);
+#ifdef MODULE_CORE_THREAD_FLAGS
+    q->consumer = NULL;
+    q->flag = 0;
+#endif
+}
+
+int spscq_put(spscq_t *q, const void *elem)
+{
+    /* only the producer writes `writes`, so no ordering needed */
+    unsigned writes = atomic_load_explicit(&q->writes, memory_order_relaxed);
+    /* pairs with the release in spscq_get(): the slot is free to reuse */
+    unsigned reads = atomic_load_explicit(&q->reads, memory_order_acquire);
+
+    if ((writes - reads) > q->mask) {
+        return -1;
+    }
+    memcpy(&q->buf[(writes & q->mask) * q->elem_size], elem, q->elem_size);
+    /* publish the element to the consumer */
+    atomic_store_explicit(&q->writes, writes + 1, memory_order_release);
+    _notify(q);
+    return 0;
+}
+
+int spscq_get(spscq_t *q, void *elem)
+{
+    unsigned reads = atomic_load_explicit(&q->reads, memory_order_relaxed);
+    unsigned writes = atomic_load_explicit(&q->writes, memory_order_acquire);
+
+    if (writes == reads) {
+        return -1;
+    }
+    memcpy(elem, &q->buf[(reads & q->mask) * q->elem_size], q->elem_size);
+    /* hand the slot back to the producer */
+    atomic_store_explicit(&q->reads, reads + 1, memory_order_release);
+    return 0;
+}
+
+unsigned spscq_avail(spscq_t *q)
+{
+    unsigned reads = atomic_load_explicit(&q->reads, memory_order_acquire);
+
+    return atomic_load_explicit(&q->writes, memory_order_acquire) - reads;
+}
+
+#ifdef MODULE_CORE_THREAD_FLAGS
+void spscq_set_consumer(spscq_t *q, thread_t *consumer, thread_flags_t flag)
+{
+    q->consumer = consumer;
+    q->flag = flag;
+}
+
+void spscq_get_blocking(spscq_t *q, void *elem)
+{
+    assert(q->consumer == thread_get_active());
+    /* flags are sticky, so an element put between spscq_get() and waiting
+     * is not missed */
+    while (spscq_get(q, elem) != 0) {
+        thread_flags_wait_any(q->flag);
+    }
+}
+#endif
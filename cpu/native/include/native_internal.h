@@ -135,6 +135,7 @@ extern int (*real_fputc)(int c, FILE *stream);
 extern int (*real_fgetc)(FILE *stream);
 extern mode_t (*real_umask)(mode_t cmask);
 extern ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
+extern ssize_t (*real_readv)(int fildes, const struct iovec *iov, int iovcnt);
 
 #ifdef __MACH__
 #else
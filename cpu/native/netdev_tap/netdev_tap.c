@@ -68,6 +68,7 @@
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static int _recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info);
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -158,6 +159,7 @@ static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t value_len
 static const netdev_driver_t netdev_driver_tap = {
     .send = _send,
     .recv = _recv,
+    .recv_iol = _recv_iol,
     .init = _init,
     .isr = _isr,
     .get = _get,
@@ -165,13 +167,13 @@ static const netdev_driver_t netdev_driver_tap = {
 };
 
 /* driver implementation */
-static inline bool _is_addr_broadcast(uint8_t *addr)
+static inline bool _is_addr_broadcast(const uint8_t *addr)
 {
     return ((addr[0] == 0xff) && (addr[1] == 0xff) && (addr[2] == 0xff) &&
             (addr[3] == 0xff) && (addr[4] == 0xff) && (addr[5] == 0xff));
 }
 
-static inline bool _is_addr_multicast(uint8_t *addr)
+static inline bool _is_addr_multicast(const uint8_t *addr)
 {
     /* source: http://ieee802.org/secmail/pdfocSP2xXA6d.pdf */
     return (addr[0] & 0x01);
@@ -204,6 +206,45 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
+static int _handle_read(netdev_tap_t *dev, const uint8_t *dst, int nread)
+{
+    if (nread > 0) {
+        if (!(dev->promiscuous) && !_is_addr_multicast(dst) &&
+            !_is_addr_broadcast(dst) &&
+            (memcmp(dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
+                  "That's not me => Dropped\n",
+                  dst[0], dst[1], dst[2], dst[3], dst[4], dst[5]);
+
+            native_async_read_continue(dev->tap_fd);
+
+            return 0;
+        }
+
+        _continue_reading(dev);
+
+        return nread;
+    }
+    else if (nread == -1) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+        }
+        else {
+            err(EXIT_FAILURE, "netdev_tap: read");
+        }
+    }
+    else if (nread == 0) {
+        DEBUG("_native_handle_tap_input: ignoring null-event\n");
+    }
+    else {
+        errx(EXIT_FAILURE, "internal error _rx_event");
+    }
+
+    return -1;
+}
+
+/* takes frames, or the part of a frame, nobody has room for */
+static uint8_t _discard_buf[ETHERNET_FRAME_LEN];
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
@@ -222,9 +263,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
             }
             */
 
-            static uint8_t nullbuf[ETHERNET_FRAME_LEN];
-
-            real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
+            real_read(dev->tap_fd, _discard_buf, sizeof(_discard_buf));
 
             _continue_reading(dev);
         }
@@ -237,40 +276,51 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     int nread = real_read(dev->tap_fd, buf, len);
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
-    if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscuous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
-            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
-                  "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
-
-            native_async_read_continue(dev->tap_fd);
+    return _handle_read(dev, ((ethernet_hdr_t *)buf)->dst, nread);
+}
 
-            return 0;
-        }
+static int _recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    uint8_t dst[ETHERNET_ADDR_LEN];
+    size_t size = iolist_size(iolist);
+    struct iovec iov[iolist_count(iolist) + 1];
+    unsigned n;
+    (void)info;
 
+    /* the tap device drops what does not fit, so read the rest of a frame too
+     * large for iolist into the discard buffer to detect it */
+    iolist_to_iovec(iolist, iov, &n);
+    iov[n].iov_base = _discard_buf;
+    iov[n].iov_len = sizeof(_discard_buf);
+    int nread = real_readv(dev->tap_fd, iov, n + 1);
+    DEBUG("netdev_tap: read %d bytes into %u buffers\n", nread, n);
+
+    if (nread > (int)size) {
+        DEBUG("netdev_tap: frame of %d bytes truncated to %u bytes\n",
+              nread, (unsigned)size);
         _continue_reading(dev);
-
-        return nread;
+        return -ENOBUFS;
     }
-    else if (nread == -1) {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-        }
-        else {
-            err(EXIT_FAILURE, "netdev_tap: read");
-        }
-    }
-    else if (nread == 0) {
-        DEBUG("_native_handle_tap_input: ignoring null-event\n");
+    if ((nread > 0) && (nread < ETHERNET_ADDR_LEN)) {
+        DEBUG("netdev_tap: frame of %d bytes too short => Dropped\n", nread);
+        native_async_read_continue(dev->tap_fd);
+        return 0;
     }
-    else {
-        errx(EXIT_FAILURE, "internal error _rx_event");
+
+    /* the destination address may be split up between multiple buffers */
+    for (size_t pos = 0; (nread > 0) && (iolist != NULL) && (pos < sizeof(dst));
+         iolist = iolist->iol_next) {
+        size_t cpy = sizeof(dst) - pos;
+
+        if (cpy > iolist->iol_len) {
+            cpy = iolist->iol_len;
+        }
+        memcpy(&dst[pos], iolist->iol_base, cpy);
+        pos += cpy;
     }
 
-    return -1;
+    return _handle_read(dev, dst, nread);
 }
 
 static int _send(netdev_t *netdev, const iolist_t *iolist)
@@ -0,0 +1,221 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Script to convert the output of `trace_events_dump()` (provided by the
+`trace_events` pseudo-module) to the Chrome trace event format, which can be
+viewed in Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+"""
+
+import argparse
+import collections
+import json
+import re
+import struct
+import sys
+
+PREFIX = "trace_events: "
+RECORD = struct.Struct("<IBBH")
+
+(USER, SCHED, MSG_SEND, MSG_RECV, MUTEX_WAIT, MUTEX_ACQUIRE, ISR_ENTER,
+ ISR_EXIT, PKTBUF_ALLOC, PKTBUF_FREE) = range(10)
+
+KERNEL_PID_UNDEF = 0
+# thread ID of the interrupt track in the output
+ISR_TID = 0x10000
+
+HEADER_RE = re.compile(r"v1 hz=(\d+) records=(\d+) lost=(\d+)(?: isr=(\d+))?")
+THREAD_RE = re.compile(r"thread (\d+) (.*)")
+RECORDS_RE = re.compile(r"([0-9a-f]{16})+$")
+
+
+class Trace:
+    def __init__(self):
+        self.hz = None
+        self.lost = 0
+        # PID recorded for events in interrupt context, KERNEL_PID_ISR
+        self.isr_pid = None
+        self.threads = {}
+        self.records = []
+
+
+def parse(lines):
+    """Returns the traces dumped in lines, in order"""
+    traces = []
+    trace = None
+    for line in lines:
+        idx = line.find(PREFIX)
+        if idx < 0:
+            continue
+        line = line[idx + len(PREFIX):].strip()
+        match = HEADER_RE.match(line)
+        if match:
+            trace = Trace()
+            trace.hz = int(match.group(1))
+            trace.lost = int(match.group(3))
+            if match.group(4) is not None:
+                trace.isr_pid = int(match.group(4))
+            traces.append(trace)
+            continue
+        if trace is None:
+            continue
+        match = THREAD_RE.match(line)
+        if match:
+            trace.threads[int(match.group(1))] = match.group(2)
+        elif RECORDS_RE.match(line):
+            data = bytes.fromhex(line)
+            trace.records.extend(RECORD.iter_unpack(data))
+        elif line == "end":
+            trace = None
+    return traces
+
+
+def timestamps(records, hz):
+    """Yields the records with their timestamp in microseconds, the 32 bit
+    counter is assumed to wrap at most once between two records"""
+    offset = 0
+    last = None
+    for time, type_, pid, arg in records:
+        if last is not None and time < last:
+            offset += 1 << 32
+        last = time
+        yield (offset + time) * 1000000 / hz, type_, pid, arg
+
+
+class Stats:
+    def __init__(self):
+        self.values = []
+
+    def add(self, value):
+        self.values.append(value)
+
+    def __str__(self):
+        return "n={:<6d} min={:<10.3f} avg={:<10.3f} max={:.3f}".format(
+            len(self.values), min(self.values),
+            sum(self.values) / len(self.values), max(self.values))
+
+
+def convert(trace, hz=None):
+    """Returns the trace events in Chrome format and latency statistics"""
+    hz = hz or trace.hz
+    if not hz:
+        raise ValueError("timestamp frequency unknown, use --hz")
+    events = [{"name": "process_name", "ph": "M", "pid": 0, "tid": 0,
+               "args": {"name": "RIOT"}},
+              {"name": "thread_name", "ph": "M", "pid": 0, "tid": ISR_TID,
+               "args": {"name": "ISR"}}]
+    for pid, name in trace.threads.items():
+        events.append({"name": "thread_name", "ph": "M", "pid": 0,
+                       "tid": pid, "args": {"name": "{} ({})".format(name,
+                                                                    pid)}})
+
+    def slice_(name, tid, begin, end, **args):
+        events.append({"name": name, "ph": "X", "pid": 0, "tid": tid,
+                       "ts": begin, "dur": end - begin, "args": args})
+
+    running = None      # (pid, since) of the thread running
+    isrs = []           # stack of (irq, since) of the ISRs running
+    waits = {}          # pid -> (mutex, since) of blocked threads
+    msgs = collections.defaultdict(collections.deque)   # (from, to) -> sends
+    flow = 0
+    pktbuf = 0
+    msg_latency = collections.defaultdict(Stats)
+    mutex_latency = collections.defaultdict(Stats)
+    ts = 0
+    for ts, type_, pid, arg in timestamps(trace.records, hz):
+        # only native reports ISR entry and exit, other CPUs record events
+        # in interrupt context with the ISR PID
+        in_isr = bool(isrs) or (pid == trace.isr_pid)
+        tid = ISR_TID if in_isr else pid
+        if type_ == SCHED:
+            if running is not None:
+                slice_("running", running[0], running[1], ts)
+            running = (pid, ts)
+        elif type_ == MSG_SEND:
+            sender = trace.isr_pid if in_isr else pid
+            flow += 1
+            msgs[(sender, arg)].append((flow, ts))
+            slice_("msg_send to {}".format(arg), tid, ts, ts, target=arg)
+            events.append({"name": "msg", "cat": "msg", "ph": "s",
+                           "id": flow, "pid": 0, "tid": tid, "ts": ts})
+        elif type_ == MSG_RECV:
+            slice_("msg_receive from {}".format(arg), tid, ts, ts, sender=arg)
+            pending = msgs.get((arg, pid))
+            if pending:
+                id_, sent = pending.popleft()
+                msg_latency[pid].add(ts - sent)
+                events.append({"name": "msg", "cat": "msg", "ph": "f",
+                               "bp": "e", "id": id_, "pid": 0, "tid": tid,
+                               "ts": ts})
+        elif type_ == MUTEX_WAIT:
+            waits[pid] = (arg, ts)
+        elif type_ == MUTEX_ACQUIRE:
+            if pid in waits:
+                mutex, since = waits.pop(pid)
+                mutex_latency[mutex].add(ts - since)
+                slice_("mutex 0x{:04x} wait".format(mutex), pid, since, ts,
+                       mutex=mutex)
+        elif type_ == ISR_ENTER:
+            isrs.append((arg, ts))
+        elif type_ == ISR_EXIT:
+            if isrs:
+                irq, since = isrs.pop()
+                slice_("irq {}".format(irq), ISR_TID, since, ts, irq=irq)
+        elif type_ in (PKTBUF_ALLOC, PKTBUF_FREE):
+            pktbuf += arg if type_ == PKTBUF_ALLOC else -arg
+            events.append({"name": "pktbuf", "ph": "C", "pid": 0, "ts": ts,
+                           "args": {"bytes": pktbuf}})
+        elif type_ == USER:
+            events.append({"name": "user {}".format(arg), "ph": "i", "s": "t",
+                           "pid": 0, "tid": tid, "ts": ts,
+                           "args": {"value": arg}})
+    if running is not None:
+        slice_("running", running[0], running[1], ts)
+    return events, msg_latency, mutex_latency
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("infile", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="output of trace_events_dump() (default: stdin)")
+    parser.add_argument("-o", "--outfile", type=argparse.FileType("w"),
+                        default=sys.stdout,
+                        help="trace in Chrome JSON format (default: stdout)")
+    parser.add_argument("--hz", type=int, default=None,
+                        help="timestamp frequency, overrides the one dumped")
+    parser.add_argument("-n", "--number", type=int, default=-1,
+                        help="index of the dump to convert, if the input "
+                             "contains multiple (default: the last one)")
+    parser.add_argument("-s", "--stats", action="store_true",
+                        help="print message and mutex latencies to stderr")
+    args = parser.parse_args()
+
+    traces = parse(args.infile)
+    if not traces:
+        sys.exit("no trace_events_dump() output found")
+    trace = traces[args.number]
+    if trace.lost:
+        print("{} records were overwritten before the dump".format(trace.lost),
+              file=sys.stderr)
+    try:
+        events, msg_latency, mutex_latency = convert(trace, args.hz)
+    except ValueError as exc:
+        sys.exit(str(exc))
+    json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, args.outfile)
+    if args.stats:
+        for pid, stats in sorted(msg_latency.items()):
+            print("msg latency to thread {:<3d} [us]: {}".format(pid, stats),
+                  file=sys.stderr)
+        for mutex, stats in sorted(mutex_latency.items()):
+            print("mutex 0x{:04x} wait [us]:        {}".format(mutex, stats),
+                  file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -359,6 +359,52 @@ static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
     return (int)size;
 }
 
+static int nd_recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    enc28j60_t *dev = (enc28j60_t *)netdev;
+    uint8_t head[6];
+    uint16_t size;
+    uint16_t next;
+    int res;
+
+    (void)info;
+    mutex_lock(&dev->lock);
+
+    /* set read pointer to RX read address */
+    uint16_t rx_rd_ptr = cmd_r_addr(dev, ADDR_RX_READ);
+    cmd_w_addr(dev, ADDR_READ_PTR, ERXRDPT_TO_NEXT(rx_rd_ptr));
+    /* read packet header */
+    cmd_rbm(dev, head, 6);
+    next = (uint16_t)((head[1] << 8) | head[0]);
+    size = (uint16_t)((head[3] << 8) | head[2]) - 4;  /* discard CRC */
+
+    DEBUG("[enc28j60] recv_iol: size=%i next=%i\n", (int)size, (int)next);
+
+    if (size <= iolist_size(iolist)) {
+        /* the read pointer auto-increments, so the frame can be read
+         * piecewise straight into the supplied buffers */
+        res = size;
+        for (; size > 0; iolist = iolist->iol_next) {
+            uint16_t len = (iolist->iol_len < size) ? iolist->iol_len : size;
+
+            if (len > 0) {
+                cmd_rbm(dev, iolist->iol_base, len);
+                size -= len;
+            }
+        }
+    }
+    else {
+        DEBUG("[enc28j60] recv_iol: unable to get packet - buffer too small\n");
+        res = -ENOBUFS;
+    }
+    /* release memory */
+    cmd_w_addr(dev, ADDR_RX_READ, NEXT_TO_ERXRDPT(next));
+    cmd_bfs(dev, REG_ECON2, -1, ECON2_PKTDEC);
+
+    mutex_unlock(&dev->lock);
+    return res;
+}
+
 static int nd_init(netdev_t *netdev)
 {
     enc28j60_t *dev = (enc28j60_t *)netdev;
@@ -533,6 +579,7 @@ static int nd_set(netdev_t *netdev, netopt_t opt, const void *value, size_t valu
 static const netdev_driver_t netdev_driver_enc28j60 = {
     .send = nd_send,
     .recv = nd_recv,
+    .recv_iol = nd_recv_iol,
     .init = nd_init,
     .isr = nd_isr,
     .get = nd_get,
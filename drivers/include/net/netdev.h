@@ -98,6 +98,13 @@
  * This receive sequence can of course be simplified by skipping steps 2 and 3
  * when using fixed sized pre-allocated buffers or similar means. *
  *
+ * Drivers may additionally implement the optional
+ * @ref netdev_driver_t::recv_iol "recv_iol()" function. It replaces step 4 and
+ * allows the caller to pass a scatter list of buffers (e.g. one for the link
+ * layer header and one for the payload), so that the frame is split up while
+ * it is read from the device and no additional copy is needed to separate the
+ * headers later on.
+ *
  * @note    The @ref netdev_driver_t::send "send()" and
  *          @ref netdev_driver_t::recv "recv()" functions **must** never be
  *          called from interrupt context.
@@ -349,7 +356,7 @@ typedef struct netdev_driver {
      * @param[in]   dev     Network device descriptor. Must not be NULL.
      * @param[in]   iolist  IO vector list to send. Elements of this list may
      *                      have iolist_t::iol_data == NULL or
-     *                      iolist_t::iol_size == 0. However, unless otherwise
+     *                      iolist_t::iol_len == 0. However, unless otherwise
      *                      specified by the device, the *first* element
      *                      must contain data.
      *
@@ -395,6 +402,31 @@ typedef struct netdev_driver {
      */
     int (*recv)(netdev_t *dev, void *buf, size_t len, void *info);
 
+    /**
+     * @brief   Get a received frame into a scatter list
+     *
+     * @pre     `(dev != NULL) && (iolist != NULL)`
+     *
+     * This function is optional and may be `NULL` if the driver does not
+     * support it. It behaves like @ref netdev_driver_t::recv "recv()" with
+     * `buf != NULL`, but the received frame is written into the elements of
+     * @p iolist in order, each element being filled completely before the
+     * next one is used. Elements with iolist_t::iol_len == 0 are skipped.
+     *
+     * If the sum of the sizes of all elements in @p iolist is smaller than
+     * the received frame, the frame is dropped and `-ENOBUFS` is returned.
+     *
+     * @param[in]   dev     network device descriptor. Must not be NULL.
+     * @param[out]  iolist  IO vector list to write the frame into.
+     * @param[out]  info    status information for the received frame. Might
+     *                      be of different type for different netdev devices.
+     *                      May be NULL if not needed or applicable.
+     *
+     * @retval  -ENOBUFS    if supplied buffers are too small
+     * @return  number of bytes read
+     */
+    int (*recv_iol)(netdev_t *dev, const iolist_t *iolist, void *info);
+
     /**
      * @brief   the driver's initialization function
      *
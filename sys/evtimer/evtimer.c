@@ -22,6 +22,8 @@
  * @}
  */
 
+#include <stdbool.h>
+
 #include "div.h"
 #include "irq.h"
 
@@ -30,6 +32,247 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if IS_USED(MODULE_EVTIMER_HEAP)
+/* checks if event a triggers before event b */
+static inline bool _before(const evtimer_t *evtimer, const evtimer_event_t *a,
+                           const evtimer_event_t *b)
+{
+    return (a->offset - evtimer->base) < (b->offset - evtimer->base);
+}
+
+static inline bool _is_due(const evtimer_t *evtimer,
+                           const evtimer_event_t *event, uint32_t now)
+{
+    return (event->offset - evtimer->base) <= (now - evtimer->base);
+}
+
+/* melds two heaps, both a and b need to be roots without siblings */
+static evtimer_event_t *_meld(evtimer_t *evtimer, evtimer_event_t *a,
+                              evtimer_event_t *b)
+{
+    if (!a || !b) {
+        return a ? a : b;
+    }
+    if (_before(evtimer, b, a)) {
+        evtimer_event_t *tmp = a;
+
+        a = b;
+        b = tmp;
+    }
+    /* b becomes the first child of a */
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/* melds a list of siblings into one heap: pairwise from left to right first,
+ * then the pairs from right to left */
+static evtimer_event_t *_meld_siblings(evtimer_t *evtimer,
+                                       evtimer_event_t *first)
+{
+    evtimer_event_t *pairs = NULL;
+    evtimer_event_t *res = NULL;
+
+    while (first) {
+        evtimer_event_t *a = first;
+        evtimer_event_t *b = a->next;
+
+        first = b ? b->next : NULL;
+        a->next = a->prev = NULL;
+        if (b) {
+            b->next = b->prev = NULL;
+        }
+        a = _meld(evtimer, a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+    while (pairs) {
+        evtimer_event_t *pair = pairs;
+
+        pairs = pair->next;
+        pair->next = NULL;
+        res = _meld(evtimer, res, pair);
+    }
+    return res;
+}
+
+static void _del_event_from_heap(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    evtimer_event_t *children = _meld_siblings(evtimer, event->child);
+
+    if (evtimer->events == event) {
+        evtimer->events = children;
+    }
+    else {
+        if (event->prev->child == event) {
+            event->prev->child = event->next;
+        }
+        else {
+            event->prev->next = event->next;
+        }
+        if (event->next) {
+            event->next->prev = event->prev;
+        }
+        evtimer->events = _meld(evtimer, evtimer->events, children);
+    }
+    event->next = NULL;
+    event->child = NULL;
+    event->prev = NULL;
+}
+
+/* moves the base of all targets to now, but not beyond the first target */
+static uint32_t _update_base(evtimer_t *evtimer)
+{
+    uint32_t now = evtimer_now_msec();
+
+    if (evtimer->events && _is_due(evtimer, evtimer->events, now)) {
+        evtimer->base = evtimer->events->offset;
+    }
+    else {
+        evtimer->base = now;
+    }
+    return now;
+}
+
+static void _update_timer(evtimer_t *evtimer, uint32_t now)
+{
+    evtimer_event_t *next_event = evtimer->events;
+
+    if (next_event) {
+        uint32_t offset = _is_due(evtimer, next_event, now)
+                        ? 0 : next_event->offset - now;
+
+#if IS_USED(MODULE_EVTIMER_ON_ZTIMER)
+        DEBUG("evtimer: now=%" PRIu32 " ms setting ztimer to %" PRIu32 " ms\n",
+              now, offset);
+        ztimer_set(ZTIMER_MSEC, &evtimer->timer, offset);
+#else
+        DEBUG("evtimer: now=%" PRIu32 " ms setting xtimer to %" PRIu32 " ms\n",
+              now, offset);
+        xtimer_set64(&evtimer->timer, (uint64_t)offset * US_PER_MS);
+#endif
+    }
+    else {
+#if IS_USED(MODULE_EVTIMER_ON_ZTIMER)
+        ztimer_remove(ZTIMER_MSEC, &evtimer->timer);
+#else
+        xtimer_remove(&evtimer->timer);
+#endif
+    }
+}
+
+void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+    uint32_t now = _update_base(evtimer);
+    /* the target must stay within 32 bit of the base */
+    uint32_t max = UINT32_MAX - (now - evtimer->base);
+
+    DEBUG("evtimer_add(): adding event with offset %" PRIu32 "\n", event->offset);
+
+    event->offset = now + ((event->offset < max) ? event->offset : max);
+    event->next = NULL;
+    event->child = NULL;
+    event->prev = NULL;
+    evtimer->events = _meld(evtimer, evtimer->events, event);
+    if (evtimer->events == event) {
+        _update_timer(evtimer, now);
+    }
+    irq_restore(state);
+    if (sched_context_switch_request) {
+        thread_yield_higher();
+    }
+}
+
+void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    DEBUG("evtimer_del(): removing event with target %" PRIu32 "\n", event->offset);
+
+    if (evtimer->events == event) {
+        uint32_t now = _update_base(evtimer);
+
+        _del_event_from_heap(evtimer, event);
+        _update_timer(evtimer, now);
+    }
+    /* all other events in the heap link to their parent or sibling */
+    else if (event->prev) {
+        _del_event_from_heap(evtimer, event);
+    }
+    irq_restore(state);
+}
+
+static void _evtimer_handler(void *arg)
+{
+    DEBUG("_evtimer_handler()\n");
+
+    evtimer_t *evtimer = (evtimer_t *)arg;
+    evtimer_event_t *event;
+    uint32_t now = _update_base(evtimer);
+
+    /* the callbacks may add events, which moves the base */
+    while ((event = evtimer->events) && _is_due(evtimer, event, now)) {
+        _del_event_from_heap(evtimer, event);
+        evtimer->callback(event);
+        now = _update_base(evtimer);
+    }
+
+    _update_timer(evtimer, now);
+}
+
+evtimer_event_t *evtimer_iter(const evtimer_t *evtimer,
+                              const evtimer_event_t *last)
+{
+    if (!last) {
+        return evtimer->events;
+    }
+    if (last->child) {
+        return last->child;
+    }
+    while (last) {
+        if (last->next) {
+            return last->next;
+        }
+        /* go up to the parent, which the first sibling links to */
+        while (last->prev && (last->prev->child != last)) {
+            last = last->prev;
+        }
+        last = last->prev;
+    }
+    return NULL;
+}
+
+uint32_t evtimer_left(const evtimer_t *evtimer, const evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+    uint32_t now = evtimer_now_msec();
+    uint32_t res = 0;
+
+    /* the base is never past a pending target */
+    if (!_is_due(evtimer, event, now)) {
+        res = event->offset - now;
+    }
+    irq_restore(state);
+    return res;
+}
+
+void evtimer_print(const evtimer_t *evtimer)
+{
+    int nr = 0;
+
+    for (evtimer_event_t *event = evtimer_iter(evtimer, NULL); event;
+         event = evtimer_iter(evtimer, event)) {
+        nr++;
+        printf("ev #%d offset=%u\n", nr,
+               (unsigned)evtimer_left(evtimer, event));
+    }
+}
+#else   /* IS_USED(MODULE_EVTIMER_HEAP) */
 static void _add_event_to_list(evtimer_t *evtimer, evtimer_event_t *event)
 {
     DEBUG("evtimer: new event offset %" PRIu32 " ms\n", event->offset);
@@ -219,6 +462,8 @@ static void _evtimer_handler(void *arg)
     _update_timer(evtimer);
 }
 
+#endif  /* !IS_USED(MODULE_EVTIMER_HEAP) */
+
 void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
 {
     evtimer->callback = handler;
@@ -227,6 +472,7 @@ void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
     evtimer->events = NULL;
 }
 
+#if !IS_USED(MODULE_EVTIMER_HEAP)
 void evtimer_print(const evtimer_t *evtimer)
 {
     evtimer_event_t *list = evtimer->events;
@@ -238,3 +484,4 @@ void evtimer_print(const evtimer_t *evtimer)
         list = list->next;
     }
 }
+#endif  /* !IS_USED(MODULE_EVTIMER_HEAP) */
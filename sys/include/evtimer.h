@@ -33,6 +33,14 @@
  *   the pseudomodule "evtimer_on_ztimer" compiled in, evtimer is backend by
  *   @ref sys_ztimer "ZTIMER_MSEC".
  *
+ * By default, the events of an event timer are kept in a list sorted by their
+ * offsets, so adding an event takes time linear in the number of events.
+ * With the pseudomodule "evtimer_heap" compiled in, the events are kept in a
+ * pairing heap of absolute targets instead: adding an event takes constant
+ * time and removing one takes logarithmic time (amortized). Events with the
+ * same target may then trigger in any order, and an event passed to
+ * evtimer_del() must either have been added before or be zero-initialized.
+ *
  * @{
  *
  * @file
@@ -65,7 +73,14 @@ extern "C" {
  */
 typedef struct evtimer_event {
     struct evtimer_event *next; /**< the next event in the queue */
-    uint32_t offset;            /**< offset in milliseconds from previous event */
+    uint32_t offset;            /**< offset in milliseconds from previous event,
+                                     or absolute target with `evtimer_heap` */
+#if IS_USED(MODULE_EVTIMER_HEAP) || defined(DOXYGEN)
+    struct evtimer_event *child;    /**< first child in the heap */
+    struct evtimer_event *prev;     /**< parent for the first child, the
+                                         previous sibling otherwise, NULL
+                                         for the root and unset events */
+#endif
 } evtimer_event_t;
 
 /**
@@ -79,9 +94,11 @@ typedef void(*evtimer_callback_t)(evtimer_event_t* event);
 typedef struct {
 #if IS_USED(MODULE_EVTIMER_ON_ZTIMER)
     ztimer_t timer;                 /**< Timer */
-    uint32_t base;                  /**< Absolute time the first event is built on */
 #else
     xtimer_t timer;                 /**< Timer */
+#endif
+#if IS_USED(MODULE_EVTIMER_ON_ZTIMER) || IS_USED(MODULE_EVTIMER_HEAP)
+    uint32_t base;                  /**< Absolute time the first event is built on */
 #endif
     evtimer_callback_t callback;    /**< Handler function for this evtimer's
                                          event type */
@@ -116,6 +133,39 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event);
  */
 void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event);
 
+#if IS_USED(MODULE_EVTIMER_HEAP) || defined(DOXYGEN)
+/**
+ * @brief   Iterates over the events of an event timer
+ *
+ * The events are visited in no particular order. The event timer must not be
+ * changed while iterating, so disable interrupts if it is used from there.
+ *
+ * @note    Only available with the `evtimer_heap` module. Without, follow
+ *          evtimer_event_t::next starting from evtimer_t::events.
+ *
+ * @param[in] evtimer   An event timer
+ * @param[in] last      The event returned by the previous call, NULL to
+ *                      get the first event
+ *
+ * @return  The next event of @p evtimer
+ * @return  NULL, if all events were visited
+ */
+evtimer_event_t *evtimer_iter(const evtimer_t *evtimer,
+                              const evtimer_event_t *last);
+
+/**
+ * @brief   Gets the time left until an event triggers
+ *
+ * @note    Only available with the `evtimer_heap` module.
+ *
+ * @param[in] evtimer   An event timer
+ * @param[in] event     An event set on @p evtimer
+ *
+ * @return  Milliseconds left until @p event triggers, 0 if it is due
+ */
+uint32_t evtimer_left(const evtimer_t *evtimer, const evtimer_event_t *event);
+#endif
+
 /**
  * @brief   Print overview of current state of an event timer
  *
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_malloc_monitor Memory allocation monitor
+ * @ingroup     sys_memory_management
+ * @brief       Attributes dynamic memory usage to threads and subsystems
+ *
+ * This module keeps track of who uses dynamic memory. Every allocation is
+ * attributed to the thread that made it and to a tag the caller can choose,
+ * e.g. to tell subsystems within one thread apart. For each allocator, each
+ * thread and each tag, the module records the bytes currently allocated
+ * and their high-water mark. Per allocator, it also counts allocations,
+ * frees and failures and keeps a histogram of allocation sizes. Use it to
+ * size the heap and @ref CONFIG_GNRC_PKTBUF_SIZE for production images.
+ *
+ * The following allocators are monitored:
+ *
+ * - `malloc()`, `calloc()`, `realloc()` and `free()` with the
+ *   `malloc_monitor` module. The calls are wrapped at link time, so only
+ *   calls from code compiled into the application are seen. Allocations
+ *   made by the C library internally are not.
+ * - @ref sys_memarray with the `malloc_monitor_memarray` module.
+ * - The GNRC packet buffer (`gnrc_pktbuf_static` or `gnrc_pktbuf_slab`)
+ *   with the `malloc_monitor_pktbuf` module.
+ *
+ * Other allocators can report to the monitor using
+ * @ref malloc_monitor_record_alloc() and @ref malloc_monitor_record_free().
+ *
+ * To attribute a free to the allocating thread and tag, live allocations
+ * are kept in a table of @ref CONFIG_MALLOC_MONITOR_SLOTS entries. If the
+ * table is full, further allocations are counted in
+ * malloc_monitor_stats_t::untracked only and not attributed.
+ *
+ * With the `shell_commands` module, the `memstat` shell command prints all
+ * statistics.
+ *
+ * @warning This module is meant for development. Every monitored
+ *          allocation and free searches the table with interrupts disabled.
+ * @{
+ *
+ * @file
+ * @brief       Memory allocation monitor definitions
+ */
+
+#ifndef MALLOC_MONITOR_H
+#define MALLOC_MONITOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup    sys_malloc_monitor_conf Memory allocation monitor compile
+ *              configurations
+ * @ingroup     config
+ * @{
+ */
+/**
+ * @brief   Number of live allocations that can be attributed
+ */
+#ifndef CONFIG_MALLOC_MONITOR_SLOTS
+#define CONFIG_MALLOC_MONITOR_SLOTS         (64U)
+#endif
+
+/**
+ * @brief   Number of tags
+ *
+ * Tag 0 (@ref MALLOC_MONITOR_TAG_NONE) is the default of every thread.
+ */
+#ifndef CONFIG_MALLOC_MONITOR_TAGS
+#define CONFIG_MALLOC_MONITOR_TAGS          (8U)
+#endif
+
+/**
+ * @brief   Number of buckets of the allocation size histograms
+ *
+ * Bucket 0 counts allocations of up to 16 bytes, bucket `n` those of up to
+ * `16 << n` bytes. The last bucket counts all larger allocations.
+ */
+#ifndef CONFIG_MALLOC_MONITOR_HIST_BUCKETS
+#define CONFIG_MALLOC_MONITOR_HIST_BUCKETS  (8U)
+#endif
+/** @} */
+
+/**
+ * @brief   Tag of allocations made without a tag set
+ */
+#define MALLOC_MONITOR_TAG_NONE             (0U)
+
+/**
+ * @brief   Monitored allocators
+ */
+typedef enum {
+    MALLOC_MONITOR_SRC_HEAP = 0,    /**< malloc() and friends */
+    MALLOC_MONITOR_SRC_MEMARRAY,    /**< @ref sys_memarray */
+    MALLOC_MONITOR_SRC_PKTBUF,      /**< GNRC packet buffer */
+    MALLOC_MONITOR_SRC_NUMOF,       /**< number of allocators */
+} malloc_monitor_src_t;
+
+/**
+ * @brief   Memory usage
+ */
+typedef struct {
+    size_t current;                 /**< bytes currently allocated */
+    size_t peak;                    /**< maximum of malloc_monitor_usage_t::current */
+} malloc_monitor_usage_t;
+
+/**
+ * @brief   Statistics of an allocator
+ */
+typedef struct {
+    malloc_monitor_usage_t usage;   /**< attributed memory usage */
+    uint32_t allocs;                /**< successful allocations */
+    uint32_t frees;                 /**< frees of attributed allocations */
+    uint32_t failed;                /**< failed allocations */
+    uint32_t untracked;             /**< allocations not attributed as the
+                                     *   table was full */
+    /**
+     * @brief   Histogram of successful allocation sizes
+     */
+    uint32_t hist[CONFIG_MALLOC_MONITOR_HIST_BUCKETS];
+} malloc_monitor_stats_t;
+
+/**
+ * @brief   Sets the tag of the allocations of the calling thread
+ *
+ * Allocations in interrupt context are never tagged.
+ *
+ * @pre `tag < CONFIG_MALLOC_MONITOR_TAGS`
+ *
+ * @param[in] tag   The new tag
+ *
+ * @return  The previous tag, to restore it when done
+ */
+uint8_t malloc_monitor_tag_set(uint8_t tag);
+
+/**
+ * @brief   Names a tag for @ref malloc_monitor_print()
+ *
+ * @pre `tag < CONFIG_MALLOC_MONITOR_TAGS`
+ *
+ * @param[in] tag   The tag
+ * @param[in] name  Name of the tag, must stay valid
+ */
+void malloc_monitor_tag_name(uint8_t tag, const char *name);
+
+/**
+ * @brief   Records an allocation
+ *
+ * Attributes the allocation to the calling thread and its tag. Allocations
+ * in interrupt context are attributed to @ref KERNEL_PID_UNDEF.
+ *
+ * @param[in] src   The allocator
+ * @param[in] ptr   The allocated memory, NULL if the allocation failed
+ * @param[in] size  Size of the allocation in bytes
+ */
+void malloc_monitor_record_alloc(malloc_monitor_src_t src, const void *ptr,
+                                 size_t size);
+
+/**
+ * @brief   Records a free
+ *
+ * Frees of memory that was not recorded are ignored.
+ *
+ * @param[in] src   The allocator
+ * @param[in] ptr   The released memory
+ * @param[in] size  Number of bytes released at @p ptr, 0 for the whole
+ *                  allocation. Allows allocators to release an allocation
+ *                  in parts, in any order. The allocation is considered
+ *                  freed once all of its bytes were released.
+ */
+void malloc_monitor_record_free(malloc_monitor_src_t src, const void *ptr,
+                                size_t size);
+
+/**
+ * @brief   Gets the statistics of an allocator
+ *
+ * @param[in] src   The allocator
+ * @param[out] stats The statistics
+ */
+void malloc_monitor_get_stats(malloc_monitor_src_t src,
+                              malloc_monitor_stats_t *stats);
+
+/**
+ * @brief   Gets the memory usage of a thread
+ *
+ * @param[in] src   The allocator
+ * @param[in] pid   The thread, @ref KERNEL_PID_UNDEF for interrupt context
+ * @param[out] usage The memory usage
+ */
+void malloc_monitor_get_thread_usage(malloc_monitor_src_t src,
+                                     kernel_pid_t pid,
+                                     malloc_monitor_usage_t *usage);
+
+/**
+ * @brief   Gets the memory usage of a tag
+ *
+ * @pre `tag < CONFIG_MALLOC_MONITOR_TAGS`
+ *
+ * @param[in] src   The allocator
+ * @param[in] tag   The tag
+ * @param[out] usage The memory usage
+ */
+void malloc_monitor_get_tag_usage(malloc_monitor_src_t src, uint8_t tag,
+                                  malloc_monitor_usage_t *usage);
+
+/**
+ * @brief   Resets all high-water marks to the current usage
+ */
+void malloc_monitor_reset_peaks(void);
+
+/**
+ * @brief   Prints all statistics to stdout
+ */
+void malloc_monitor_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MALLOC_MONITOR_H */
+/** @} */
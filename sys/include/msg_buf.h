@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_msg_buf Zero-copy message buffers
+ * @ingroup     sys
+ * @brief       Hand over buffers between threads via IPC without copying
+ *
+ * A @ref msg_t only carries a single word of content. Larger payloads are
+ * usually either copied through a @ref tsrb.h "ring buffer" or @ref pipe.h
+ * "pipe", or shared ad hoc between the threads. This module provides pools
+ * of fixed-size buffers, backed by @ref sys_memarray, whose ownership is
+ * passed along with a message: the sender allocates a buffer, fills it and
+ * sends it. The receiver becomes the owner of the buffer and returns it to
+ * its pool with @ref msg_buf_free() when done.
+ *
+ * As the buffer travels in a normal @ref msg_t, it can be received with
+ * @ref msg_receive() or passed through an @ref core_mbox "mbox":
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * MSG_BUF_POOL(pool_data, 64, 4);
+ * static msg_buf_pool_t pool;
+ *
+ * // sender, after msg_buf_pool_init(&pool, pool_data, 64, 4)
+ * msg_buf_t *buf = msg_buf_alloc(&pool);
+ * buf->len = read_sensor(buf->data, buf->size);
+ * msg_buf_send(&msg, MSG_TYPE_SENSOR_DATA, buf, receiver_pid);
+ *
+ * // receiver
+ * msg_receive(&msg);
+ * msg_buf_t *buf = msg_buf_get(&msg);
+ * process(buf->data, buf->len);
+ * msg_buf_free(buf);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Once a buffer was handed over successfully, the sender must not access it
+ * anymore. If a send or put operation fails, the sender stays the owner.
+ * Buffers can be allocated, sent (non-blocking) and freed from interrupt
+ * context.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Zero-copy message buffer definitions
+ */
+
+#ifndef MSG_BUF_H
+#define MSG_BUF_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "memarray.h"
+#include "msg.h"
+#ifdef MODULE_CORE_MBOX
+#include "mbox.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A pool of message buffers
+ */
+typedef struct {
+    memarray_t mem;             /**< memory of the pool */
+    uint16_t size;              /**< payload capacity of each buffer */
+} msg_buf_pool_t;
+
+/**
+ * @brief   A message buffer
+ */
+typedef struct {
+    msg_buf_pool_t *pool;       /**< pool the buffer belongs to */
+    uint16_t size;              /**< payload capacity of the buffer */
+    uint16_t len;               /**< number of used bytes in msg_buf_t::data */
+    uint8_t data[];             /**< payload */
+} msg_buf_t;
+
+/**
+ * @brief   Size of a single buffer in memory, including its header
+ *
+ * Rounded up to the size of a pointer so that all buffers in a pool are
+ * aligned.
+ *
+ * @param[in] size  payload capacity of a buffer
+ */
+#define MSG_BUF_ELEM_SIZE(size) \
+    (((sizeof(msg_buf_t) + (size) + sizeof(void *) - 1) / sizeof(void *)) * \
+     sizeof(void *))
+
+/**
+ * @brief   Defines static memory for a pool of message buffers
+ *
+ * @param[in] name  name of the memory array
+ * @param[in] size  payload capacity of each buffer
+ * @param[in] num   number of buffers
+ */
+#define MSG_BUF_POOL(name, size, num) \
+    static void *name[((num) * MSG_BUF_ELEM_SIZE(size)) / sizeof(void *)]
+
+/**
+ * @brief   Initializes a pool of message buffers
+ *
+ * @pre `(pool != NULL) && (data != NULL) && (num > 0)`
+ * @pre @p data is aligned to a pointer and at least
+ *      `num * MSG_BUF_ELEM_SIZE(size)` bytes long, e.g. defined using
+ *      @ref MSG_BUF_POOL()
+ *
+ * @param[out] pool The pool to initialize
+ * @param[in] data  Memory for the buffers
+ * @param[in] size  Payload capacity of each buffer
+ * @param[in] num   Number of buffers in @p data
+ */
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *data, uint16_t size,
+                       size_t num);
+
+/**
+ * @brief   Allocates a buffer from a pool
+ *
+ * The calling thread becomes the owner of the buffer.
+ *
+ * @param[in] pool  The pool to allocate from
+ *
+ * @return  A buffer with msg_buf_t::len set to 0
+ * @return  NULL, if all buffers of @p pool are in use
+ */
+msg_buf_t *msg_buf_alloc(msg_buf_pool_t *pool);
+
+/**
+ * @brief   Returns a buffer to its pool
+ *
+ * @pre The calling thread is the owner of @p buf
+ *
+ * @param[in] buf   The buffer to release
+ */
+void msg_buf_free(msg_buf_t *buf);
+
+/**
+ * @brief   Puts a buffer into a message
+ *
+ * @param[out] m    The message
+ * @param[in] type  Type of the message
+ * @param[in] buf   The buffer
+ */
+static inline void msg_buf_wrap(msg_t *m, uint16_t type, msg_buf_t *buf)
+{
+    m->type = type;
+    m->content.ptr = buf;
+}
+
+/**
+ * @brief   Gets the buffer carried by a message
+ *
+ * @pre @p m was filled using @ref msg_buf_wrap(). The type of the message
+ *      can be used to tell messages with buffers from other messages.
+ *
+ * @param[in] m The message
+ *
+ * @return  The buffer, the caller is its owner now
+ */
+static inline msg_buf_t *msg_buf_get(const msg_t *m)
+{
+    return m->content.ptr;
+}
+
+/**
+ * @brief   Sends a buffer to a thread, blocking until it was delivered
+ *
+ * @see msg_send()
+ *
+ * @param[out] m        Message to use for sending
+ * @param[in] type      Type of the message
+ * @param[in] buf       The buffer, ownership is passed to @p target_pid
+ *                      on success
+ * @param[in] target_pid PID of the receiving thread
+ *
+ * @return  1, if the buffer was delivered
+ * @return  -1, on invalid @p target_pid. The caller stays the owner of
+ *          @p buf.
+ */
+static inline int msg_buf_send(msg_t *m, uint16_t type, msg_buf_t *buf,
+                               kernel_pid_t target_pid)
+{
+    msg_buf_wrap(m, type, buf);
+    return msg_send(m, target_pid);
+}
+
+/**
+ * @brief   Sends a buffer to a thread without blocking
+ *
+ * @see msg_try_send()
+ *
+ * @param[out] m        Message to use for sending
+ * @param[in] type      Type of the message
+ * @param[in] buf       The buffer, ownership is passed to @p target_pid
+ *                      on success
+ * @param[in] target_pid PID of the receiving thread
+ *
+ * @return  1, if the buffer was delivered
+ * @return  0, if the receiver was not waiting and its queue is full. The
+ *          caller stays the owner of @p buf.
+ * @return  -1, on invalid @p target_pid. The caller stays the owner of
+ *          @p buf.
+ */
+static inline int msg_buf_try_send(msg_t *m, uint16_t type, msg_buf_t *buf,
+                                   kernel_pid_t target_pid)
+{
+    msg_buf_wrap(m, type, buf);
+    return msg_try_send(m, target_pid);
+}
+
+#if defined(MODULE_CORE_MBOX) || defined(DOXYGEN)
+/**
+ * @brief   Puts a buffer into a mailbox, blocking until there is space
+ *
+ * @see mbox_put()
+ *
+ * @param[in] mbox  The mailbox
+ * @param[in] type  Type of the message
+ * @param[in] buf   The buffer, ownership is passed to whoever gets it from
+ *                  @p mbox
+ */
+static inline void msg_buf_mbox_put(mbox_t *mbox, uint16_t type,
+                                    msg_buf_t *buf)
+{
+    msg_t m;
+
+    msg_buf_wrap(&m, type, buf);
+    mbox_put(mbox, &m);
+}
+
+/**
+ * @brief   Puts a buffer into a mailbox without blocking
+ *
+ * @see mbox_try_put()
+ *
+ * @param[in] mbox  The mailbox
+ * @param[in] type  Type of the message
+ * @param[in] buf   The buffer, ownership is passed to whoever gets it from
+ *                  @p mbox on success
+ *
+ * @return  1, if the buffer was put into @p mbox
+ * @return  0, if @p mbox is full. The caller stays the owner of @p buf.
+ */
+static inline int msg_buf_mbox_try_put(mbox_t *mbox, uint16_t type,
+                                       msg_buf_t *buf)
+{
+    msg_t m;
+
+    msg_buf_wrap(&m, type, buf);
+    return mbox_try_put(mbox, &m);
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MSG_BUF_H */
+/** @} */
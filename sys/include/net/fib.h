@@ -11,6 +11,13 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * With the `fib_index` module, single hop tables keep hash indices over the
+ * addresses and prefixes of their entries, so a lookup only compares the
+ * entries sharing the leading bytes of the destination instead of all of
+ * them. Expired entries are then removed in one sweep once the earliest
+ * lifetime in the table has passed instead of being checked on every lookup.
+ * The lookup results are the same either way.
+ *
  * @{
  *
  * @file
@@ -35,10 +35,21 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+/**
+ * @brief number of hash buckets of each index of a FIB table
+ *
+ * Only used with the `fib_index` module. Each FIB table holds two arrays of
+ * this many bucket heads, one for the exact addresses and one for the
+ * prefixes of its entries.
+ */
+#ifndef CONFIG_FIB_INDEX_BUCKETS
+#define CONFIG_FIB_INDEX_BUCKETS (16)
+#endif
+
 /**
  * @brief Container descriptor for a FIB entry
  */
-typedef struct {
+typedef struct fib_entry {
     /** interface ID */
     kernel_pid_t iface_id;
     /** Lifetime of this entry (an absolute time-point is stored by the FIB) */
@@ -51,6 +62,13 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+#if defined(MODULE_FIB_INDEX) || defined(DOXYGEN)
+    /** Next entry in the same bucket of fib_table_t::addr_index */
+    struct fib_entry *addr_next;
+    /** Next entry in the same bucket of fib_table_t::pfx_index or
+     *  fib_table_t::default_routes */
+    struct fib_entry *pfx_next;
+#endif
 } fib_entry_t;
 
 /**
@@ -133,6 +151,19 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+#if defined(MODULE_FIB_INDEX) || defined(DOXYGEN)
+    /** entries hashed by their full address. Only used for single hop tables */
+    fib_entry_t *addr_index[CONFIG_FIB_INDEX_BUCKETS];
+    /** prefix entries hashed by the leading address bytes a destination
+     *  needs to share with them to match */
+    fib_entry_t *pfx_index[CONFIG_FIB_INDEX_BUCKETS];
+    /** entries with an all-zero address, i.e. default routes */
+    fib_entry_t *default_routes;
+    /** bitmap of the leading byte counts in use by fib_table_t::pfx_index */
+    uint32_t pfx_index_keys;
+    /** earliest absolute lifetime of all entries in the table */
+    uint64_t next_expiry;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
@@ -255,6 +255,9 @@
  * - Use coap_opt_finish() to determine the length of the PDU. If appropriate,
  *   use the COAP_OPT_FINISH_PAYLOAD parameter and then write the payload.
  *
+ * The `gcoap_block` module implements this sequence in
+ * gcoap_block1_sink_handler(), which passes the blocks to a callback.
+ *
  * ### CoAP client GET request ###
  *
  * The client requests a specific blockwise payload from the overall body by
@@ -279,6 +282,10 @@
  *   request.
  * - Use coap_opt_finish() to determine the length of the PDU.
  *
+ * The sequence above waits for each block before requesting the next one.
+ * The `gcoap_block` module provides gcoap_block2_fetch(), which keeps several
+ * block requests in flight; see @ref net_gcoap_block.
+ *
  * ### CoAP client PUT/POST request ###
  *
  * The client pushes a specific blockwise payload from the overall body to the
@@ -509,6 +516,25 @@ extern "C" {
 #define CONFIG_GCOAP_OBS_REGISTRATIONS_MAX     (2)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of hash buckets for the lookup of open requests, Observe
+ *          clients and Observe registrations
+ *
+ * With the `gcoap_hash` module, open requests are chained per bucket by token
+ * and remote endpoint, Observe clients by endpoint and Observe registrations
+ * by client and token as well as by resource. Lookups then only compare the
+ * entries of a single bucket instead of the whole table, which pays off once
+ * @ref CONFIG_GCOAP_REQ_WAITING_MAX or the Observe limits are raised well
+ * above their defaults. Every bucket costs four pointers of RAM. Lookups stay
+ * flat as long as the tables hold no more than a few entries per bucket.
+ *
+ * @note    Only applicable with the `gcoap_hash` module
+ */
+#ifndef CONFIG_GCOAP_HASH_BUCKETS
+#define CONFIG_GCOAP_HASH_BUCKETS      (16U)
+#endif
+
 /**
  * @name    States for the memo used to track Observe registrations
  * @{
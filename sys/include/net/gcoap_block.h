@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gcoap_block Gcoap block-wise transfers
+ * @ingroup     net_gcoap
+ * @brief       Pipelined Block2 downloads and a Block1 upload sink for gcoap
+ *
+ * ## Block2 client ##
+ *
+ * gcoap_block2_fetch() downloads a resource block by block and passes the
+ * blocks in order to a callback. In contrast to a stop-and-wait client, up to
+ * @ref CONFIG_GCOAP_BLOCK_WINDOW block requests are kept in flight at a time,
+ * so a transfer takes roughly one round trip per window instead of one per
+ * block. The first block is requested alone to learn the block size the
+ * server settles on and whether there are more blocks at all. Blocks that
+ * arrive ahead of the one the callback expects next are held in the transfer
+ * context until the gap is filled. The callback runs in the calling thread.
+ *
+ * Each block request holds a request memo and a resend buffer while it is in
+ * flight. Hence @ref CONFIG_GCOAP_REQ_WAITING_MAX and
+ * @ref CONFIG_GCOAP_RESEND_BUFS_MAX must be at least
+ * @ref CONFIG_GCOAP_BLOCK_WINDOW for the full window to be used. With fewer,
+ * the transfer still succeeds, just with a smaller window.
+ *
+ * ## Block1 sink ##
+ *
+ * gcoap_block1_sink_handler() is a resource handler that reassembles a Block1
+ * upload by passing each block at its offset to a callback. Use it as the
+ * handler of a resource with a @ref gcoap_block1_sink_t as context:
+ *
+ * @code
+ * static gcoap_block1_sink_t _sink = { .cb = _write, .arg = &storage };
+ *
+ * static const coap_resource_t _resources[] = {
+ *     { "/upload", COAP_PUT, gcoap_block1_sink_handler, &_sink },
+ * };
+ * @endcode
+ *
+ * The sink handles a single upload at a time.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Block-wise transfer definitions for gcoap
+ */
+
+#ifndef NET_GCOAP_BLOCK_H
+#define NET_GCOAP_BLOCK_H
+
+#include <stdint.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of block requests gcoap_block2_fetch() keeps in flight
+ */
+#ifndef CONFIG_GCOAP_BLOCK_WINDOW
+#define CONFIG_GCOAP_BLOCK_WINDOW       (4U)
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Largest block size gcoap_block2_fetch() requests, in bytes
+ *
+ * Must be a power of two from 16 to 1024. Each transfer context holds
+ * @ref CONFIG_GCOAP_BLOCK_WINDOW blocks of this size to reorder responses.
+ * Requests for larger blocks are reduced to this size.
+ */
+#ifndef CONFIG_GCOAP_BLOCK_SIZE_MAX
+#define CONFIG_GCOAP_BLOCK_SIZE_MAX     (64U)
+#endif
+
+/**
+ * @brief   Block callback
+ *
+ * @param[in] arg       user argument
+ * @param[in] offset    offset of @p buf in the transfer
+ * @param[in] buf       block data
+ * @param[in] len       length of @p buf
+ * @param[in] more      1 if more blocks follow, 0 for the last block
+ *
+ * @return  0 to continue the transfer
+ * @return  any other value to abort it
+ */
+typedef int (*gcoap_block_cb_t)(void *arg, size_t offset, uint8_t *buf,
+                                size_t len, int more);
+
+/**
+ * @brief   Block held back until the blocks before it were delivered
+ */
+typedef struct {
+    uint32_t num;                       /**< Block number */
+    uint16_t len;                       /**< Length of the block data */
+    int8_t state;                       /**< 0 if unused, 1 if holding data,
+                                             -1 if the block request failed */
+    uint8_t more;                       /**< More flag of the block */
+} gcoap_block_slot_t;
+
+/**
+ * @brief   Context of a Block2 download
+ *
+ * The context must stay valid until gcoap_block2_fetch() returns. Its
+ * contents are private to the transfer.
+ */
+typedef struct {
+    mutex_t lock;                       /**< Wakes up the fetching thread */
+    mutex_t guard;                      /**< Protects the context against the
+                                             response handler */
+    sock_udp_ep_t remote;               /**< Server endpoint */
+    const char *path;                   /**< Path of the resource */
+    gcoap_block_cb_t cb;                /**< Block callback */
+    void *arg;                          /**< Argument of the block callback */
+    size_t offset;                      /**< Bytes passed to the callback */
+    uint32_t next;                      /**< Next block number to request */
+    uint32_t expected;                  /**< Next block number to deliver */
+    uint32_t last;                      /**< Number of the last block,
+                                             UINT32_MAX while unknown */
+    unsigned szx;                       /**< Negotiated block size exponent */
+    unsigned inflight;                  /**< Block requests in flight */
+    int res;                            /**< 0 while running, 1 when done,
+                                             negative errno on failure */
+    gcoap_block_slot_t slots[CONFIG_GCOAP_BLOCK_WINDOW]; /**< Reorder slots */
+    uint8_t bufs[CONFIG_GCOAP_BLOCK_WINDOW][CONFIG_GCOAP_BLOCK_SIZE_MAX];
+                                        /**< Data of the reorder slots */
+} gcoap_block2_t;
+
+/**
+ * @brief   Context of a Block1 upload sink
+ */
+typedef struct {
+    gcoap_block_cb_t cb;                /**< Block callback */
+    void *arg;                          /**< Argument of the block callback */
+    size_t offset;                      /**< Offset of the next expected block */
+} gcoap_block1_sink_t;
+
+/**
+ * @brief   Downloads a resource block-wise with pipelined requests
+ *
+ * Blocks the calling thread until the transfer completed or failed. Must not
+ * be called from gcoap's thread, i.e. from a resource or response handler.
+ *
+ * A server may answer the request for the first block with the whole
+ * resource instead of a block. This response is passed to @p cb as the only
+ * block, so a resource sent this way must not be larger than
+ * @ref CONFIG_GCOAP_BLOCK_SIZE_MAX, or the transfer fails with -ENOBUFS.
+ *
+ * @param[out] ctx      transfer context
+ * @param[in]  remote   server endpoint
+ * @param[in]  path     path of the resource, must start with '/'
+ * @param[in]  szx      block size exponent to ask for, reduced to
+ *                      @ref CONFIG_GCOAP_BLOCK_SIZE_MAX if larger
+ * @param[in]  cb       called with each block in order
+ * @param[in]  arg      argument to @p cb
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if no request could be sent, as all request memos or
+ *          resend buffers of gcoap stayed taken
+ * @return  -ETIMEDOUT if a block request timed out
+ * @return  -EPROTO on an error response or an invalid block
+ * @return  -ENOBUFS if a block request does not fit into
+ *          @ref CONFIG_GCOAP_PDU_BUF_SIZE, e.g. due to a long @p path, or a
+ *          response does not fit into a reorder slot
+ * @return  -ECANCELED if @p cb aborted the transfer
+ */
+int gcoap_block2_fetch(gcoap_block2_t *ctx, const sock_udp_ep_t *remote,
+                       const char *path, unsigned szx, gcoap_block_cb_t cb,
+                       void *arg);
+
+/**
+ * @brief   Resource handler for Block1 uploads
+ *
+ * Passes each block to the callback of the @ref gcoap_block1_sink_t given as
+ * resource context and acknowledges it with 2.31 Continue, or 2.04 Changed
+ * for the last block. Block 0 starts a new upload. A retransmitted later
+ * block is acknowledged again without being passed on, a block after a gap is
+ * refused with 4.08 Request Entity Incomplete and a callback failure yields
+ * 5.00. A request without Block1 option is passed on as a single last block.
+ *
+ * @param[in] pdu       request
+ * @param[in] buf       buffer for the response
+ * @param[in] len       size of @p buf
+ * @param[in] ctx       @ref gcoap_block1_sink_t of the resource
+ *
+ * @return  length of the response
+ */
+ssize_t gcoap_block1_sink_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                  void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GCOAP_BLOCK_H */
+/** @} */
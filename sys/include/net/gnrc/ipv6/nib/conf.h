@@ -184,6 +184,32 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * @brief   (de-)activate the longest-prefix match trie for off-link entries
+ *
+ * Indexes the forwarding table and prefix list in a path-compressed binary
+ * trie, so a route lookup costs O(prefix length) instead of a scan over all
+ * @ref CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF entries. The trie needs
+ * `2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF` nodes of additional RAM, so it is
+ * only worth it for large forwarding tables.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_OFFL_TRIE
+#define CONFIG_GNRC_IPV6_NIB_OFFL_TRIE                0
+#endif
+
+/**
+ * @brief   (de-)activate the hash index for on-link entries
+ *
+ * Indexes the neighbor cache and all other on-link entries by their IPv6
+ * address, so next-hop resolution does not need to compare the address of
+ * all @ref CONFIG_GNRC_IPV6_NIB_NUMOF entries. The index needs
+ * @ref CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS bucket heads and two indexes per
+ * on-link entry of additional RAM.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_ONL_HASH
+#define CONFIG_GNRC_IPV6_NIB_ONL_HASH                 0
+#endif
+
 /**
  * @brief   Support for DNS configuration options
  *
@@ -261,6 +287,15 @@ extern "C" {
 #define CONFIG_GNRC_IPV6_NIB_NUMOF                   (4)
 #endif
 
+/**
+ * @brief   Number of hash buckets for the on-link entries
+ *
+ * @note    Only applicable with @ref CONFIG_GNRC_IPV6_NIB_ONL_HASH
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS
+#define CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS        (CONFIG_GNRC_IPV6_NIB_NUMOF)
+#endif
+
 /**
  * @brief   Number of off-link entries in NIB
  *
@@ -54,6 +54,44 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_batch   Batched packet dispatch
+ * @ingroup     net_gnrc_netapi
+ * @brief       Passes multiple packets with a single message
+ * @{
+ *
+ * @details The submodule `gnrc_netapi_batch` allows to pass a whole batch of
+ *          packets between GNRC modules with a single
+ *          @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or
+ *          @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH message. This saves a
+ *          context switch and a message queue operation for every but the
+ *          first packet when a lot of packets arrive in a short time.
+ *
+ * A batch is a single snip in the packet buffer, holding an array of pointers
+ * to the packets of the batch. Its receiver is expected to handle every
+ * packet in the batch (see gnrc_netapi_batch_numof() and
+ * gnrc_netapi_batch_get()) and release the batch snip afterwards with
+ * gnrc_pktbuf_release().
+ *
+ * Only subscribers registered with a @ref GNRC_NETREG_TYPE_BATCH entry are
+ * sent batches by gnrc_netapi_dispatch(). For all other subscribers the batch
+ * is unrolled and the packets are delivered one by one, so they do not need
+ * to be aware of batching at all.
+ *
+ * Batches are typically built with a @ref gnrc_netapi_batch_t collector: a
+ * thread puts the packets it would dispatch one by one into the collector
+ * and flushes it when it runs out of work. With the module, `gnrc_netif`
+ * collects received packets while further device events are pending and
+ * `gnrc_sixlowpan` and `gnrc_ipv6` pass on the packets of a received batch
+ * as a batch. `gnrc_sixlowpan`, `gnrc_ipv6` and `gnrc_udp` accept batches.
+ *
+ * To use, add the module `gnrc_netapi_batch` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_batch
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  */
 
 #ifndef NET_GNRC_NETAPI_H
@@ -93,6 +131,45 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   @ref core_msg type for passing a batch of @ref net_gnrc_pkt up the
+ *          network stack
+ *
+ * @see     @ref net_gnrc_netapi_batch
+ */
+#define GNRC_NETAPI_MSG_TYPE_RCV_BATCH  (0x0207)
+
+/**
+ * @brief   @ref core_msg type for passing a batch of @ref net_gnrc_pkt down
+ *          the network stack
+ *
+ * @see     @ref net_gnrc_netapi_batch
+ */
+#define GNRC_NETAPI_MSG_TYPE_SND_BATCH  (0x0208)
+
+/**
+ * @brief   Maximum number of packets in a batch
+ *
+ * @see     @ref net_gnrc_netapi_batch
+ */
+#ifndef CONFIG_GNRC_NETAPI_BATCH_SIZE
+#define CONFIG_GNRC_NETAPI_BATCH_SIZE   (8U)
+#endif
+
+/**
+ * @brief   Collector for a batch of packets dispatched to the same
+ *          subscribers
+ *
+ * @see     @ref net_gnrc_netapi_batch
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkts[CONFIG_GNRC_NETAPI_BATCH_SIZE]; /**< collected packets */
+    uint32_t demux_ctx;     /**< demultiplexing context of the packets */
+    gnrc_nettype_t type;    /**< protocol type of the packets */
+    uint16_t cmd;           /**< command for the packets */
+    uint8_t numof;          /**< number of collected packets */
+} gnrc_netapi_batch_t;
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -159,6 +236,10 @@ static inline int gnrc_netapi_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt)
 /**
  * @brief   Sends @p cmd to all subscribers to (@p type, @p demux_ctx).
  *
+ * With @ref net_gnrc_netapi_batch, @p cmd may also be
+ * @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH
+ * with @p pkt being a batch of packets.
+ *
  * @param[in] type      protocol type of the targeted network module.
  * @param[in] demux_ctx demultiplexing context for @p type.
  * @param[in] cmd       command for all subscribers
@@ -215,6 +296,111 @@ static inline int gnrc_netapi_dispatch_receive(gnrc_nettype_t type, uint32_t dem
     return gnrc_netapi_dispatch(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_RCV, pkt);
 }
 
+/**
+ * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH
+ *          messages
+ *
+ * @pre     The thread @p pid handles @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH
+ *
+ * @param[in] pid       PID of the targeted network module
+ * @param[in] batch     a batch of packets to send
+ *
+ * @return              1 if the batch was successfully delivered
+ * @return              -1 on error (invalid PID or no space in queue)
+ */
+static inline int gnrc_netapi_send_batch(kernel_pid_t pid,
+                                         gnrc_pktsnip_t *batch)
+{
+    return _gnrc_netapi_send_recv(pid, batch, GNRC_NETAPI_MSG_TYPE_SND_BATCH);
+}
+
+/**
+ * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH
+ *          messages
+ *
+ * @pre     The thread @p pid handles @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH
+ *
+ * @param[in] pid       PID of the targeted network module
+ * @param[in] batch     a batch of received packets
+ *
+ * @return              1 if the batch was successfully delivered
+ * @return              -1 on error (invalid PID or no space in queue)
+ */
+static inline int gnrc_netapi_receive_batch(kernel_pid_t pid,
+                                            gnrc_pktsnip_t *batch)
+{
+    return _gnrc_netapi_send_recv(pid, batch, GNRC_NETAPI_MSG_TYPE_RCV_BATCH);
+}
+
+/**
+ * @brief   Gets the number of packets in a batch
+ *
+ * @param[in] batch     a batch of packets
+ *
+ * @return  number of packets in @p batch
+ */
+static inline unsigned gnrc_netapi_batch_numof(const gnrc_pktsnip_t *batch)
+{
+    return batch->size / sizeof(gnrc_pktsnip_t *);
+}
+
+/**
+ * @brief   Gets a packet from a batch
+ *
+ * @pre     `idx < gnrc_netapi_batch_numof(batch)`
+ *
+ * @param[in] batch     a batch of packets
+ * @param[in] idx       index of the packet within @p batch
+ *
+ * @return  the packet at position @p idx of @p batch
+ */
+static inline gnrc_pktsnip_t *gnrc_netapi_batch_get(const gnrc_pktsnip_t *batch,
+                                                    unsigned idx)
+{
+    return ((gnrc_pktsnip_t **)batch->data)[idx];
+}
+
+/**
+ * @brief   Releases a batch and all packets within it
+ *
+ * @param[in] batch     a batch of packets
+ * @param[in] err       error code to report to subscribers of
+ *                      @ref net_gnrc_neterr
+ */
+void gnrc_netapi_batch_release_error(gnrc_pktsnip_t *batch, uint32_t err);
+
+/**
+ * @brief   Puts a packet into a batch collector instead of dispatching it
+ *          directly with gnrc_netapi_dispatch()
+ *
+ * If @p batch already holds packets for a different (@p type, @p demux_ctx,
+ * @p cmd) or is full, it is flushed before @p pkt is put into it, so packets
+ * are always delivered in order.
+ *
+ * @param[in,out] batch     a batch collector
+ * @param[in] type          protocol type of the targeted network module.
+ * @param[in] demux_ctx     demultiplexing context for @p type.
+ * @param[in] cmd           @ref GNRC_NETAPI_MSG_TYPE_RCV or
+ *                          @ref GNRC_NETAPI_MSG_TYPE_SND
+ * @param[in] pkt           the packet
+ *
+ * @return  Number of subscribers to (@p type, @p demux_ctx). If 0, @p pkt was
+ *          not taken by @p batch.
+ */
+int gnrc_netapi_batch_put(gnrc_netapi_batch_t *batch, gnrc_nettype_t type,
+                          uint32_t demux_ctx, uint16_t cmd,
+                          gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Dispatches all packets collected in a batch collector
+ *
+ * A single packet is dispatched as is. If no batch can be allocated in the
+ * packet buffer, the packets are dispatched one by one.
+ *
+ * @param[in,out] batch     a batch collector
+ */
+void gnrc_netapi_batch_flush(gnrc_netapi_batch_t *batch);
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_GET messages and
  *          parsing the returned @ref GNRC_NETAPI_MSG_TYPE_ACK message
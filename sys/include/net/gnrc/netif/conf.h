@@ -78,6 +78,16 @@ extern "C" {
 #define CONFIG_GNRC_NETIF_PKTQ_TIMER_US       (5000U)
 #endif
 
+/**
+ * @brief       Queued packets to the same next hop from which on the
+ *              `gnrc_netif_pktq_ecn` module marks recoverable fragments
+ *
+ * @see         net_gnrc_netif_pktq
+ */
+#ifndef CONFIG_GNRC_NETIF_PKTQ_ECN_THRESHOLD
+#define CONFIG_GNRC_NETIF_PKTQ_ECN_THRESHOLD  (CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE / 2)
+#endif
+
 /**
  * @brief   Number of multicast addresses needed for @ref net_gnrc_rpl "RPL".
  *
@@ -10,6 +10,13 @@
  * @defgroup    net_gnrc_netif_pktq Send queue for @ref net_gnrc_netif
  * @ingroup     net_gnrc_netif
  * @brief
+ *
+ * With the `gnrc_netif_pktq_ecn` module, a recoverable fragment (see
+ * @ref net_sixlowpan_sfr) put into the queue gets the explicit congestion
+ * notification flag set if @ref CONFIG_GNRC_NETIF_PKTQ_ECN_THRESHOLD or more
+ * packets to the same next hop are already queued. If the fragment is
+ * shared, e.g. as its sender keeps it for retransmission, only the queued
+ * packet is marked. The queued packet may thus differ from the one put.
  * @{
  *
  * @file
@@ -36,7 +36,7 @@ extern "C" {
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
-    defined(DOXYGEN)
+    defined(MODULE_GNRC_NETAPI_BATCH) || defined(DOXYGEN)
 /**
  *  @brief  The type of the netreg entry.
  *
@@ -69,6 +69,18 @@ typedef enum {
      */
     GNRC_NETREG_TYPE_CB,
 #endif
+#if defined(MODULE_GNRC_NETAPI_BATCH) || defined(DOXYGEN)
+    /**
+     * @brief   Use [default IPC](@ref core_msg) for
+     *          [netapi](@ref net_gnrc_netapi) operations, the target thread
+     *          also accepts batches of packets.
+     *
+     * @see     @ref net_gnrc_netapi_batch
+     *
+     * @note    Only available with `gnrc_netapi_batch` module.
+     */
+    GNRC_NETREG_TYPE_BATCH,
+#endif
 } gnrc_netreg_type_t;
 #endif
 
@@ -79,6 +91,38 @@ typedef enum {
  */
 #define GNRC_NETREG_DEMUX_CTX_ALL   (0xffff0000)
 
+/**
+ * @brief   Number of hash buckets per @ref gnrc_nettype_t
+ *
+ * With the `gnrc_netreg_hash` module, the entries of every type are chained
+ * per hash bucket of their @ref gnrc_netreg_entry_t::demux_ctx, so the lookup
+ * of e.g. a UDP port does not need to compare the contexts of all sockets.
+ * This costs @ref GNRC_NETTYPE_NUMOF times this number of pointers of RAM.
+ *
+ * @note    Only applicable with the `gnrc_netreg_hash` module
+ */
+#ifndef CONFIG_GNRC_NETREG_HASH_BUCKETS
+#define CONFIG_GNRC_NETREG_HASH_BUCKETS     (8U)
+#endif
+
+#if defined(MODULE_GNRC_NETREG_HASH) || defined(DOXYGEN)
+/**
+ * @brief   Gets the hash bucket of a demux context
+ *
+ * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *
+ * @return  The bucket, smaller than @ref CONFIG_GNRC_NETREG_HASH_BUCKETS
+ *
+ * @note    Only available with the `gnrc_netreg_hash` module.
+ */
+static inline unsigned gnrc_netreg_hash(uint32_t demux_ctx)
+{
+    /* ports and protocol numbers are in the lower half, but fold in the upper
+     * half for GNRC_NETREG_DEMUX_CTX_ALL and similar contexts */
+    return (demux_ctx ^ (demux_ctx >> 16)) % CONFIG_GNRC_NETREG_HASH_BUCKETS;
+}
+#endif
+
 /**
  * @name    Static entry initialization macros
  * @anchor  net_gnrc_netreg_init_static
@@ -93,7 +137,8 @@ typedef enum {
  *
  * @return  An initialized netreg entry
  */
-#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
+    defined(MODULE_GNRC_NETAPI_BATCH)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
                                                       { pid } }
@@ -101,6 +146,28 @@ typedef enum {
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
 #endif
 
+/**
+ * @brief   Initializes a netreg entry statically with PID of a thread that
+ *          accepts batches of packets
+ *
+ * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                      for the netreg entry
+ * @param[in] pid       The PID of the registering thread
+ *
+ * @note    Falls back to @ref GNRC_NETREG_ENTRY_INIT_PID without
+ *          @ref net_gnrc_netapi_batch.
+ *
+ * @return  An initialized netreg entry
+ */
+#if defined(MODULE_GNRC_NETAPI_BATCH)
+#define GNRC_NETREG_ENTRY_INIT_PID_BATCH(demux_ctx, pid)    { NULL, demux_ctx, \
+                                                              GNRC_NETREG_TYPE_BATCH, \
+                                                              { pid } }
+#else
+#define GNRC_NETREG_ENTRY_INIT_PID_BATCH(demux_ctx, pid)    \
+    GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)
+#endif
+
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
 /**
  * @brief   Initializes a netreg entry statically with mbox
@@ -181,7 +248,7 @@ typedef struct gnrc_netreg_entry {
      */
     uint32_t demux_ctx;
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
-    defined(DOXYGEN)
+    defined(MODULE_GNRC_NETAPI_BATCH) || defined(DOXYGEN)
     /**
      * @brief   Type of the registry entry
      *
@@ -237,7 +304,8 @@ static inline void gnrc_netreg_entry_init_pid(gnrc_netreg_entry_t *entry,
 {
     entry->next = NULL;
     entry->demux_ctx = demux_ctx;
-#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
+    defined(MODULE_GNRC_NETAPI_BATCH)
     entry->type = GNRC_NETREG_TYPE_DEFAULT;
 #endif
     entry->target.pid = pid;
@@ -62,6 +62,49 @@ extern "C" {
 #ifndef CONFIG_GNRC_PKTBUF_SIZE
 #define CONFIG_GNRC_PKTBUF_SIZE    (6144)
 #endif
+
+/**
+ * @brief   Number of packet snip descriptors reserved by `gnrc_pktbuf_slab`
+ *
+ * @details Only applies to the `gnrc_pktbuf_slab` implementation. Each slot
+ *          holds exactly one @ref gnrc_pktsnip_t.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF      (32U)
+#endif
+
+/**
+ * @brief   Size of the small data chunks used by `gnrc_pktbuf_slab`
+ *
+ * @details Only applies to the `gnrc_pktbuf_slab` implementation. Small
+ *          chunks are intended for link-layer and network-layer headers. The
+ *          default also fits a complete IEEE 802.15.4 frame, so forwarded
+ *          6LoWPAN fragments do not occupy large chunks.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE      (128U)
+#endif
+
+/**
+ * @brief   Number of small data chunks reserved by `gnrc_pktbuf_slab`
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF     (12U)
+#endif
+
+/**
+ * @brief   Size of the large data chunks used by `gnrc_pktbuf_slab`
+ *
+ * @details Only applies to the `gnrc_pktbuf_slab` implementation. This is the
+ *          largest snip payload that implementation is able to store, so it
+ *          should be at least the largest MTU of all interfaces (e.g. 1536 for
+ *          Ethernet). The number of large chunks is derived from the space in
+ *          @ref CONFIG_GNRC_PKTBUF_SIZE left after the snip descriptors and
+ *          small chunks were reserved.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE      (1280U)
+#endif
 /** @} */
 
 /**
@@ -140,6 +140,33 @@ extern "C" {
 #define CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER              (0U)
 #endif
 
+/**
+ * @brief   Number of hash buckets to look up reassembly buffer entries
+ *
+ * @note    Only applicable with the `gnrc_sixlowpan_frag_rb_hash` module
+ *
+ * Entries are hashed by link-layer source, destination and datagram tag, so
+ * a fragment is only compared against the entries in its bucket. Must be
+ * lesser than 256.
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_HASH_BUCKETS
+#define CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_HASH_BUCKETS           (8U)
+#endif
+
+/**
+ * @brief   Number of flows to cache the IPHC address compression for
+ *
+ * @note    Only applicable with the `gnrc_sixlowpan_iphc_cache` module
+ *
+ * The compressed source and destination address of recently sent datagrams
+ * are kept per flow, so datagrams of the same flow skip the context lookups
+ * and address derivations on encoding. Cached compressions are dropped
+ * whenever the context buffer changes.
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE                  (4U)
+#endif
+
 /**
  * @brief   Registration lifetime in minutes for the address registration option
  *
@@ -113,17 +113,40 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
                                                 uint8_t prefix_len, uint16_t ltime,
                                                 bool comp);
 
-#ifdef MODULE_GNRC_SIXLOWPAN_CTX
 /**
  * @brief   Removes context.
  *
  * @param[in] id    A context ID.
  */
-static inline void gnrc_sixlowpan_ctx_remove(uint8_t id)
-{
-    gnrc_sixlowpan_ctx_lookup_id(id)->prefix_len = 0;
-}
-#endif
+void gnrc_sixlowpan_ctx_remove(uint8_t id);
+
+/**
+ * @brief   Removes context without blocking
+ *
+ * Unlike @ref gnrc_sixlowpan_ctx_remove(), this function can be called from
+ * interrupt context, e.g. from a timer callback.
+ *
+ * @param[in] id    A context ID.
+ *
+ * @return  false, if the context buffer is currently in use. Try again later.
+ * @return  true, otherwise.
+ */
+bool gnrc_sixlowpan_ctx_try_remove(uint8_t id);
+
+/**
+ * @brief   Gets the generation of the context buffer
+ *
+ * The generation changes whenever a context is updated or removed and at least
+ * once per minute, since that is the granularity in which context lifetimes
+ * expire. Results derived from context lookups, e.g. a cached compression of
+ * an address, stay valid as long as the generation does not change.
+ *
+ * @note    Contexts must only be changed using the functions of this module
+ *          for this to hold.
+ *
+ * @return  The current generation of the context buffer.
+ */
+uint32_t gnrc_sixlowpan_ctx_generation(void);
 
 #ifdef TEST_SUITES
 /**
@@ -10,6 +10,13 @@
  * @defgroup net_gnrc_sixlowpan_frag_rb 6LoWPAN reassembly buffer
  * @ingroup  net_gnrc_sixlowpan_frag
  * @brief    6LoWPAN reassembly buffer
+ *
+ * Received fragments of a datagram are tracked as intervals, adjacent
+ * intervals are merged on insertion. With the `gnrc_sixlowpan_frag_rb_hash`
+ * module, entries are looked up in
+ * @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_HASH_BUCKETS hash buckets instead of
+ * comparing each fragment against every entry, which keeps the per-fragment
+ * cost flat for large @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE.
  * @{
  *
  * @file
@@ -10,6 +10,14 @@
  * @defgroup    net_gnrc_sixlowpan_iphc   IPv6 header compression (IPHC)
  * @ingroup     net_gnrc_sixlowpan
  * @brief       IPv6 header compression for 6LoWPAN.
+ *
+ * With the `gnrc_sixlowpan_iphc_cache` module the compressed addresses of the
+ * last @ref CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE flows are cached, so
+ * subsequent datagrams of a flow only need their traffic class, flow label,
+ * next header and hop limit fields to be compressed. A flow is identified by
+ * its IPv6 source and destination address, the interface and link-layer
+ * destination it is sent to and the link-layer address of that interface, as
+ * only those determine the address compression.
  * @{
  *
  * @file
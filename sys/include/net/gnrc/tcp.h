@@ -162,6 +162,9 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occurred.
+ *       Transmitted bytes are held in the retransmission queue until the peer
+ *       acknowledges them, the function does not wait for that. Up to
+ *       CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE - 1 segments can be in flight.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -108,6 +108,46 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (CONFIG_GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Number of segments in the retransmission queue of each connection.
+ *
+ * This bounds the number of unacknowledged segments in flight. One slot is
+ * always reserved for the FIN segment, so at least two are required.
+ */
+#ifndef CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE (4U)
+#endif
+
+/**
+ * @brief Enable the window scale option (see RFC 7323).
+ *
+ * Allows receive buffers (@ref CONFIG_GNRC_TCP_DEFAULT_WINDOW) of more than
+ * 64 KiB and makes use of peers offering send windows of that size.
+ */
+#ifndef CONFIG_GNRC_TCP_WINDOW_SCALE
+#define CONFIG_GNRC_TCP_WINDOW_SCALE 0
+#endif
+
+/**
+ * @brief Enable selective acknowledgments (see RFC 2018).
+ *
+ * Out-of-order segments are kept until the gap in front of them is filled
+ * and reported to the peer, which then only needs to retransmit the missing
+ * segments. Acknowledged segments are skipped on retransmission.
+ */
+#ifndef CONFIG_GNRC_TCP_SACK
+#define CONFIG_GNRC_TCP_SACK 0
+#endif
+
+/**
+ * @brief Number of out-of-order segments kept per connection.
+ *
+ * @note Only applicable with @ref CONFIG_GNRC_TCP_SACK
+ */
+#ifndef CONFIG_GNRC_TCP_SACK_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_SACK_QUEUE_SIZE (4U)
+#endif
+
 /**
  * @brief Lower bound for RTO in milliseconds. Default is 1 sec (see RFC 6298)
  *
@@ -55,22 +55,42 @@ typedef struct _transmission_control_block {
     uint8_t status;        /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint8_t snd_wnd_shift; /**< The peers window scale shift count */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
-    uint8_t retries;       /**< Number of retransmissions */
+    uint8_t retries;       /**< Number of retransmission timeouts */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
+    uint32_t rtt_seq;      /**< AckNo. completing the current rtt measurement */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Highest SeqNo. sent when loss recovery started */
+    uint32_t high_rxt;     /**< Highest SeqNo. retransmitted during loss recovery */
     evtimer_msg_event_t event_retransmit; /**< Retransmission event */
     evtimer_mbox_event_t event_misc;      /**< General purpose event */
-    gnrc_pktsnip_t *pkt_retransmit;       /**< Pointer to packet in "retransmit queue" */
+    /**
+     * @brief Retransmit queue, oldest unacknowledged packet first
+     */
+    gnrc_pktsnip_t *pkt_retransmit[CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE];
+    uint8_t pkt_retransmit_numof;         /**< Number of packets in retransmit queue */
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK) || defined(DOXYGEN)
+    uint32_t pkt_retransmit_sacked;       /**< Bitmap of selectively acknowledged packets */
+    /**
+     * @brief Out-of-order segments received, sorted by sequence number
+     */
+    gnrc_pktsnip_t *pkt_ooo[CONFIG_GNRC_TCP_SACK_QUEUE_SIZE];
+    uint8_t pkt_ooo_numof;   /**< Number of out-of-order segments */
+    uint32_t ooo_last_seq;   /**< SeqNo. of the latest out-of-order segment */
+#endif
     mbox_t *mbox;            /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
@@ -1522,7 +1522,8 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
  * @brief   Pass a coap request to a matching handler
  *
  * This function will try to find a matching handler in @p resources and call
- * the handler.
+ * the handler. @p resources must be sorted by path (ASCII order), see
+ * @ref coap_find_resource().
  *
  * @param[in]   pkt             pointer to (parsed) CoAP packet
  * @param[out]  resp_buf        buffer for response
@@ -1693,6 +1694,38 @@ extern ssize_t coap_well_known_core_default_handler(coap_pkt_t *pkt, \
  */
 int coap_match_path(const coap_resource_t *resource, uint8_t *uri);
 
+/**
+ * @brief   Finds the resource for a URI in an array of resources
+ *
+ * The resources must be sorted by path (ASCII order). Resources with the same
+ * path, e.g. for different methods, are allowed. The array is searched one
+ * character of @p uri at a time with a binary search within the resources
+ * matching the characters before, so the lookup needs at most
+ * `strlen(uri) * 2 * log2(resources_numof)` character comparisons instead of
+ * a string comparison for every resource.
+ *
+ * The result is the same as with checking the resources in order with
+ * @ref coap_match_path(): if multiple resources match, e.g. a resource with
+ * @ref COAP_MATCH_SUBTREE and a resource for the full path, the first one in
+ * the array that allows @p method_flag is returned.
+ *
+ * @note This function is not intended for application use.
+ * @internal
+ *
+ * @param[in]  resources       Array of resources sorted by path
+ * @param[in]  resources_numof Number of entries in @p resources
+ * @param[in]  uri             Null-terminated string URI to look up
+ * @param[in]  method_flag     Method of the request, see coap_method2flag()
+ * @param[out] resource        The matching resource
+ *
+ * @return 0 if a matching resource was found
+ * @return -ENOENT if no resource path matches @p uri
+ * @return -ENOTSUP if resources match the path, but not @p method_flag
+ */
+int coap_find_resource(const coap_resource_t *resources, size_t resources_numof,
+                       const uint8_t *uri, coap_method_flags_t method_flag,
+                       const coap_resource_t **resource);
+
 #if defined(MODULE_GCOAP) || defined(DOXYGEN)
 /**
  * @name    Functions -- gcoap specific
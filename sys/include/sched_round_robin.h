@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_round_robin Round-robin scheduling
+ * @ingroup     sys
+ * @brief       Time slicing among threads of equal priority
+ *
+ * RIOT's scheduler lets a thread run until it blocks or yields, so a
+ * CPU-bound thread starves other threads of the same priority. With this
+ * module the threads of a priority level take turns: when the thread at
+ * the head of the highest runnable priority ran for a time slice, it is
+ * moved to the end of its runqueue.
+ *
+ * The slice timer only runs while more than one thread of the highest
+ * runnable priority is ready, so there are no periodic wakeups while a
+ * single thread or no thread at all is runnable.
+ *
+ * The slice length can be changed per priority level with
+ * @ref sched_rr_set_slice().
+ *
+ * @note    If auto_init is disabled, @ref sched_round_robin_init() needs to
+ *          be called after ztimer was initialized.
+ * @{
+ *
+ * @file
+ * @brief       Round-robin scheduling definitions
+ */
+
+#ifndef SCHED_ROUND_ROBIN_H
+#define SCHED_ROUND_ROBIN_H
+
+#include <stdint.h>
+
+#include "sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup    sys_sched_round_robin_conf Round-robin scheduling
+ *              compile configurations
+ * @ingroup     config
+ * @{
+ */
+/**
+ * @brief   Default time slice in microseconds
+ */
+#ifndef CONFIG_SCHED_RR_SLICE_US
+#define CONFIG_SCHED_RR_SLICE_US    (10000U)
+#endif
+
+/**
+ * @brief   Bitmask of priority levels using time slicing by default
+ *
+ * Bit `n` enables time slicing for priority `n`. Defaults to all levels but
+ * the lowest, which is used by the idle thread.
+ */
+#ifndef CONFIG_SCHED_RR_MASK
+#define CONFIG_SCHED_RR_MASK        ((1UL << (SCHED_PRIO_LEVELS - 1)) - 1)
+#endif
+/** @} */
+
+/**
+ * @brief   Initializes round-robin scheduling
+ *
+ * Sets the slices of the priorities in @ref CONFIG_SCHED_RR_MASK to
+ * @ref CONFIG_SCHED_RR_SLICE_US.
+ */
+void sched_round_robin_init(void);
+
+/**
+ * @brief   Sets the time slice of a priority level
+ *
+ * Takes effect with the next slice started for @p prio.
+ *
+ * @param[in] prio      Priority level
+ * @param[in] slice_us  Time slice in microseconds, 0 disables time slicing
+ *                      for @p prio
+ */
+void sched_rr_set_slice(uint8_t prio, uint32_t slice_us);
+
+/**
+ * @brief   Gets the time slice of a priority level
+ *
+ * @param[in] prio  Priority level
+ *
+ * @return  Time slice of @p prio in microseconds, 0 if time slicing is
+ *          disabled for @p prio
+ */
+uint32_t sched_rr_get_slice(uint8_t prio);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_ROUND_ROBIN_H */
+/** @} */
@@ -128,6 +128,10 @@ typedef enum {
  * block-wise-transfer. A coap_blockwise_cb_t will be called on each received
  * block.
  *
+ * @note    With the `gcoap_block` module, a server that answers with the whole
+ *          resource instead of its first block makes the fetch fail if the
+ *          resource is larger than @ref CONFIG_GCOAP_BLOCK_SIZE_MAX.
+ *
  * @param[in]   url        url pointer to source path
  * @param[in]   blksize    sender suggested SZX for the COAP block request
  * @param[in]   callback   callback to be executed on each received block
@@ -41,6 +41,30 @@
  * trace_dump();
  * ~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * Structured event tracing
+ * ========================
+ *
+ * With the `trace_events` pseudomodule, the kernel and GNRC record what they
+ * are doing into a second ring buffer of compact, 8 byte records (see
+ * @ref trace_event_t): context switches, messages sent and received, threads
+ * blocking on a locked mutex, interrupt service routines and packet buffer
+ * allocations. Which kinds of events are recorded is selected at run time
+ * with `trace_events_enable()`. Recording is off after boot.
+ *
+ * While an event kind is disabled, the only cost at its trace point is
+ * checking a bit in @ref trace_events_mask. Recording an event takes the
+ * timestamp and four stores with interrupts disabled, so the module can be
+ * left in production builds. On Cortex-M cores with a DWT cycle counter, the
+ * timestamps are CPU cycles, otherwise microseconds from `xtimer`.
+ *
+ * `trace_events_dump()` prints the buffer as hex encoded records.
+ * `dist/tools/trace_events/trace_events.py` decodes this output into a trace
+ * for [Perfetto](https://ui.perfetto.dev) or `chrome://tracing`.
+ *
+ * Only the native CPU reports interrupt service routines on its own. Other
+ * ports may call `trace_event()` with @ref TRACE_EVENT_ISR_ENTER and
+ * @ref TRACE_EVENT_ISR_EXIT from their interrupt dispatch.
+ *
  * @{
  *
  * @brief       Execution tracing module API
@@ -55,10 +79,21 @@
 
 #include <stdint.h>
 
+#include "kernel_defines.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Size of the structured event trace buffer, in records
+ *
+ * Must be a power of two.
+ */
+#ifndef CONFIG_TRACE_EVENTS_BUFSIZE
+#define CONFIG_TRACE_EVENTS_BUFSIZE 256
+#endif
+
 /**
  * @brief   Add entry to trace buffer
  *
@@ -92,6 +127,113 @@ void trace_dump(void);
  */
 void trace_reset(void);
 
+/**
+ * @brief   Kinds of structured trace events
+ *
+ * The meaning of @ref trace_event_t::arg depends on the kind.
+ */
+typedef enum {
+    TRACE_EVENT_USER = 0,       /**< user defined, arg: user value */
+    TRACE_EVENT_SCHED,          /**< switched to the thread, arg: previous
+                                 *   thread */
+    TRACE_EVENT_MSG_SEND,       /**< message sent, arg: target thread */
+    TRACE_EVENT_MSG_RECV,       /**< message received, arg: sender */
+    TRACE_EVENT_MUTEX_WAIT,     /**< blocking on a locked mutex, arg: lower
+                                 *   16 bit of the mutex address */
+    TRACE_EVENT_MUTEX_ACQUIRE,  /**< got the mutex waited for, arg: lower 16 bit
+                                 *   of the mutex address */
+    TRACE_EVENT_ISR_ENTER,      /**< interrupt service routine entered,
+                                 *   arg: interrupt number */
+    TRACE_EVENT_ISR_EXIT,       /**< interrupt service routine left,
+                                 *   arg: interrupt number */
+    TRACE_EVENT_PKTBUF_ALLOC,   /**< packet buffer allocated, arg: size */
+    TRACE_EVENT_PKTBUF_FREE,    /**< packet buffer freed, arg: size */
+    TRACE_EVENT_NUMOF,          /**< number of event kinds */
+} trace_event_type_t;
+
+/**
+ * @brief   Mask selecting all kinds of structured trace events
+ */
+#define TRACE_EVENTS_ALL        ((1U << TRACE_EVENT_NUMOF) - 1)
+
+/**
+ * @brief   A structured trace record
+ */
+typedef struct {
+    uint32_t time;              /**< timestamp, in cycles or microseconds */
+    uint8_t type;               /**< kind of event, see trace_event_type_t */
+    uint8_t pid;                /**< thread running when recorded,
+                                 *   @ref KERNEL_PID_ISR in interrupt context
+                                 *   except for context switches */
+    uint16_t arg;               /**< argument depending on trace_event_t::type */
+} trace_event_t;
+
+/**
+ * @brief   Kinds of structured trace events currently recorded
+ *
+ * One bit per @ref trace_event_type_t. Use `trace_events_enable()` to change.
+ */
+extern uint16_t trace_events_mask;
+
+/**
+ * @brief   Records a structured trace event unconditionally
+ *
+ * @internal    Use `trace_event()` instead
+ *
+ * @param[in]   type    kind of the event
+ * @param[in]   arg     argument of the event
+ */
+void trace_event_record(trace_event_type_t type, uint16_t arg);
+
+/**
+ * @brief   Records a structured trace event, if its kind is enabled
+ *
+ * Safe to call from anywhere, including interrupt context. Does nothing
+ * without the `trace_events` module.
+ *
+ * @param[in]   type    kind of the event
+ * @param[in]   arg     argument of the event
+ */
+static inline void trace_event(trace_event_type_t type, uint16_t arg)
+{
+    if (IS_USED(MODULE_TRACE_EVENTS) &&
+        (trace_events_mask & (1U << type))) {
+        trace_event_record(type, arg);
+    }
+}
+
+/**
+ * @brief   Selects the kinds of structured trace events to record
+ *
+ * @param[in]   mask    one bit per @ref trace_event_type_t, 0 to stop
+ *                      recording, @ref TRACE_EVENTS_ALL to record everything
+ */
+void trace_events_enable(uint16_t mask);
+
+/**
+ * @brief   Prints the structured trace buffer, oldest record first
+ *
+ * Recording is paused while printing. The output starts with a header giving
+ * the timestamp frequency, the number of overwritten records and the PID of
+ * events recorded in interrupt context, followed by the names of all threads
+ * and the records in lines of hex encoded little endian values:
+ *
+ *     trace_events: v1 hz=1000000 records=3 lost=0 isr=33
+ *     trace_events: thread 1 idle
+ *     trace_events: thread 2 main
+ *     trace_events: 9a0f00000102010019100000030201005b11000001010200
+ *     trace_events: end
+ *
+ * `dist/tools/trace_events/trace_events.py` converts this output to a trace
+ * viewable in Perfetto.
+ */
+void trace_events_dump(void);
+
+/**
+ * @brief   Empties the structured trace buffer
+ */
+void trace_events_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
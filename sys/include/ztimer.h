@@ -122,6 +122,19 @@
  * (now() - B) + T[1]). Thus even though the list is keeping relative offsets,
  * the time keeping is done by keeping track of the absolute times.
  *
+ * Inserting into the list takes time linear in the number of timers set on
+ * the clock, with interrupts disabled. The `ztimer_wheel` module replaces the
+ * list by a hierarchical timing wheel of @ref ZTIMER_WHEEL_LEVELS levels with
+ * @ref ZTIMER_WHEEL_SLOTS slots each. A timer is stored by its absolute
+ * target in the slot of the highest group of @ref ZTIMER_WHEEL_BITS bits in
+ * which the target differs from the time the wheel has been advanced to.
+ * Setting and removing a timer then take constant time. When that time reaches
+ * a slot of a higher level, its timers are moved down to the lower levels,
+ * so each timer is moved at most once per level before it triggers. Timers
+ * with the same target still trigger in the order they were set, but every
+ * clock needs room for the slot heads and removing a timer leaves the
+ * hardware timer set, so the clock may see an interrupt with nothing to do.
+ *
  *
  * ## Clock extension
  *
@@ -243,9 +256,31 @@ typedef struct ztimer_clock ztimer_clock_t;
  */
 struct ztimer_base {
     ztimer_base_t *next;        /**< next timer in list */
-    uint32_t offset;            /**< offset from last timer in list */
+    uint32_t offset;            /**< offset from last timer in list, or
+                                     absolute target with `ztimer_wheel` */
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_base_t **pprev;      /**< link pointing to this timer, NULL if
+                                     the timer is not set */
+#endif
 };
 
+/**
+ * @brief   Number of target bits each level of the timing wheel resolves
+ *
+ * Only used with the `ztimer_wheel` module.
+ */
+#define ZTIMER_WHEEL_BITS   (4U)
+
+/**
+ * @brief   Number of slots per level of the timing wheel
+ */
+#define ZTIMER_WHEEL_SLOTS  (1U << ZTIMER_WHEEL_BITS)
+
+/**
+ * @brief   Number of levels of the timing wheel, covering 32 bit targets
+ */
+#define ZTIMER_WHEEL_LEVELS (32U / ZTIMER_WHEEL_BITS)
+
 #if MODULE_ZTIMER_NOW64
 typedef uint64_t ztimer_now_t;  /**< type for ztimer_now() result */
 #else
@@ -307,6 +342,14 @@ struct ztimer_clock {
 #if MODULE_PM_LAYERED || DOXYGEN
     uint8_t required_pm_mode;       /**< min. pm mode required for the clock to run */
 #endif
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    /** timing wheel slots, each a list of timers newest first */
+    ztimer_base_t *wheel[ZTIMER_WHEEL_LEVELS][ZTIMER_WHEEL_SLOTS];
+    uint16_t wheel_used[ZTIMER_WHEEL_LEVELS]; /**< non-empty slots per level */
+    uint32_t wheel_now;             /**< time the wheel is advanced to      */
+    uint32_t wheel_target;          /**< target the clock is set to         */
+    unsigned wheel_numof;           /**< number of timers on the wheel      */
+#endif
 };
 
 /**
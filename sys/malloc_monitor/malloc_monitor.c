@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_malloc_monitor
+ * @{
+ *
+ * @file
+ * @brief       Memory allocation monitor implementation
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "malloc_monitor.h"
+#include "malloc_monitor_internal.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static malloc_monitor_entry_t _entries[CONFIG_MALLOC_MONITOR_SLOTS];
+static malloc_monitor_stats_t _stats[MALLOC_MONITOR_SRC_NUMOF];
+/* index 0 (KERNEL_PID_UNDEF) collects allocations in interrupt context */
+static malloc_monitor_usage_t _threads[MALLOC_MONITOR_SRC_NUMOF]
+                                      [KERNEL_PID_LAST + 1];
+static malloc_monitor_usage_t _tags[MALLOC_MONITOR_SRC_NUMOF]
+                                   [CONFIG_MALLOC_MONITOR_TAGS];
+static uint8_t _thread_tags[KERNEL_PID_LAST + 1];
+static const char *_tag_names[CONFIG_MALLOC_MONITOR_TAGS];
+
+static const char *_src_names[] = {
+    [MALLOC_MONITOR_SRC_HEAP] = "heap",
+    [MALLOC_MONITOR_SRC_MEMARRAY] = "memarray",
+    [MALLOC_MONITOR_SRC_PKTBUF] = "pktbuf",
+};
+
+static inline void _add(malloc_monitor_usage_t *usage, size_t size)
+{
+    usage->current += size;
+    if (usage->current > usage->peak) {
+        usage->peak = usage->current;
+    }
+}
+
+static unsigned _bucket(size_t size)
+{
+    unsigned bucket = 0;
+
+    while ((bucket < (CONFIG_MALLOC_MONITOR_HIST_BUCKETS - 1)) &&
+           (size > (16U << bucket))) {
+        bucket++;
+    }
+    return bucket;
+}
+
+/* allocations of 0 bytes are valid, so only frees of a part search the
+ * containing allocation */
+static malloc_monitor_entry_t *_find(malloc_monitor_src_t src,
+                                     const void *ptr, bool part)
+{
+    for (unsigned i = 0; i < CONFIG_MALLOC_MONITOR_SLOTS; i++) {
+        malloc_monitor_entry_t *e = &_entries[i];
+
+        if ((e->ptr == NULL) || (e->src != src)) {
+            continue;
+        }
+        if ((e->ptr == ptr) ||
+            (part && ((uintptr_t)ptr > (uintptr_t)e->ptr) &&
+             ((uintptr_t)ptr < ((uintptr_t)e->ptr + e->size)))) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void _sub(const malloc_monitor_entry_t *e, size_t size)
+{
+    _stats[e->src].usage.current -= size;
+    _threads[e->src][e->pid].current -= size;
+    _tags[e->src][e->tag].current -= size;
+}
+
+/* must be called with interrupts disabled */
+static void _insert(const malloc_monitor_entry_t *entry)
+{
+    for (unsigned i = 0; i < CONFIG_MALLOC_MONITOR_SLOTS; i++) {
+        malloc_monitor_entry_t *e = &_entries[i];
+
+        if (e->ptr == NULL) {
+            *e = *entry;
+            _add(&_stats[e->src].usage, e->left);
+            _add(&_threads[e->src][e->pid], e->left);
+            _add(&_tags[e->src][e->tag], e->left);
+            return;
+        }
+    }
+    DEBUG("malloc_monitor: no slot for %p (%u bytes)\n", entry->ptr,
+          (unsigned)entry->size);
+    _stats[entry->src].untracked++;
+}
+
+uint8_t malloc_monitor_tag_set(uint8_t tag)
+{
+    kernel_pid_t pid = thread_getpid();
+    uint8_t old;
+
+    assert(tag < CONFIG_MALLOC_MONITOR_TAGS);
+    old = _thread_tags[pid];
+    _thread_tags[pid] = tag;
+    return old;
+}
+
+void malloc_monitor_tag_name(uint8_t tag, const char *name)
+{
+    assert(tag < CONFIG_MALLOC_MONITOR_TAGS);
+    _tag_names[tag] = name;
+}
+
+void malloc_monitor_record_alloc(malloc_monitor_src_t src, const void *ptr,
+                                 size_t size)
+{
+    malloc_monitor_entry_t entry = { .ptr = ptr, .size = size, .left = size,
+                                     .src = src };
+    unsigned state;
+
+    assert(src < MALLOC_MONITOR_SRC_NUMOF);
+    state = irq_disable();
+    if (ptr == NULL) {
+        _stats[src].failed++;
+        irq_restore(state);
+        return;
+    }
+    _stats[src].allocs++;
+    _stats[src].hist[_bucket(size)]++;
+    if (irq_is_in()) {
+        entry.pid = KERNEL_PID_UNDEF;
+        entry.tag = MALLOC_MONITOR_TAG_NONE;
+    }
+    else {
+        entry.pid = thread_getpid();
+        entry.tag = _thread_tags[entry.pid];
+    }
+    _insert(&entry);
+    irq_restore(state);
+}
+
+void malloc_monitor_record_free(malloc_monitor_src_t src, const void *ptr,
+                                size_t size)
+{
+    unsigned state;
+    malloc_monitor_entry_t *e;
+
+    assert(src < MALLOC_MONITOR_SRC_NUMOF);
+    if (ptr == NULL) {
+        return;
+    }
+    state = irq_disable();
+    e = _find(src, ptr, size != 0);
+    if (e != NULL) {
+        size_t offset = (uintptr_t)ptr - (uintptr_t)e->ptr;
+
+        /* release the whole allocation or any part of it, e.g. the head
+         * of a packet buffer chunk split by gnrc_pktbuf_mark() */
+        if ((size == 0) || ((offset + size) > e->size)) {
+            size = e->size - offset;
+        }
+        if (size > e->left) {
+            size = e->left;
+        }
+        _sub(e, size);
+        e->left -= size;
+        if (e->left == 0) {
+            _stats[src].frees++;
+            e->ptr = NULL;
+        }
+        else if (offset == 0) {
+            /* the released head may be allocated again right away, so it
+             * must not match this entry anymore */
+            e->ptr = (const uint8_t *)e->ptr + size;
+            e->size -= size;
+        }
+        else if ((offset + size) == e->size) {
+            e->size -= size;
+        }
+    }
+    irq_restore(state);
+}
+
+bool malloc_monitor_detach(malloc_monitor_src_t src, const void *ptr,
+                           malloc_monitor_entry_t *entry)
+{
+    unsigned state;
+    malloc_monitor_entry_t *e;
+
+    assert(src < MALLOC_MONITOR_SRC_NUMOF);
+    if (ptr == NULL) {
+        return false;
+    }
+    state = irq_disable();
+    e = _find(src, ptr, false);
+    if (e != NULL) {
+        *entry = *e;
+        _sub(e, e->left);
+        _stats[src].frees++;
+        e->ptr = NULL;
+    }
+    irq_restore(state);
+    return (e != NULL);
+}
+
+void malloc_monitor_attach(const malloc_monitor_entry_t *entry)
+{
+    unsigned state = irq_disable();
+
+    _stats[entry->src].frees--;
+    _insert(entry);
+    irq_restore(state);
+}
+
+void malloc_monitor_get_stats(malloc_monitor_src_t src,
+                              malloc_monitor_stats_t *stats)
+{
+    unsigned state;
+
+    assert((src < MALLOC_MONITOR_SRC_NUMOF) && (stats != NULL));
+    state = irq_disable();
+    *stats = _stats[src];
+    irq_restore(state);
+}
+
+void malloc_monitor_get_thread_usage(malloc_monitor_src_t src,
+                                     kernel_pid_t pid,
+                                     malloc_monitor_usage_t *usage)
+{
+    unsigned state;
+
+    assert((src < MALLOC_MONITOR_SRC_NUMOF) && (pid >= 0) &&
+           (pid <= KERNEL_PID_LAST) && (usage != NULL));
+    state = irq_disable();
+    *usage = _threads[src][pid];
+    irq_restore(state);
+}
+
+void malloc_monitor_get_tag_usage(malloc_monitor_src_t src, uint8_t tag,
+                                  malloc_monitor_usage_t *usage)
+{
+    unsigned state;
+
+    assert((src < MALLOC_MONITOR_SRC_NUMOF) &&
+           (tag < CONFIG_MALLOC_MONITOR_TAGS) && (usage != NULL));
+    state = irq_disable();
+    *usage = _tags[src][tag];
+    irq_restore(state);
+}
+
+void malloc_monitor_reset_peaks(void)
+{
+    unsigned state = irq_disable();
+
+    for (unsigned src = 0; src < MALLOC_MONITOR_SRC_NUMOF; src++) {
+        _stats[src].usage.peak = _stats[src].usage.current;
+        for (unsigned i = 0; i <= KERNEL_PID_LAST; i++) {
+            _threads[src][i].peak = _threads[src][i].current;
+        }
+        for (unsigned i = 0; i < CONFIG_MALLOC_MONITOR_TAGS; i++) {
+            _tags[src][i].peak = _tags[src][i].current;
+        }
+    }
+    irq_restore(state);
+}
+
+static void _print_usage(const char *kind, const char *name, int id,
+                         const malloc_monitor_usage_t *usage)
+{
+    if (usage->peak == 0) {
+        return;
+    }
+    printf("  %-6s %3d %-16s %8u %8u\n", kind, id, name,
+           (unsigned)usage->current, (unsigned)usage->peak);
+}
+
+void malloc_monitor_print(void)
+{
+    for (unsigned src = 0; src < MALLOC_MONITOR_SRC_NUMOF; src++) {
+        malloc_monitor_stats_t stats;
+
+        malloc_monitor_get_stats(src, &stats);
+        if ((stats.allocs == 0) && (stats.failed == 0)) {
+            continue;
+        }
+        printf("%s: %u bytes used, %u peak, %" PRIu32 " allocs, %" PRIu32
+               " frees, %" PRIu32 " failed, %" PRIu32 " untracked\n",
+               _src_names[src], (unsigned)stats.usage.current,
+               (unsigned)stats.usage.peak, stats.allocs, stats.frees,
+               stats.failed, stats.untracked);
+        printf("  sizes:");
+        for (unsigned i = 0; i < CONFIG_MALLOC_MONITOR_HIST_BUCKETS; i++) {
+            printf(" %s%u:%" PRIu32,
+                   (i == (CONFIG_MALLOC_MONITOR_HIST_BUCKETS - 1)) ? ">" : "<=",
+                   (i == (CONFIG_MALLOC_MONITOR_HIST_BUCKETS - 1))
+                        ? (16U << (i - 1)) : (16U << i),
+                   stats.hist[i]);
+        }
+        printf("\n  %-6s %3s %-16s %8s %8s\n", "", "id", "name", "used",
+               "peak");
+        for (kernel_pid_t pid = 0; pid <= KERNEL_PID_LAST; pid++) {
+            malloc_monitor_usage_t usage;
+            const char *name = "isr";
+
+            malloc_monitor_get_thread_usage(src, pid, &usage);
+            if (pid != KERNEL_PID_UNDEF) {
+                name = thread_getname(pid);
+                name = (name != NULL) ? name : "-";
+            }
+            _print_usage("thread", name, pid, &usage);
+        }
+        for (unsigned tag = 0; tag < CONFIG_MALLOC_MONITOR_TAGS; tag++) {
+            malloc_monitor_usage_t usage;
+            const char *name = _tag_names[tag];
+
+            malloc_monitor_get_tag_usage(src, tag, &usage);
+            _print_usage("tag", (name != NULL) ? name : "-", tag, &usage);
+        }
+    }
+}
+
+/** @} */
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_malloc_monitor
+ * @{
+ *
+ * @file
+ * @brief       Internal functions of the memory allocation monitor
+ */
+
+#ifndef MALLOC_MONITOR_INTERNAL_H
+#define MALLOC_MONITOR_INTERNAL_H
+
+#include <stdbool.h>
+
+#include "malloc_monitor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A recorded allocation
+ */
+typedef struct {
+    const void *ptr;            /**< start of the allocation, NULL if unused */
+    size_t size;                /**< size of the allocation in bytes, without
+                                 *   a released head or tail */
+    size_t left;                /**< bytes of the allocation not freed yet */
+    kernel_pid_t pid;           /**< allocating thread */
+    uint8_t tag;                /**< tag of the allocating thread */
+    uint8_t src;                /**< allocator */
+} malloc_monitor_entry_t;
+
+/**
+ * @brief   Records a free of a whole allocation and returns its record
+ *
+ * Allows an allocator to record a free before it actually releases the
+ * memory, which may be allocated again by another thread right after.
+ *
+ * @param[in] src       The allocator
+ * @param[in] ptr       Start of the allocation
+ * @param[out] entry    The record of the allocation
+ *
+ * @return  true, if the allocation was recorded
+ */
+bool malloc_monitor_detach(malloc_monitor_src_t src, const void *ptr,
+                           malloc_monitor_entry_t *entry);
+
+/**
+ * @brief   Reverts @ref malloc_monitor_detach(), if the memory was not
+ *          released after all
+ *
+ * @param[in] entry     The record returned by @ref malloc_monitor_detach()
+ */
+void malloc_monitor_attach(const malloc_monitor_entry_t *entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MALLOC_MONITOR_INTERNAL_H */
+/** @} */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_malloc_monitor
+ * @{
+ *
+ * @file
+ * @brief       Link time wrappers of the heap functions
+ *
+ * The module's Makefile.include passes `-Wl,--wrap=<function>` to the
+ * linker, so calls to e.g. `malloc()` end up in `__wrap_malloc()`, which
+ * calls the C library's implementation as `__real_malloc()`.
+ */
+
+#include <stdlib.h>
+
+#include "malloc_monitor.h"
+#include "malloc_monitor_internal.h"
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size)
+{
+    void *ptr = __real_malloc(size);
+
+    malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_HEAP, ptr, size);
+    return ptr;
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    void *ptr = __real_calloc(nmemb, size);
+
+    malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_HEAP, ptr, nmemb * size);
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    malloc_monitor_entry_t old;
+    /* record the free first, another thread may get the old memory as soon
+     * as it is released */
+    bool tracked = malloc_monitor_detach(MALLOC_MONITOR_SRC_HEAP, ptr, &old);
+    void *new = __real_realloc(ptr, size);
+
+    if ((new == NULL) && (size > 0)) {
+        /* ptr is still valid and unchanged */
+        if (tracked) {
+            malloc_monitor_attach(&old);
+        }
+        malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_HEAP, NULL, size);
+        return NULL;
+    }
+    if (new != NULL) {
+        malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_HEAP, new, size);
+    }
+    return new;
+}
+
+void __wrap_free(void *ptr)
+{
+    /* record first, the memory may be reused as soon as it is released */
+    malloc_monitor_record_free(MALLOC_MONITOR_SRC_HEAP, ptr, 0);
+    __real_free(ptr);
+}
+
+/** @} */
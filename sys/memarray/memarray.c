@@ -7,6 +7,8 @@
  */
 
 #include <string.h>
+#include "kernel_defines.h"
+#include "malloc_monitor.h"
 #include "memarray.h"
 
 #define ENABLE_DEBUG    (0)
@@ -36,11 +38,19 @@ void *memarray_alloc(memarray_t *mem)
     assert(mem != NULL);
 
     if (mem->free_data == NULL) {
+        if (IS_USED(MODULE_MALLOC_MONITOR_MEMARRAY)) {
+            malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_MEMARRAY, NULL,
+                                        mem->size);
+        }
         return NULL;
     }
     void *free = mem->free_data;
     mem->free_data = *((void **)mem->free_data);
     DEBUG("memarray: Allocate %u Bytes at %p\n", (unsigned)mem->size, free);
+    if (IS_USED(MODULE_MALLOC_MONITOR_MEMARRAY)) {
+        malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_MEMARRAY, free,
+                                    mem->size);
+    }
     return free;
 }
 
@@ -57,6 +67,9 @@ void memarray_free(memarray_t *mem, void *ptr)
 {
     assert((mem != NULL) && (ptr != NULL));
 
+    if (IS_USED(MODULE_MALLOC_MONITOR_MEMARRAY)) {
+        malloc_monitor_record_free(MALLOC_MONITOR_SRC_MEMARRAY, ptr, 0);
+    }
     memcpy(ptr, &mem->free_data, sizeof(void *));
     mem->free_data = ptr;
     DEBUG("memarray: Free %u Bytes at %p\n", (unsigned)mem->size, ptr);
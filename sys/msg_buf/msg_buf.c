@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "msg_buf.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *data, uint16_t size,
+                       size_t num)
+{
+    assert(pool != NULL);
+    memarray_init(&pool->mem, data, MSG_BUF_ELEM_SIZE(size), num);
+    pool->size = size;
+}
+
+msg_buf_t *msg_buf_alloc(msg_buf_pool_t *pool)
+{
+    msg_buf_t *buf;
+
+    assert(pool != NULL);
+    /* memarray is not thread-safe, but its operations are short */
+    unsigned state = irq_disable();
+    buf = memarray_alloc(&pool->mem);
+    irq_restore(state);
+    if (buf == NULL) {
+        DEBUG("msg_buf: pool %p exhausted\n", (void *)pool);
+        return NULL;
+    }
+    buf->pool = pool;
+    buf->size = pool->size;
+    buf->len = 0;
+    return buf;
+}
+
+void msg_buf_free(msg_buf_t *buf)
+{
+    msg_buf_pool_t *pool;
+
+    assert((buf != NULL) && (buf->pool != NULL));
+    pool = buf->pool;
+    unsigned state = irq_disable();
+    memarray_free(&pool->mem, buf);
+    irq_restore(state);
+}
+
+/** @} */
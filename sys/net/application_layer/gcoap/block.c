@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gcoap_block
+ * @{
+ *
+ * @file
+ * @brief       Block-wise transfers for gcoap
+ *
+ * A Block2 download is driven by the fetching thread: it sends the block
+ * requests and passes the blocks to the callback. The response handler in
+ * gcoap's thread only stores each block in its reorder slot and wakes up the
+ * fetching thread. Hence the request memo of a response is already released
+ * when the fetching thread sends the next request, and the callback runs on
+ * the stack of the fetching thread.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "net/gcoap_block.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* block size exponent of CONFIG_GCOAP_BLOCK_SIZE_MAX */
+#define BLOCK_SZX_MAX       (bitarithm_msb(CONFIG_GCOAP_BLOCK_SIZE_MAX) - 4)
+
+/* time to wait before another attempt to send when no request is in flight
+ * that would wake up the fetching thread */
+#define SEND_RETRY_DELAY    (10U * US_PER_MS)
+
+/* attempts to send before giving up when no request is in flight */
+#define SEND_RETRY_MAX      (100U)
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote);
+
+/* must be called with ctx->guard held */
+static int _send(gcoap_block2_t *ctx, uint32_t num)
+{
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    coap_block1_t block2 = { .blknum = num, .szx = ctx->szx };
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    if (gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET, ctx->path) < 0) {
+        return -ENOBUFS;
+    }
+    coap_hdr_set_type(pdu.hdr, COAP_TYPE_CON);
+    if (coap_opt_add_block2_control(&pdu, &block2) < 0) {
+        return -ENOBUFS;
+    }
+    len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+    if (len < 0) {
+        return -ENOBUFS;
+    }
+    if (gcoap_req_send(buf, len, &ctx->remote, _resp_handler, ctx) == 0) {
+        DEBUG("gcoap_block: unable to send request for block %" PRIu32 "\n",
+              num);
+        return -ENOMEM;
+    }
+    ctx->inflight++;
+    return 0;
+}
+
+/* must be called with ctx->guard held */
+static void _store_block(gcoap_block2_t *ctx, coap_pkt_t *pdu, uint32_t num)
+{
+    gcoap_block_slot_t *slot = &ctx->slots[num % CONFIG_GCOAP_BLOCK_WINDOW];
+    coap_block1_t block2;
+
+    if ((num < ctx->expected) || (num > ctx->last)) {
+        /* duplicate or beyond the end of the resource */
+        return;
+    }
+    slot->num = num;
+    /* an invalid block only ends the transfer once it is next in line, as
+     * the resource may turn out to end before it */
+    slot->state = -1;
+
+    if (coap_get_code_class(pdu) != COAP_CLASS_SUCCESS) {
+        DEBUG("gcoap_block: block %" PRIu32 " failed with %u\n", num,
+              coap_get_code(pdu));
+        return;
+    }
+    if (!coap_get_block2(pdu, &block2)) {
+        if (num != 0) {
+            return;
+        }
+        /* server sent the whole resource at once */
+        block2.blknum = 0;
+        block2.szx = ctx->szx;
+        block2.more = 0;
+    }
+    else if ((num == 0) && (block2.szx <= ctx->szx)) {
+        /* server may ask for smaller blocks in its first response */
+        ctx->szx = block2.szx;
+    }
+    if ((block2.blknum != num) || (block2.szx != ctx->szx)) {
+        return;
+    }
+    if (pdu->payload_len > CONFIG_GCOAP_BLOCK_SIZE_MAX) {
+        /* only a response without Block2 option can be larger */
+        ctx->res = -ENOBUFS;
+        return;
+    }
+    if (!block2.more) {
+        ctx->last = num;
+    }
+    memcpy(ctx->bufs[num % CONFIG_GCOAP_BLOCK_WINDOW], pdu->payload,
+           pdu->payload_len);
+    slot->len = pdu->payload_len;
+    slot->more = block2.more;
+    slot->state = 1;
+}
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote)
+{
+    (void)remote;
+    gcoap_block2_t *ctx = memo->context;
+    coap_block1_t block2;
+    coap_pkt_t req;
+
+    mutex_lock(&ctx->guard);
+    ctx->inflight--;
+    if (ctx->res == 0) {
+        if (memo->state != GCOAP_MEMO_RESP) {
+            ctx->res = -ETIMEDOUT;
+        }
+        /* a response need not carry a Block2 option, so take the number
+         * from the request */
+        else if ((coap_parse(&req, memo->msg.data.pdu_buf,
+                             memo->msg.data.pdu_len) < 0) ||
+                 !coap_get_block2(&req, &block2)) {
+            ctx->res = -EPROTO;
+        }
+        else {
+            _store_block(ctx, pdu, block2.blknum);
+        }
+    }
+    /* the fetching thread waits for the guard, so it cannot return before
+     * the guard is released; ctx may be gone right after that */
+    mutex_unlock(&ctx->lock);
+    mutex_unlock(&ctx->guard);
+}
+
+/* passes the blocks that are next in line to the callback; must be called
+ * with ctx->guard held */
+static void _deliver(gcoap_block2_t *ctx)
+{
+    while (ctx->res == 0) {
+        unsigned idx = ctx->expected % CONFIG_GCOAP_BLOCK_WINDOW;
+        gcoap_block_slot_t *slot = &ctx->slots[idx];
+        int failed;
+
+        if ((slot->state == 0) || (slot->num != ctx->expected)) {
+            return;
+        }
+        if (slot->state < 0) {
+            ctx->res = -EPROTO;
+            return;
+        }
+        /* the handler stores no other block in this slot until expected
+         * was advanced */
+        mutex_unlock(&ctx->guard);
+        failed = ctx->cb(ctx->arg, ctx->offset, ctx->bufs[idx], slot->len,
+                         slot->more);
+        mutex_lock(&ctx->guard);
+
+        slot->state = 0;
+        ctx->offset += slot->len;
+        ctx->expected++;
+        if (failed) {
+            ctx->res = -ECANCELED;
+        }
+        else if (!slot->more) {
+            ctx->res = 1;
+        }
+    }
+}
+
+int gcoap_block2_fetch(gcoap_block2_t *ctx, const sock_udp_ep_t *remote,
+                       const char *path, unsigned szx, gcoap_block_cb_t cb,
+                       void *arg)
+{
+    unsigned retries = 0;
+    int res;
+
+    mutex_init(&ctx->lock);
+    mutex_lock(&ctx->lock);
+    mutex_init(&ctx->guard);
+    memcpy(&ctx->remote, remote, sizeof(ctx->remote));
+    ctx->path = path;
+    ctx->cb = cb;
+    ctx->arg = arg;
+    ctx->offset = 0;
+    ctx->next = 0;
+    ctx->expected = 0;
+    ctx->last = UINT32_MAX;
+    ctx->szx = (szx > BLOCK_SZX_MAX) ? BLOCK_SZX_MAX : szx;
+    ctx->inflight = 0;
+    ctx->res = 0;
+    memset(ctx->slots, 0, sizeof(ctx->slots));
+
+    mutex_lock(&ctx->guard);
+    while (1) {
+        /* block 0 goes alone to learn the block size and whether there is
+         * more than one block */
+        unsigned window = (ctx->expected > 0) ? CONFIG_GCOAP_BLOCK_WINDOW : 1;
+        bool idle;
+
+        _deliver(ctx);
+        while ((ctx->res == 0) && (ctx->next <= ctx->last) &&
+               (ctx->next < ctx->expected + window)) {
+            res = _send(ctx, ctx->next);
+            if (res == -ENOMEM) {
+                /* the request memos are taken, try again later */
+                break;
+            }
+            if (res < 0) {
+                /* the request can't be built, trying again won't help */
+                ctx->res = res;
+                break;
+            }
+            ctx->next++;
+            retries = 0;
+        }
+        if ((ctx->inflight == 0) && (ctx->res != 0)) {
+            break;
+        }
+        idle = (ctx->inflight == 0);
+        mutex_unlock(&ctx->guard);
+
+        /* a response wakes us up; without any in flight, the request memos
+         * are taken by someone else, so try again later */
+        if (!idle) {
+            mutex_lock(&ctx->lock);
+        }
+        else if ((xtimer_mutex_lock_timeout(&ctx->lock, SEND_RETRY_DELAY) < 0) &&
+                 (++retries >= SEND_RETRY_MAX)) {
+            mutex_lock(&ctx->guard);
+            ctx->res = -ENOMEM;
+            break;
+        }
+        mutex_lock(&ctx->guard);
+    }
+    res = ctx->res;
+    mutex_unlock(&ctx->guard);
+
+    return (res > 0) ? 0 : res;
+}
+
+ssize_t gcoap_block1_sink_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                  void *ctx)
+{
+    gcoap_block1_sink_t *sink = ctx;
+    coap_block1_t block1;
+    unsigned code;
+    int blockwise = coap_get_block1(pdu, &block1);
+
+    if (!blockwise) {
+        block1.more = 0;
+    }
+    if (block1.offset == 0) {
+        /* a new upload */
+        sink->offset = 0;
+    }
+
+    if (block1.offset > sink->offset) {
+        DEBUG("gcoap_block: missing data before offset %u\n",
+              (unsigned)block1.offset);
+        code = COAP_CODE_REQUEST_ENTITY_INCOMPLETE;
+    }
+    else if (block1.offset < sink->offset) {
+        /* retransmission of a block already written; acknowledge again */
+        code = block1.more ? COAP_CODE_CONTINUE : COAP_CODE_CHANGED;
+    }
+    else if (sink->cb(sink->arg, block1.offset, pdu->payload,
+                      pdu->payload_len, block1.more)) {
+        code = COAP_CODE_INTERNAL_SERVER_ERROR;
+    }
+    else {
+        sink->offset += pdu->payload_len;
+        code = block1.more ? COAP_CODE_CONTINUE : COAP_CODE_CHANGED;
+    }
+
+    gcoap_resp_init(pdu, buf, len, code);
+    if (blockwise && (coap_get_code_class(pdu) == COAP_CLASS_SUCCESS)) {
+        coap_opt_add_block1_control(pdu, &block1);
+    }
+    return coap_opt_finish(pdu, COAP_OPT_FINISH_NONE);
+}
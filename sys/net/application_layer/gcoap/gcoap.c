@@ -60,6 +60,15 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
+static gcoap_request_memo_t *_alloc_req_memo(void);
+static void _link_req_memo(gcoap_request_memo_t *memo);
+static void _release_req_memo(gcoap_request_memo_t *memo);
+static uint8_t *_alloc_resend_buf(void);
+static sock_udp_ep_t *_add_observer(int slot, const sock_udp_ep_t *remote);
+static gcoap_observe_memo_t *_add_obs_memo(int slot, sock_udp_ep_t *observer);
+static void _remove_obs_memo(gcoap_observe_memo_t *memo, sock_udp_ep_t *remote);
+static void _link_obs_memo(gcoap_observe_memo_t *memo);
+static void _unlink_obs_memo(gcoap_observe_memo_t *memo);
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -91,6 +100,33 @@ typedef struct {
                                         /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
                                            the entry is available */
+#ifdef MODULE_GCOAP_HASH
+    gcoap_request_memo_t *req_buckets[CONFIG_GCOAP_HASH_BUCKETS];
+                                        /* Open requests by token and remote */
+    gcoap_request_memo_t *req_next[CONFIG_GCOAP_REQ_WAITING_MAX];
+                                        /* Next open request in the bucket, or
+                                           next unused one in req_free */
+    gcoap_request_memo_t *req_free;     /* Unused request memos */
+    unsigned resend_next;               /* Resend buffer to try first */
+    sock_udp_ep_t *obs_buckets[CONFIG_GCOAP_HASH_BUCKETS];
+                                        /* Observe clients by endpoint */
+    sock_udp_ep_t *obs_next[CONFIG_GCOAP_OBS_CLIENTS_MAX];
+                                        /* Next client in the bucket, or next
+                                           unused one in obs_free */
+    sock_udp_ep_t *obs_free;            /* Unused Observe clients */
+    uint16_t obs_memos_numof[CONFIG_GCOAP_OBS_CLIENTS_MAX];
+                                        /* Registrations of each client */
+    gcoap_observe_memo_t *memo_buckets[CONFIG_GCOAP_HASH_BUCKETS];
+                                        /* Registrations by client and token */
+    gcoap_observe_memo_t *memo_next[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+                                        /* Next registration in the bucket, or
+                                           next unused one in memo_free */
+    gcoap_observe_memo_t *memo_free;    /* Unused registrations */
+    gcoap_observe_memo_t *res_buckets[CONFIG_GCOAP_HASH_BUCKETS];
+                                        /* Registrations by resource */
+    gcoap_observe_memo_t *res_next[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+                                        /* Next registration in the bucket */
+#endif
 } gcoap_state_t;
 
 static gcoap_state_t _coap_state = {
@@ -197,7 +233,9 @@ empty_as_response:
         case COAP_CLASS_SUCCESS:
         case COAP_CLASS_CLIENT_FAILURE:
         case COAP_CLASS_SERVER_FAILURE:
+            mutex_lock(&_coap_state.lock);
             _find_req_memo(&memo, &pdu, &remote);
+            mutex_unlock(&_coap_state.lock);
             if (memo) {
                 switch (coap_get_type(&pdu)) {
                 case COAP_TYPE_NON:
@@ -210,10 +248,9 @@ empty_as_response:
                         memo->resp_handler(memo, &pdu, &remote);
                     }
 
-                    if (memo->send_limit >= 0) {        /* if confirmable */
-                        *memo->msg.data.pdu_buf = 0;    /* clear resend PDU buffer */
-                    }
-                    memo->state = GCOAP_MEMO_UNUSED;
+                    mutex_lock(&_coap_state.lock);
+                    _release_req_memo(memo);
+                    mutex_unlock(&_coap_state.lock);
                     break;
                 case COAP_TYPE_CON:
                     DEBUG("gcoap: separate CON response not handled yet\n");
@@ -319,15 +356,13 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                 /* cache new observer */
                 if (observer == NULL) {
                     if (obs_slot >= 0) {
-                        observer = &_coap_state.observers[obs_slot];
-                        memcpy(observer, remote, sizeof(sock_udp_ep_t));
+                        observer = _add_observer(obs_slot, remote);
                     } else {
                         DEBUG("gcoap: can't register observer\n");
                     }
                 }
                 if (observer != NULL) {
-                    memo = &_coap_state.observe_memos[empty_slot];
-                    memo->observer = observer;
+                    memo = _add_obs_memo(empty_slot, observer);
                 }
             }
             if (memo == NULL) {
@@ -338,11 +373,13 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* finish registration */
         if (memo != NULL) {
             /* resource may be assigned here if it is not already registered */
+            _unlink_obs_memo(memo);
             memo->resource = resource;
             memo->token_len = coap_get_token_len(pdu);
             if (memo->token_len) {
                 memcpy(&memo->token[0], pdu->token, memo->token_len);
             }
+            _link_obs_memo(memo);
             DEBUG("gcoap: Registered observer for: %s\n", memo->resource->path);
         }
 
@@ -351,15 +388,7 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
-            memo->observer = NULL;
-            memo           = NULL;
-            _find_obs_memo(&memo, remote, NULL);
-            if (memo == NULL) {
-                _find_observer(&observer, remote);
-                if (observer != NULL) {
-                    observer->family = AF_UNSPEC;
-                }
-            }
+            _remove_obs_memo(memo, remote);
         }
         coap_clear_observe(pdu);
 
@@ -402,40 +431,416 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     }
 
     while (listener) {
-        const coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
+        const coap_resource_t *resource;
+        int res = coap_find_resource(listener->resources,
+                                     listener->resources_len, uri,
+                                     method_flag, &resource);
+        if (res == 0) {
+            *resource_ptr = resource;
+            *listener_ptr = listener;
+            return GCOAP_RESOURCE_FOUND;
+        }
+        else if (res == -ENOTSUP) {
+            ret = GCOAP_RESOURCE_WRONG_METHOD;
+        }
+        listener = listener->next;
+    }
 
-            int res = coap_match_path(resource, uri);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
-            }
-            else {
-                if (! (resource->methods & method_flag)) {
-                    ret = GCOAP_RESOURCE_WRONG_METHOD;
-                    continue;
-                }
+    return ret;
+}
+
+/*
+ * Gets the header of the request PDU a memo was created for.
+ */
+static coap_hdr_t *_memo_hdr(const gcoap_request_memo_t *memo)
+{
+    if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+        return (coap_hdr_t *)&memo->msg.hdr_buf[0];
+    }
+    else {
+        return (coap_hdr_t *)memo->msg.data.pdu_buf;
+    }
+}
+
+#ifdef MODULE_GCOAP_HASH
+/*
+ * Hashes data onto an initial hash value.
+ */
+static uint32_t _hash(uint32_t hash, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash * 31) + data[i];
+    }
+    return hash;
+}
+
+/*
+ * Hashes the port and the part of the address of an endpoint that is most
+ * likely to differ between remotes.
+ */
+static uint32_t _hash_ep(const sock_udp_ep_t *ep)
+{
+    const uint8_t *addr = ep->addr.ipv4;
+
+#ifdef SOCK_HAS_IPV6
+    if (ep->family == AF_INET6) {
+        /* hosts of a prefix differ in the interface identifier */
+        addr = &ep->addr.ipv6[12];
+    }
+#endif
+    return _hash(ep->port, addr, 4);
+}
+
+static unsigned _req_bucket(const uint8_t *token, unsigned token_len,
+                            const sock_udp_ep_t *remote)
+{
+    return _hash(_hash_ep(remote), token, token_len) % CONFIG_GCOAP_HASH_BUCKETS;
+}
+
+static unsigned _obs_bucket(const sock_udp_ep_t *remote)
+{
+    return _hash_ep(remote) % CONFIG_GCOAP_HASH_BUCKETS;
+}
+
+static unsigned _memo_bucket(const sock_udp_ep_t *observer,
+                             const uint8_t *token, unsigned token_len)
+{
+    return _hash(observer - _coap_state.observers, token, token_len)
+           % CONFIG_GCOAP_HASH_BUCKETS;
+}
+
+static unsigned _res_bucket(const coap_resource_t *resource)
+{
+    return ((uintptr_t)resource / sizeof(coap_resource_t))
+           % CONFIG_GCOAP_HASH_BUCKETS;
+}
+
+#define _REQ_NEXT(memo)     (_coap_state.req_next[(memo) - _coap_state.open_reqs])
+#define _OBS_NEXT(obs)      (_coap_state.obs_next[(obs) - _coap_state.observers])
+#define _MEMO_NEXT(memo)    (_coap_state.memo_next[(memo) - _coap_state.observe_memos])
+#define _RES_NEXT(memo)     (_coap_state.res_next[(memo) - _coap_state.observe_memos])
+
+/*
+ * Puts all request memos, Observe clients and Observe registrations on their
+ * lists of unused entries, in ascending order.
+ */
+static void _init_hash(void)
+{
+    memset(_coap_state.req_buckets, 0, sizeof(_coap_state.req_buckets));
+    memset(_coap_state.obs_buckets, 0, sizeof(_coap_state.obs_buckets));
+    memset(_coap_state.memo_buckets, 0, sizeof(_coap_state.memo_buckets));
+    memset(_coap_state.res_buckets, 0, sizeof(_coap_state.res_buckets));
+    memset(_coap_state.obs_memos_numof, 0, sizeof(_coap_state.obs_memos_numof));
+    _coap_state.req_free = NULL;
+    for (int i = CONFIG_GCOAP_REQ_WAITING_MAX - 1; i >= 0; i--) {
+        _coap_state.req_next[i] = _coap_state.req_free;
+        _coap_state.req_free = &_coap_state.open_reqs[i];
+    }
+    _coap_state.obs_free = NULL;
+    for (int i = CONFIG_GCOAP_OBS_CLIENTS_MAX - 1; i >= 0; i--) {
+        _coap_state.obs_next[i] = _coap_state.obs_free;
+        _coap_state.obs_free = &_coap_state.observers[i];
+    }
+    _coap_state.memo_free = NULL;
+    for (int i = CONFIG_GCOAP_OBS_REGISTRATIONS_MAX - 1; i >= 0; i--) {
+        _coap_state.memo_next[i] = _coap_state.memo_free;
+        _coap_state.memo_free = &_coap_state.observe_memos[i];
+    }
+    _coap_state.resend_next = 0;
+}
+
+/*
+ * Finds the memo for an outstanding request in the bucket of its remote
+ * endpoint and token. Must be called with _coap_state.lock held.
+ *
+ * memo_ptr[out] -- Registered request memo, or NULL if not found
+ * src_pdu[in] -- PDU for token to match
+ * remote[in] -- Remote endpoint to match
+ */
+static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
+                           const sock_udp_ep_t *remote)
+{
+    unsigned cmplen = coap_get_token_len(src_pdu);
+    gcoap_request_memo_t *memo;
+
+    memo = _coap_state.req_buckets[_req_bucket(src_pdu->token, cmplen, remote)];
+    for (; memo != NULL; memo = _REQ_NEXT(memo)) {
+        coap_hdr_t *hdr = _memo_hdr(memo);
+
+        if (((hdr->ver_t_tkl & 0xf) == cmplen)
+                && (memcmp(src_pdu->token, coap_hdr_data_ptr(hdr), cmplen) == 0)
+                && sock_udp_ep_equal(&memo->remote_ep, remote)) {
+            break;
+        }
+    }
+    *memo_ptr = memo;
+}
 
-                *resource_ptr = resource;
-                *listener_ptr = listener;
-                return GCOAP_RESOURCE_FOUND;
+/*
+ * Takes a request memo from the unused ones. Must be called with
+ * _coap_state.lock held.
+ */
+static gcoap_request_memo_t *_alloc_req_memo(void)
+{
+    gcoap_request_memo_t *memo = _coap_state.req_free;
+
+    if (memo != NULL) {
+        _coap_state.req_free = _REQ_NEXT(memo);
+        memo->state = GCOAP_MEMO_WAIT;
+    }
+    return memo;
+}
+
+/*
+ * Appends a request memo to the bucket of its remote endpoint and token, once
+ * the request is copied to it, so that responses to requests reusing a token
+ * are matched in the order the requests were sent. Must be called with
+ * _coap_state.lock held.
+ */
+static void _link_req_memo(gcoap_request_memo_t *memo)
+{
+    coap_hdr_t *hdr = _memo_hdr(memo);
+    gcoap_request_memo_t **prev;
+
+    prev = &_coap_state.req_buckets[_req_bucket(coap_hdr_data_ptr(hdr),
+                                                hdr->ver_t_tkl & 0xf,
+                                                &memo->remote_ep)];
+    while (*prev != NULL) {
+        prev = &_REQ_NEXT(*prev);
+    }
+    _REQ_NEXT(memo) = NULL;
+    *prev = memo;
+}
+
+/*
+ * Returns a request memo to the unused ones, removing it from its bucket if it
+ * was linked. Must be called with _coap_state.lock held.
+ */
+static void _free_req_memo(gcoap_request_memo_t *memo, bool linked)
+{
+    if (linked) {
+        coap_hdr_t *hdr = _memo_hdr(memo);
+        gcoap_request_memo_t **prev;
+
+        prev = &_coap_state.req_buckets[_req_bucket(coap_hdr_data_ptr(hdr),
+                                                    hdr->ver_t_tkl & 0xf,
+                                                    &memo->remote_ep)];
+        while (*prev != memo) {
+            prev = &_REQ_NEXT(*prev);
+        }
+        *prev = _REQ_NEXT(memo);
+    }
+    _REQ_NEXT(memo) = _coap_state.req_free;
+    _coap_state.req_free = memo;
+    memo->state = GCOAP_MEMO_UNUSED;
+}
+
+/*
+ * Takes an unused resend buffer, starting after the one taken last. Must be
+ * called with _coap_state.lock held.
+ */
+static uint8_t *_alloc_resend_buf(void)
+{
+    unsigned i = _coap_state.resend_next;
+
+    for (unsigned n = 0; n < CONFIG_GCOAP_RESEND_BUFS_MAX; n++) {
+        if (!_coap_state.resend_bufs[i][0]) {
+            _coap_state.resend_next = (i + 1) % CONFIG_GCOAP_RESEND_BUFS_MAX;
+            return &_coap_state.resend_bufs[i][0];
+        }
+        i = (i + 1) % CONFIG_GCOAP_RESEND_BUFS_MAX;
+    }
+    return NULL;
+}
+
+/*
+ * Find registered observer for a remote address and port in its bucket.
+ *
+ * observer[out] -- Registered observer, or NULL if not found
+ * remote[in] -- Endpoint to match
+ *
+ * return Index of empty slot, suitable for registering new observer; or -1
+ *        if no empty slots. Undefined if observer found.
+ */
+static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
+{
+    sock_udp_ep_t *obs = _coap_state.obs_buckets[_obs_bucket(remote)];
+
+    while ((obs != NULL) && !sock_udp_ep_equal(obs, remote)) {
+        obs = _OBS_NEXT(obs);
+    }
+    *observer = obs;
+    if (_coap_state.obs_free == NULL) {
+        return -1;
+    }
+    return _coap_state.obs_free - _coap_state.observers;
+}
+
+/*
+ * Takes the unused observer at slot, as returned by _find_observer(), for a
+ * remote.
+ */
+static sock_udp_ep_t *_add_observer(int slot, const sock_udp_ep_t *remote)
+{
+    sock_udp_ep_t *observer = &_coap_state.observers[slot];
+    unsigned bucket = _obs_bucket(remote);
+
+    assert(observer == _coap_state.obs_free);
+    _coap_state.obs_free = _OBS_NEXT(observer);
+    memcpy(observer, remote, sizeof(sock_udp_ep_t));
+    _OBS_NEXT(observer) = _coap_state.obs_buckets[bucket];
+    _coap_state.obs_buckets[bucket] = observer;
+    return observer;
+}
+
+/*
+ * Find registered observe memo for a remote address and token in its bucket.
+ *
+ * memo[out] -- Registered observe memo, or NULL if not found
+ * remote[in] -- Endpoint for address to match
+ * pdu[in] -- PDU for token to match
+ *
+ * return Index of empty slot, suitable for registering new memo; or -1 if no
+ *        empty slots. Undefined if memo found.
+ */
+static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
+                                                       coap_pkt_t *pdu)
+{
+    sock_udp_ep_t *remote_observer = NULL;
+    unsigned cmplen = coap_get_token_len(pdu);
+
+    *memo = NULL;
+    _find_observer(&remote_observer, remote);
+    if ((remote_observer != NULL) && cmplen) {
+        gcoap_observe_memo_t *obs_memo;
+
+        obs_memo = _coap_state.memo_buckets[_memo_bucket(remote_observer,
+                                                         pdu->token, cmplen)];
+        for (; obs_memo != NULL; obs_memo = _MEMO_NEXT(obs_memo)) {
+            if ((obs_memo->observer == remote_observer)
+                    && (obs_memo->token_len == cmplen)
+                    && (memcmp(&obs_memo->token[0], &pdu->token[0],
+                               cmplen) == 0)) {
+                *memo = obs_memo;
+                break;
             }
         }
-        listener = listener->next;
     }
+    if (_coap_state.memo_free == NULL) {
+        return -1;
+    }
+    return _coap_state.memo_free - _coap_state.observe_memos;
+}
 
-    return ret;
+/*
+ * Takes the unused observe memo at slot, as returned by _find_obs_memo(), for
+ * an observer. The memo is linked by _link_obs_memo() once its resource and
+ * token are set.
+ */
+static gcoap_observe_memo_t *_add_obs_memo(int slot, sock_udp_ep_t *observer)
+{
+    gcoap_observe_memo_t *memo = &_coap_state.observe_memos[slot];
+
+    assert(memo == _coap_state.memo_free);
+    _coap_state.memo_free = _MEMO_NEXT(memo);
+    _MEMO_NEXT(memo) = NULL;
+    _RES_NEXT(memo) = NULL;
+    memo->observer = observer;
+    memo->resource = NULL;
+    memo->token_len = 0;
+    _coap_state.obs_memos_numof[observer - _coap_state.observers]++;
+    return memo;
+}
+
+/*
+ * Adds an observe memo to the buckets of its observer and token and of its
+ * resource.
+ */
+static void _link_obs_memo(gcoap_observe_memo_t *memo)
+{
+    unsigned bucket = _memo_bucket(memo->observer, memo->token,
+                                   memo->token_len);
+
+    _MEMO_NEXT(memo) = _coap_state.memo_buckets[bucket];
+    _coap_state.memo_buckets[bucket] = memo;
+    bucket = _res_bucket(memo->resource);
+    _RES_NEXT(memo) = _coap_state.res_buckets[bucket];
+    _coap_state.res_buckets[bucket] = memo;
 }
 
+/*
+ * Removes an observe memo from its buckets, if it is linked.
+ */
+static void _unlink_obs_memo(gcoap_observe_memo_t *memo)
+{
+    gcoap_observe_memo_t **prev;
+
+    if (memo->resource == NULL) {
+        /* taken by _add_obs_memo() but not linked yet */
+        return;
+    }
+    prev = &_coap_state.memo_buckets[_memo_bucket(memo->observer, memo->token,
+                                                  memo->token_len)];
+    while (*prev != memo) {
+        prev = &_MEMO_NEXT(*prev);
+    }
+    *prev = _MEMO_NEXT(memo);
+    prev = &_coap_state.res_buckets[_res_bucket(memo->resource)];
+    while (*prev != memo) {
+        prev = &_RES_NEXT(*prev);
+    }
+    *prev = _RES_NEXT(memo);
+}
+
+/*
+ * Returns an observe memo to the unused ones, and its observer as well if it
+ * has no registrations left.
+ */
+static void _remove_obs_memo(gcoap_observe_memo_t *memo, sock_udp_ep_t *remote)
+{
+    sock_udp_ep_t *observer = memo->observer;
+    sock_udp_ep_t **prev;
+
+    (void)remote;
+    _unlink_obs_memo(memo);
+    memo->observer = NULL;
+    _MEMO_NEXT(memo) = _coap_state.memo_free;
+    _coap_state.memo_free = memo;
+    if (--_coap_state.obs_memos_numof[observer - _coap_state.observers] > 0) {
+        return;
+    }
+    prev = &_coap_state.obs_buckets[_obs_bucket(observer)];
+    while (*prev != observer) {
+        prev = &_OBS_NEXT(*prev);
+    }
+    *prev = _OBS_NEXT(observer);
+    observer->family = AF_UNSPEC;
+    _OBS_NEXT(observer) = _coap_state.obs_free;
+    _coap_state.obs_free = observer;
+}
+
+/*
+ * Find registered observe memo for a resource in its bucket.
+ *
+ * memo[out] -- Registered observe memo, or NULL if not found
+ * resource[in] -- Resource to match
+ */
+static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
+                                   const coap_resource_t *resource)
+{
+    gcoap_observe_memo_t *obs_memo = _coap_state.res_buckets[_res_bucket(resource)];
+
+    while ((obs_memo != NULL) && (obs_memo->resource != resource)) {
+        obs_memo = _RES_NEXT(obs_memo);
+    }
+    *memo = obs_memo;
+}
+
+#else /* MODULE_GCOAP_HASH */
 /*
  * Finds the memo for an outstanding request within the _coap_state.open_reqs
- * array. Matches on remote endpoint and token.
+ * array. Matches on remote endpoint and token. Must be called with
+ * _coap_state.lock held.
  *
  * memo_ptr[out] -- Registered request memo, or NULL if not found
  * src_pdu[in] -- PDU for token to match
@@ -456,12 +861,7 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
         }
 
         gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
-        if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-            memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
-        }
-        else {
-            memo_pdu->hdr = (coap_hdr_t *) memo->msg.data.pdu_buf;
-        }
+        memo_pdu->hdr = _memo_hdr(memo);
 
         if (coap_get_token_len(memo_pdu) == cmplen) {
             memo_pdu->token = coap_hdr_data_ptr(memo_pdu->hdr);
@@ -474,50 +874,42 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     }
 }
 
-/* Calls handler callback on receipt of a timeout message. */
-static void _expire_request(gcoap_request_memo_t *memo)
+/*
+ * Takes an unused request memo. Must be called with _coap_state.lock held.
+ */
+static gcoap_request_memo_t *_alloc_req_memo(void)
 {
-    DEBUG("coap: received timeout message\n");
-    if (memo->state == GCOAP_MEMO_WAIT) {
-        memo->state = GCOAP_MEMO_TIMEOUT;
-        /* Pass response to handler */
-        if (memo->resp_handler) {
-            coap_pkt_t req;
-            if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-                req.hdr = (coap_hdr_t *)&memo->msg.hdr_buf[0];   /* for reference */
-            }
-            else {
-                req.hdr = (coap_hdr_t *)memo->msg.data.pdu_buf;
-            }
-            memo->resp_handler(memo, &req, NULL);
-        }
-        if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
-            *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
+    for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
+        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
+            _coap_state.open_reqs[i].state = GCOAP_MEMO_WAIT;
+            return &_coap_state.open_reqs[i];
         }
-        memo->state = GCOAP_MEMO_UNUSED;
-    }
-    else {
-        /* Response already handled; timeout must have fired while response */
-        /* was in queue. */
     }
+    return NULL;
 }
 
-/*
- * Handler for /.well-known/core. Lists registered handlers, except for
- * /.well-known/core itself.
- */
-static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len,
-                                        void *ctx)
+static void _link_req_memo(gcoap_request_memo_t *memo)
 {
-    (void)ctx;
+    (void)memo;
+}
 
-    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
-    coap_opt_add_format(pdu, COAP_FORMAT_LINK);
-    ssize_t plen = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+static void _free_req_memo(gcoap_request_memo_t *memo, bool linked)
+{
+    (void)linked;
+    memo->state = GCOAP_MEMO_UNUSED;
+}
 
-    plen += gcoap_get_resource_list(pdu->payload, (size_t)pdu->payload_len,
-                                    COAP_FORMAT_LINK);
-    return plen;
+/*
+ * Takes an unused resend buffer. Must be called with _coap_state.lock held.
+ */
+static uint8_t *_alloc_resend_buf(void)
+{
+    for (int i = 0; i < CONFIG_GCOAP_RESEND_BUFS_MAX; i++) {
+        if (!_coap_state.resend_bufs[i][0]) {
+            return &_coap_state.resend_bufs[i][0];
+        }
+    }
+    return NULL;
 }
 
 /*
@@ -546,6 +938,18 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
     return empty_slot;
 }
 
+/*
+ * Takes the unused observer at slot, as returned by _find_observer(), for a
+ * remote.
+ */
+static sock_udp_ep_t *_add_observer(int slot, const sock_udp_ep_t *remote)
+{
+    sock_udp_ep_t *observer = &_coap_state.observers[slot];
+
+    memcpy(observer, remote, sizeof(sock_udp_ep_t));
+    return observer;
+}
+
 /*
  * Find registered observe memo for a remote address and token.
  *
@@ -591,6 +995,47 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
     return empty_slot;
 }
 
+/*
+ * Takes the unused observe memo at slot, as returned by _find_obs_memo(), for
+ * an observer.
+ */
+static gcoap_observe_memo_t *_add_obs_memo(int slot, sock_udp_ep_t *observer)
+{
+    gcoap_observe_memo_t *memo = &_coap_state.observe_memos[slot];
+
+    memo->observer = observer;
+    return memo;
+}
+
+static void _link_obs_memo(gcoap_observe_memo_t *memo)
+{
+    (void)memo;
+}
+
+static void _unlink_obs_memo(gcoap_observe_memo_t *memo)
+{
+    (void)memo;
+}
+
+/*
+ * Returns an observe memo to the unused ones, and its observer as well if it
+ * has no registrations left.
+ */
+static void _remove_obs_memo(gcoap_observe_memo_t *memo, sock_udp_ep_t *remote)
+{
+    sock_udp_ep_t *observer = NULL;
+
+    memo->observer = NULL;
+    memo           = NULL;
+    _find_obs_memo(&memo, remote, NULL);
+    if (memo == NULL) {
+        _find_observer(&observer, remote);
+        if (observer != NULL) {
+            observer->family = AF_UNSPEC;
+        }
+    }
+}
+
 /*
  * Find registered observe memo for a resource.
  *
@@ -609,6 +1054,60 @@ static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
         }
     }
 }
+#endif /* MODULE_GCOAP_HASH */
+
+/*
+ * Returns the memo of a sent request to the unused ones and clears its resend
+ * buffer. Must be called with _coap_state.lock held.
+ */
+static void _release_req_memo(gcoap_request_memo_t *memo)
+{
+    /* the bucket is found by the token in the resend buffer, so clear later */
+    _free_req_memo(memo, true);
+    if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
+        *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
+    }
+}
+
+/* Calls handler callback on receipt of a timeout message. */
+static void _expire_request(gcoap_request_memo_t *memo)
+{
+    DEBUG("coap: received timeout message\n");
+    if (memo->state == GCOAP_MEMO_WAIT) {
+        memo->state = GCOAP_MEMO_TIMEOUT;
+        /* Pass response to handler */
+        if (memo->resp_handler) {
+            coap_pkt_t req;
+            req.hdr = _memo_hdr(memo);      /* for reference */
+            memo->resp_handler(memo, &req, NULL);
+        }
+        mutex_lock(&_coap_state.lock);
+        _release_req_memo(memo);
+        mutex_unlock(&_coap_state.lock);
+    }
+    else {
+        /* Response already handled; timeout must have fired while response */
+        /* was in queue. */
+    }
+}
+
+/*
+ * Handler for /.well-known/core. Lists registered handlers, except for
+ * /.well-known/core itself.
+ */
+static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len,
+                                        void *ctx)
+{
+    (void)ctx;
+
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    coap_opt_add_format(pdu, COAP_FORMAT_LINK);
+    ssize_t plen = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    plen += gcoap_get_resource_list(pdu->payload, (size_t)pdu->payload_len,
+                                    COAP_FORMAT_LINK);
+    return plen;
+}
 
 /*
  * gcoap interface functions
@@ -628,6 +1127,9 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
+#ifdef MODULE_GCOAP_HASH
+    _init_hash();
+#endif
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
 
@@ -636,6 +1138,13 @@ kernel_pid_t gcoap_init(void)
 
 void gcoap_register_listener(gcoap_listener_t *listener)
 {
+#ifdef DEVELHELP
+    /* resources are looked up with a binary search by path */
+    for (size_t i = 1; i < listener->resources_len; i++) {
+        assert(strcmp(listener->resources[i - 1].path,
+                      listener->resources[i].path) <= 0);
+    }
+#endif
     if (!listener->link_encoder) {
         listener->link_encoder = gcoap_encode_link;
     }
@@ -697,13 +1206,7 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
     if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
         mutex_lock(&_coap_state.lock);
         /* Find empty slot in list of open requests. */
-        for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
-            if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-                memo = &_coap_state.open_reqs[i];
-                memo->state = GCOAP_MEMO_WAIT;
-                break;
-            }
-        }
+        memo = _alloc_req_memo();
         if (!memo) {
             mutex_unlock(&_coap_state.lock);
             DEBUG("gcoap: dropping request; no space for response tracking\n");
@@ -717,17 +1220,10 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
         switch (msg_type) {
         case COAP_TYPE_CON:
             /* copy buf to resend_bufs record */
-            memo->msg.data.pdu_buf = NULL;
-            for (int i = 0; i < CONFIG_GCOAP_RESEND_BUFS_MAX; i++) {
-                if (!_coap_state.resend_bufs[i][0]) {
-                    memo->msg.data.pdu_buf = &_coap_state.resend_bufs[i][0];
-                    memcpy(memo->msg.data.pdu_buf, buf,
-                           CONFIG_GCOAP_PDU_BUF_SIZE);
-                    memo->msg.data.pdu_len = len;
-                    break;
-                }
-            }
+            memo->msg.data.pdu_buf = _alloc_resend_buf();
             if (memo->msg.data.pdu_buf) {
+                memcpy(memo->msg.data.pdu_buf, buf, CONFIG_GCOAP_PDU_BUF_SIZE);
+                memo->msg.data.pdu_len = len;
                 memo->send_limit  = CONFIG_COAP_MAX_RETRANSMIT;
                 timeout           = (uint32_t)CONFIG_COAP_ACK_TIMEOUT * US_PER_SEC;
 #if CONFIG_COAP_RANDOM_FACTOR_1000 > 1000
@@ -735,7 +1231,7 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
 #endif
             }
             else {
-                memo->state = GCOAP_MEMO_UNUSED;
+                _free_req_memo(memo, false);
                 DEBUG("gcoap: no space for PDU in resend bufs\n");
             }
             break;
@@ -746,14 +1242,17 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
             timeout = CONFIG_GCOAP_NON_TIMEOUT;
             break;
         default:
-            memo->state = GCOAP_MEMO_UNUSED;
+            _free_req_memo(memo, false);
             DEBUG("gcoap: illegal msg type %u\n", msg_type);
             break;
         }
-        mutex_unlock(&_coap_state.lock);
         if (memo->state == GCOAP_MEMO_UNUSED) {
+            /* memo may be taken by another thread as soon as we unlock */
+            mutex_unlock(&_coap_state.lock);
             return 0;
         }
+        _link_req_memo(memo);
+        mutex_unlock(&_coap_state.lock);
     }
 
     /* set response timeout; may be zero for non-confirmable */
@@ -772,13 +1271,12 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
     ssize_t res = sock_udp_send(&_sock, buf, len, remote);
     if (res <= 0) {
         if (memo != NULL) {
-            if (msg_type == COAP_TYPE_CON) {
-                *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-            }
             if (timeout > 0) {
                 event_timeout_clear(&memo->resp_evt_tmout);
             }
-            memo->state = GCOAP_MEMO_UNUSED;
+            mutex_lock(&_coap_state.lock);
+            _release_req_memo(memo);
+            mutex_unlock(&_coap_state.lock);
         }
         DEBUG("gcoap: sock send failed: %d\n", (int)res);
     }
@@ -96,6 +96,10 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     unsigned option_count = 0;
     unsigned option_nr = 0;
 
+#ifdef MODULE_GCOAP
+    pkt->observe_value = UINT32_MAX;
+#endif
+
     /* parse options */
     while (pkt_pos < pkt_end) {
         uint8_t *option_start = pkt_pos;
@@ -133,6 +137,14 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
                 option_count++;
             }
 
+#ifdef MODULE_GCOAP
+            /* decode Observe right away instead of looking it up again */
+            if (option_delta && (option_nr == COAP_OPT_OBSERVE) &&
+                (option_len <= 4) && (pkt_pos + option_len <= pkt_end)) {
+                pkt->observe_value = _decode_uint(pkt_pos, option_len);
+            }
+#endif
+
             pkt_pos += option_len;
         }
     }
@@ -147,12 +159,6 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
         pkt->payload = pkt_pos;
     }
 
-#ifdef MODULE_GCOAP
-    if (coap_opt_get_uint(pkt, COAP_OPT_OBSERVE, &pkt->observe_value) != 0) {
-        pkt->observe_value = UINT32_MAX;
-    }
-#endif
-
     DEBUG("coap pkt parsed. code=%u detail=%u payload_len=%u, nopts=%u, 0x%02x\n",
           coap_get_code_class(pkt),
           coap_get_code_detail(pkt),
@@ -176,6 +182,87 @@ int coap_match_path(const coap_resource_t *resource, uint8_t *uri)
     return res;
 }
 
+/* Returns the first index in [lo, hi) whose path has a character greater than
+ * (or with upper set, greater or equal to) c at pos. All paths in the range
+ * must be longer than pos. */
+static size_t _path_bound(const coap_resource_t *resources, size_t lo,
+                          size_t hi, size_t pos, uint8_t c, bool upper)
+{
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uint8_t mid_c = (uint8_t)resources[mid].path[pos];
+
+        if ((mid_c < c) || (upper && (mid_c == c))) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int coap_find_resource(const coap_resource_t *resources, size_t resources_numof,
+                       const uint8_t *uri, coap_method_flags_t method_flag,
+                       const coap_resource_t **resource)
+{
+    assert(resources || !resources_numof);
+    assert(uri && resource);
+    size_t lo = 0, hi = resources_numof;
+    int res = -ENOENT;
+
+    /* [lo, hi) are the resources starting with the first pos characters of
+     * the URI */
+    for (size_t pos = 0; lo < hi; pos++) {
+        uint8_t c = uri[pos];
+
+        if (hi - lo == 1) {
+            /* a single candidate is left, compare the rest at once */
+            const coap_resource_t *r = &resources[lo];
+            const char *path = r->path + pos;
+            int cmp = (r->methods & COAP_MATCH_SUBTREE)
+                    ? strncmp((const char *)uri + pos, path, strlen(path))
+                    : strcmp((const char *)uri + pos, path);
+
+            if (cmp != 0) {
+                break;
+            }
+            if (r->methods & method_flag) {
+                *resource = r;
+                return 0;
+            }
+            return -ENOTSUP;
+        }
+
+        /* paths of exactly pos characters sort first, they are the full URI
+         * or a prefix of it, shorter prefixes were visited before */
+        for (; (lo < hi) && (resources[lo].path[pos] == '\0'); lo++) {
+            const coap_resource_t *r = &resources[lo];
+
+            if ((c != '\0') && !(r->methods & COAP_MATCH_SUBTREE)) {
+                continue;
+            }
+            if (r->methods & method_flag) {
+                *resource = r;
+                return 0;
+            }
+            res = -ENOTSUP;
+        }
+        if ((c == '\0') || (lo == hi)) {
+            break;
+        }
+        /* narrow down to the paths continuing with c, unless all of them do,
+         * as within a common prefix */
+        if ((uint8_t)resources[lo].path[pos] != c) {
+            lo = _path_bound(resources, lo, hi, pos, c, false);
+        }
+        if ((lo < hi) && ((uint8_t)resources[hi - 1].path[pos] != c)) {
+            hi = _path_bound(resources, lo, hi, pos, c, true);
+        }
+    }
+    return res;
+}
+
 uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
 {
     const coap_optpos_t *optpos = pkt->options;
@@ -361,30 +448,19 @@ ssize_t coap_opt_get_string(const coap_pkt_t *pkt, uint16_t optnum,
 
 int coap_get_blockopt(coap_pkt_t *pkt, uint16_t option, uint32_t *blknum, unsigned *szx)
 {
-    uint8_t *optpos = coap_find_option(pkt, option);
-    if (!optpos) {
+    uint32_t blkopt;
+    int res = coap_opt_get_uint(pkt, option, &blkopt);
+
+    if (res == -ENOENT) {
         *blknum = 0;
         *szx = 0;
         return -1;
     }
-
-    int option_len;
-    uint16_t delta;
-
-    uint8_t *data_start = _parse_option(pkt, optpos, &delta, &option_len);
-    if (!data_start) {
-        DEBUG("nanocoap: invalid start data\n");
-        return -1;
-    }
-
-    if (option_len > 4) {
-        DEBUG("nanocoap: invalid option length\n");
+    else if (res < 0) {
+        DEBUG("nanocoap: invalid block option\n");
         return -1;
     }
 
-    uint32_t blkopt = _decode_uint(data_start, option_len);
-
-    DEBUG("nanocoap: blkopt len: %i\n", option_len);
     DEBUG("nanocoap: blkopt: 0x%08x\n", (unsigned)blkopt);
     *blknum = blkopt >> COAP_BLOCKWISE_NUM_OFF;
     *szx = blkopt & COAP_BLOCKWISE_SZX_MASK;
@@ -419,22 +495,10 @@ ssize_t coap_tree_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
     }
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
-    for (unsigned i = 0; i < resources_numof; i++) {
-        const coap_resource_t *resource = &resources[i];
-        if (!(resource->methods & method_flag)) {
-            continue;
-        }
-
-        int res = coap_match_path(resource, uri);
-        if (res > 0) {
-            continue;
-        }
-        else if (res < 0) {
-            break;
-        }
-        else {
-            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
-        }
+    const coap_resource_t *resource;
+    if (coap_find_resource(resources, resources_numof, uri, method_flag,
+                           &resource) == 0) {
+        return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
     }
 
     return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
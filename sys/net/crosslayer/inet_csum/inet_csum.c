@@ -14,15 +14,94 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* Sums up 16 byte blocks of 32 bit words. As 2^16 = 1 in one's complement
+ * arithmetic modulo 0xffff, the sum of 32 bit words is the sum of their 16 bit
+ * halves, so the carries only need to be folded once in the end. */
+#if defined(__thumb2__)
+static inline uint64_t _sum_blocks(const uint32_t *w, size_t blocks,
+                                   uint64_t acc)
+{
+    uint32_t sum = 0;
+
+    /* ARMv7-M and newer mainline cores add with carry in a single cycle, so
+     * add the carry back in after each block */
+    while (blocks--) {
+        __asm__ ("adds  %[sum], %[sum], %[a]\n"
+                 "adcs  %[sum], %[sum], %[b]\n"
+                 "adcs  %[sum], %[sum], %[c]\n"
+                 "adcs  %[sum], %[sum], %[d]\n"
+                 "adc   %[sum], %[sum], #0\n"
+                 : [sum] "+r" (sum)
+                 : [a] "r" (w[0]), [b] "r" (w[1]), [c] "r" (w[2]),
+                   [d] "r" (w[3])
+                 : "cc");
+        w += 4;
+    }
+    return acc + sum;
+}
+#else
+static inline uint64_t _sum_blocks(const uint32_t *w, size_t blocks,
+                                   uint64_t acc)
+{
+    while (blocks--) {
+        acc += (uint64_t)w[0] + w[1] + w[2] + w[3];
+        w += 4;
+    }
+    return acc;
+}
+#endif
+
+/* ones' complement sum of buf in host byte order, without folding the carries
+ * in. buf must be 2 byte aligned */
+static uint64_t _sum(const uint8_t *buf, size_t len)
+{
+    uint64_t acc = 0;
+
+    if (((uintptr_t)buf & 0x2) && (len >= 2)) {
+        acc += *(const uint16_t *)(uintptr_t)buf;
+        buf += 2;
+        len -= 2;
+    }
+    acc = _sum_blocks((const uint32_t *)(uintptr_t)buf, len >> 4, acc);
+    buf += len & ~0xfU;
+    len &= 0xf;
+    while (len >= 4) {
+        acc += *(const uint32_t *)(uintptr_t)buf;
+        buf += 4;
+        len -= 4;
+    }
+    if (len >= 2) {
+        acc += *(const uint16_t *)(uintptr_t)buf;
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        /* pad the last byte with zero to a 16 bit word in network byte
+         * order */
+        acc += ntohs(*buf << 8);
+    }
+    return acc;
+}
+
+static inline uint16_t _fold(uint64_t acc)
+{
+    while (acc >> 16) {
+        acc = (acc & 0xffff) + (acc >> 16);
+    }
+    return acc;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
+    uint16_t data;
 
     DEBUG("inet_sum: sum = 0x%04" PRIx16 ", len = %" PRIu16, sum, len);
 #if ENABLE_DEBUG
@@ -41,16 +120,23 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (len == 0) {
+        data = 0;
     }
-
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+    else if ((uintptr_t)buf & 1) {
+        /* Summing up from the next byte on, all words are rotated by one
+         * byte. The first byte goes to the bottom half of a leading word in
+         * that view. Rotating the sum by one byte undoes this. */
+        data = _fold(ntohs(*buf) + _sum(buf + 1, len - 1));
+        data = (data << 8) | (data >> 8);
+    }
+    else {
+        data = _fold(_sum(buf, len));
+    }
+    /* words were summed up in host byte order */
+    csum += ntohs(data);
 
     while (csum >> 16) {
         uint16_t carry = csum >> 16;
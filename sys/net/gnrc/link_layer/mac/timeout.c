@@ -116,14 +116,23 @@ bool gnrc_mac_timeout_is_expired(gnrc_mac_timeout_t *mac_timeout, gnrc_mac_timeo
 
     int index = gnrc_mac_find_timeout(mac_timeout, type);
     if (index >= 0) {
+        evtimer_event_t *event = &mac_timeout->timeouts[index].msg_event.event;
+#if IS_USED(MODULE_EVTIMER_HEAP)
+        /* every event in the heap but the root links to its parent or
+         * sibling */
+        if ((mac_timeout->evtimer.events == event) || (event->prev != NULL)) {
+            return false;
+        }
+#else
         evtimer_event_t *list;
         list = (evtimer_event_t *)&mac_timeout->evtimer.events;
         while (list->next) {
-            if (list->next == &mac_timeout->timeouts[index].msg_event.event) {
+            if (list->next == event) {
                 return false;
             }
             list = list->next;
         }
+#endif
 
         /* if we reach here, timeout is expired */
         mac_timeout->timeouts[index].type = GNRC_MAC_TIMEOUT_DISABLED;
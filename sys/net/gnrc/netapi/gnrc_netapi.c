@@ -81,6 +81,155 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
+/* delivers a single packet or batch to one subscriber, returns 0 on success
+ * or the error to release pkt with */
+static uint32_t _deliver(gnrc_netreg_entry_t *sendto, uint16_t cmd,
+                         gnrc_pktsnip_t *pkt)
+{
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
+    defined(MODULE_GNRC_NETAPI_BATCH)
+    switch (sendto->type) {
+        case GNRC_NETREG_TYPE_DEFAULT:
+#ifdef MODULE_GNRC_NETAPI_BATCH
+        case GNRC_NETREG_TYPE_BATCH:
+#endif
+            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+                /* unable to dispatch packet */
+                return EIO;
+            }
+            return 0;
+#ifdef MODULE_GNRC_NETAPI_MBOX
+        case GNRC_NETREG_TYPE_MBOX:
+            if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
+                /* unable to dispatch packet */
+                return EIO;
+            }
+            return 0;
+#endif
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+        case GNRC_NETREG_TYPE_CB:
+            sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
+            return 0;
+#endif
+        default:
+            /* unknown dispatch type */
+            return ECANCELED;
+    }
+#else
+    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+        /* unable to dispatch packet */
+        return EIO;
+    }
+    return 0;
+#endif
+}
+
+#ifdef MODULE_GNRC_NETAPI_BATCH
+static inline bool _is_batch_cmd(uint16_t cmd)
+{
+    return (cmd == GNRC_NETAPI_MSG_TYPE_RCV_BATCH) ||
+           (cmd == GNRC_NETAPI_MSG_TYPE_SND_BATCH);
+}
+
+static void _dispatch_batch(gnrc_netreg_entry_t *sendto, int numof,
+                            uint16_t cmd, gnrc_pktsnip_t *batch)
+{
+    uint16_t single_cmd = (cmd == GNRC_NETAPI_MSG_TYPE_RCV_BATCH)
+                        ? GNRC_NETAPI_MSG_TYPE_RCV
+                        : GNRC_NETAPI_MSG_TYPE_SND;
+
+    gnrc_pktbuf_hold(batch, numof - 1);
+    for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+        gnrc_pktbuf_hold(gnrc_netapi_batch_get(batch, i), numof - 1);
+    }
+    while (sendto) {
+        if (sendto->type == GNRC_NETREG_TYPE_BATCH) {
+            uint32_t status = _deliver(sendto, cmd, batch);
+
+            if (status != 0) {
+                gnrc_netapi_batch_release_error(batch, status);
+            }
+        }
+        else {
+            /* subscriber does not know about batches, so unroll it */
+            for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+                gnrc_pktsnip_t *pkt = gnrc_netapi_batch_get(batch, i);
+                uint32_t status = _deliver(sendto, single_cmd, pkt);
+
+                if (status != 0) {
+                    gnrc_pktbuf_release_error(pkt, status);
+                }
+            }
+            gnrc_pktbuf_release(batch);
+        }
+        sendto = gnrc_netreg_getnext(sendto);
+    }
+}
+
+void gnrc_netapi_batch_release_error(gnrc_pktsnip_t *batch, uint32_t err)
+{
+    for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+        gnrc_pktbuf_release_error(gnrc_netapi_batch_get(batch, i), err);
+    }
+    gnrc_pktbuf_release(batch);
+}
+
+int gnrc_netapi_batch_put(gnrc_netapi_batch_t *batch, gnrc_nettype_t type,
+                          uint32_t demux_ctx, uint16_t cmd,
+                          gnrc_pktsnip_t *pkt)
+{
+    int numof = gnrc_netreg_num(type, demux_ctx);
+
+    if (numof == 0) {
+        return 0;
+    }
+    if ((batch->numof > 0) &&
+        ((batch->type != type) || (batch->demux_ctx != demux_ctx) ||
+         (batch->cmd != cmd))) {
+        gnrc_netapi_batch_flush(batch);
+    }
+    batch->type = type;
+    batch->demux_ctx = demux_ctx;
+    batch->cmd = cmd;
+    batch->pkts[batch->numof++] = pkt;
+    if (batch->numof == CONFIG_GNRC_NETAPI_BATCH_SIZE) {
+        gnrc_netapi_batch_flush(batch);
+    }
+    return numof;
+}
+
+void gnrc_netapi_batch_flush(gnrc_netapi_batch_t *batch)
+{
+    gnrc_pktsnip_t *snip = NULL;
+    unsigned numof = batch->numof;
+
+    batch->numof = 0;
+    if (numof > 1) {
+        snip = gnrc_pktbuf_add(NULL, batch->pkts, numof * sizeof(batch->pkts[0]),
+                               GNRC_NETTYPE_UNDEF);
+    }
+    if (snip != NULL) {
+        uint16_t cmd = (batch->cmd == GNRC_NETAPI_MSG_TYPE_RCV)
+                     ? GNRC_NETAPI_MSG_TYPE_RCV_BATCH
+                     : GNRC_NETAPI_MSG_TYPE_SND_BATCH;
+
+        if (gnrc_netapi_dispatch(batch->type, batch->demux_ctx, cmd,
+                                 snip) == 0) {
+            /* subscribers are gone */
+            gnrc_netapi_batch_release_error(snip, EIO);
+        }
+        return;
+    }
+    /* single packet or no space for a batch: dispatch one by one */
+    for (unsigned i = 0; i < numof; i++) {
+        if (gnrc_netapi_dispatch(batch->type, batch->demux_ctx, batch->cmd,
+                                 batch->pkts[i]) == 0) {
+            gnrc_pktbuf_release_error(batch->pkts[i], EIO);
+        }
+    }
+}
+#endif /* MODULE_GNRC_NETAPI_BATCH */
+
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
@@ -89,46 +238,20 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
     if (numof != 0) {
         gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+        if (_is_batch_cmd(cmd)) {
+            _dispatch_batch(sendto, numof, cmd, pkt);
+            return numof;
+        }
+#endif
         gnrc_pktbuf_hold(pkt, numof - 1);
 
         while (sendto) {
-#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-            uint32_t status = 0;
-            switch (sendto->type) {
-                case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt,
-                                               cmd) < 1) {
-                        /* unable to dispatch packet */
-                        status = EIO;
-                    }
-                    break;
-#ifdef MODULE_GNRC_NETAPI_MBOX
-                case GNRC_NETREG_TYPE_MBOX:
-                    if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        status = EIO;
-                    }
-                    break;
-#endif
-#ifdef MODULE_GNRC_NETAPI_CALLBACKS
-                case GNRC_NETREG_TYPE_CB:
-                    sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
-                    break;
-#endif
-                default:
-                    /* unknown dispatch type */
-                    status = ECANCELED;
-                    break;
-            }
+            uint32_t status = _deliver(sendto, cmd, pkt);
+
             if (status != 0) {
                 gnrc_pktbuf_release_error(pkt, status);
             }
-#else
-            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
-                /* unable to dispatch packet */
-                gnrc_pktbuf_release_error(pkt, EIO);
-            }
-#endif
             sendto = gnrc_netreg_getnext(sendto);
         }
     }
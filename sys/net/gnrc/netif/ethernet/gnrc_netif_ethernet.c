@@ -165,6 +165,91 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     return res;
 }
 
+/* Reads the frame with netdev_driver_t::recv() into a single snip and splits
+ * off the Ethernet header with gnrc_pktbuf_mark() afterwards. Returns the
+ * payload snip with the Ethernet header snip as its successor. */
+static gnrc_pktsnip_t *_recv_copy(netdev_t *dev, int bytes_expected, int *nread)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected,
+                                          GNRC_NETTYPE_UNDEF);
+
+    if (!pkt) {
+        DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return NULL;
+    }
+
+    *nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+    if (*nread < (int)sizeof(ethernet_hdr_t)) {
+        DEBUG("gnrc_netif_ethernet: read error.\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+
+    if (*nread < bytes_expected) {
+        /* we've got less than the expected packet size,
+         * so free the unused space.*/
+
+        DEBUG("gnrc_netif_ethernet: reallocating.\n");
+        gnrc_pktbuf_realloc_data(pkt, *nread);
+    }
+
+    /* mark ethernet header */
+    if (!gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF)) {
+        DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return pkt;
+}
+
+/* Reads the frame with netdev_driver_t::recv_iol() directly into separate
+ * snips for Ethernet header and payload, so the payload does not need to be
+ * moved when the header is split off. Returns the payload snip with the
+ * Ethernet header snip as its successor. */
+static gnrc_pktsnip_t *_recv_scatter(netdev_t *dev, int bytes_expected,
+                                     int *nread)
+{
+    gnrc_pktsnip_t *pkt, *eth_hdr;
+
+    eth_hdr = gnrc_pktbuf_add(NULL, NULL, sizeof(ethernet_hdr_t),
+                              GNRC_NETTYPE_UNDEF);
+    pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected - sizeof(ethernet_hdr_t),
+                          GNRC_NETTYPE_UNDEF);
+    if (!eth_hdr || !pkt) {
+        DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+        gnrc_pktbuf_release(eth_hdr);
+        gnrc_pktbuf_release(pkt);
+
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return NULL;
+    }
+
+    /* packet snips are iolist_t compatible, the header needs to be read
+     * first */
+    eth_hdr->next = pkt;
+    *nread = dev->driver->recv_iol(dev, (iolist_t *)eth_hdr, NULL);
+    eth_hdr->next = NULL;
+    pkt->next = eth_hdr;
+    if (*nread < (int)sizeof(ethernet_hdr_t)) {
+        DEBUG("gnrc_netif_ethernet: read error.\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+
+    if (*nread < bytes_expected) {
+        /* we've got less than the expected packet size,
+         * so free the unused space.*/
+
+        DEBUG("gnrc_netif_ethernet: reallocating.\n");
+        gnrc_pktbuf_realloc_data(pkt, *nread - sizeof(ethernet_hdr_t));
+    }
+    return pkt;
+}
+
 static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 {
     netdev_t *dev = netif->dev;
@@ -172,51 +257,33 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
     gnrc_pktsnip_t *pkt = NULL;
 
     if (bytes_expected > 0) {
-        pkt = gnrc_pktbuf_add(NULL, NULL,
-                              bytes_expected,
-                              GNRC_NETTYPE_UNDEF);
+        int nread = 0;
 
+        if ((dev->driver->recv_iol != NULL) &&
+            (bytes_expected > (int)sizeof(ethernet_hdr_t))) {
+            pkt = _recv_scatter(dev, bytes_expected, &nread);
+        }
+        else {
+            pkt = _recv_copy(dev, bytes_expected, &nread);
+        }
         if (!pkt) {
-            DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
-
-            /* drop the packet */
-            dev->driver->recv(dev, NULL, bytes_expected, NULL);
-
             goto out;
         }
-
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
-        if (nread <= 0) {
-            DEBUG("gnrc_netif_ethernet: read error.\n");
-            goto safe_out;
-        }
 #ifdef MODULE_NETSTATS_L2
         netif->stats.rx_count++;
         netif->stats.rx_bytes += nread;
 #endif
 
-        if (nread < bytes_expected) {
-            /* we've got less than the expected packet size,
-             * so free the unused space.*/
-
-            DEBUG("gnrc_netif_ethernet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
-        }
+        gnrc_pktsnip_t *eth_hdr = pkt->next;
+        ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
 
         DEBUG("gnrc_netif_ethernet: received packet from %s of length %d\n",
-              gnrc_netif_addr_to_str(pkt->data, ETHERNET_ADDR_LEN, addr_str),
+              gnrc_netif_addr_to_str(hdr->src, ETHERNET_ADDR_LEN, addr_str),
               nread);
 #if defined(MODULE_OD) && ENABLE_DEBUG
-        od_hex_dump(pkt->data, nread, OD_WIDTH_DEFAULT);
+        od_hex_dump(eth_hdr->data, eth_hdr->size, OD_WIDTH_DEFAULT);
+        od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
 #endif
-        /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
-        if (!eth_hdr) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            goto safe_out;
-        }
-
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
 
 #ifdef MODULE_L2FILTER
         if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
@@ -236,7 +303,6 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 
         if (netif_hdr == NULL) {
             DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            pkt = eth_hdr;
             goto safe_out;
         }
 
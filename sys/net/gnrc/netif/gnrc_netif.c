@@ -1330,6 +1330,15 @@ static inline event_queue_t *_get_evq(gnrc_netif_t *netif)
 #endif
 }
 
+/* passes the received packets collected so far on to the upper layers */
+static void _flush_rx_batch(gnrc_netif_t *netif)
+{
+    (void)netif;
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    gnrc_netapi_batch_flush(&netif->rx_batch);
+#endif
+}
+
 /**
  * @brief   Process any pending events and wait for IPC messages
  *
@@ -1365,6 +1374,8 @@ static void _process_events_await_msg(gnrc_netif_t *netif, msg_t *msg)
             if (msg_waiting > 0) {
                 return;
             }
+            /* no more work pending: pass on received packets */
+            _flush_rx_batch(netif);
             DEBUG("gnrc_netif: waiting for events\n");
             /* Block the thread until something interesting happens */
             thread_flags_wait_any(THREAD_FLAG_MSG_WAITING | THREAD_FLAG_EVENT);
@@ -1372,6 +1383,10 @@ static void _process_events_await_msg(gnrc_netif_t *netif, msg_t *msg)
     }
     else {
         /* Only messages used for event handling */
+        if (msg_avail() == 0) {
+            /* no more work pending: pass on received packets */
+            _flush_rx_batch(netif);
+        }
         DEBUG("gnrc_netif: waiting for incoming messages\n");
         msg_receive(msg);
     }
@@ -1472,6 +1487,9 @@ static void *_gnrc_netif_thread(void *args)
     gnrc_netif_acquire(netif);
     dev = netif->dev;
     netif->pid = thread_getpid();
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    netif->rx_batch.numof = 0;
+#endif
 
 #if IS_USED(MODULE_GNRC_NETIF_EVENTS)
     netif->event_isr.handler = _event_handler_isr,
@@ -1542,6 +1560,17 @@ static void *_gnrc_netif_thread(void *args)
                 last_wakeup = xtimer_now();
 #endif
                 break;
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("gnrc_netif: GNRC_NETAPI_MSG_TYPE_SND_BATCH received\n");
+                for (unsigned i = 0; i < gnrc_netapi_batch_numof(msg.content.ptr);
+                     i++) {
+                    _send(netif, gnrc_netapi_batch_get(msg.content.ptr, i),
+                          false);
+                }
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+#endif  /* IS_USED(MODULE_GNRC_NETAPI_BATCH) */
             case GNRC_NETAPI_MSG_TYPE_SET:
                 opt = msg.content.ptr;
 #ifdef MODULE_NETOPT
@@ -1589,11 +1618,23 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
-static void _pass_on_packet(gnrc_pktsnip_t *pkt)
+static void _pass_on_packet(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
+    int res;
+
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    /* collect packets while further events are pending, the batch is passed
+     * on when the thread runs out of work */
+    res = gnrc_netapi_batch_put(&netif->rx_batch, pkt->type,
+                                GNRC_NETREG_DEMUX_CTX_ALL,
+                                GNRC_NETAPI_MSG_TYPE_RCV, pkt);
+#else
+    (void)netif;
+    res = gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL,
+                                       pkt);
+#endif
     /* throw away packet if no one is interested */
-    if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL,
-                                      pkt)) {
+    if (!res) {
         DEBUG("gnrc_netif: unable to forward packet of type %i\n", pkt->type);
         gnrc_pktbuf_release(pkt);
         return;
@@ -1628,7 +1669,7 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
                  * Further packets will be sent on later TX_COMPLETE */
                 _send_queued_pkt(netif);
                 if (pkt) {
-                    _pass_on_packet(pkt);
+                    _pass_on_packet(netif, pkt);
                 }
                 break;
 #if IS_USED(MODULE_NETSTATS_L2) || IS_USED(MODULE_GNRC_NETIF_PKTQ)
@@ -13,10 +13,15 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/pktqueue.h"
 #include "net/gnrc/netif/conf.h"
+#include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/netif/pktq.h"
+#include "net/sixlowpan/sfr.h"
 
 static gnrc_pktqueue_t _pool[CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE];
 
@@ -30,6 +35,55 @@ static gnrc_pktqueue_t *_get_free_entry(void)
     return NULL;
 }
 
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ_ECN)
+static bool _same_dst(const gnrc_netif_hdr_t *a, const gnrc_pktsnip_t *pkt)
+{
+    const gnrc_netif_hdr_t *b;
+
+    if ((pkt->type != GNRC_NETTYPE_NETIF) || (pkt->data == NULL)) {
+        return false;
+    }
+    b = pkt->data;
+    return (a->dst_l2addr_len == b->dst_l2addr_len) &&
+           (memcmp(gnrc_netif_hdr_get_dst_addr(a),
+                   gnrc_netif_hdr_get_dst_addr(b), a->dst_l2addr_len) == 0);
+}
+
+/* marks a recoverable fragment with the ECN flag when the queue towards its
+ * next hop builds up, so the sender backs off before fragments are dropped */
+static gnrc_pktsnip_t *_mark_ecn(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    unsigned depth = 0;
+
+    if ((pkt->type != GNRC_NETTYPE_NETIF) || (pkt->data == NULL) ||
+        (pkt->next == NULL) || (pkt->next->size < sizeof(sixlowpan_sfr_t)) ||
+        !sixlowpan_sfr_rfrag_is(pkt->next->data)) {
+        return pkt;
+    }
+    for (gnrc_pktqueue_t *ptr = netif->send_queue.queue; ptr != NULL;
+         ptr = ptr->next) {
+        if (_same_dst(pkt->data, ptr->pkt) &&
+            (++depth >= CONFIG_GNRC_NETIF_PKTQ_ECN_THRESHOLD)) {
+            gnrc_pktsnip_t *hdr, *frag;
+
+            /* the fragment may still be held by others, e.g. by its sender
+             * for retransmission, so only mark our own copy. If there is no
+             * space for a copy, the fragment is queued unmarked. */
+            if ((hdr = gnrc_pktbuf_start_write(pkt)) == NULL) {
+                return pkt;
+            }
+            if ((frag = gnrc_pktbuf_start_write(hdr->next)) == NULL) {
+                return hdr;
+            }
+            hdr->next = frag;
+            sixlowpan_sfr_set_ecn(frag->data);
+            return hdr;
+        }
+    }
+    return pkt;
+}
+#endif  /* IS_USED(MODULE_GNRC_NETIF_PKTQ_ECN) */
+
 int gnrc_netif_pktq_put(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
     assert(netif != NULL);
@@ -40,6 +94,9 @@ int gnrc_netif_pktq_put(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     if (entry == NULL) {
         return -1;
     }
+#if IS_USED(MODULE_GNRC_NETIF_PKTQ_ECN)
+    pkt = _mark_ecn(netif, pkt);
+#endif
     entry->pkt = pkt;
     gnrc_pktqueue_add(&netif->send_queue.queue, entry);
     return 0;
@@ -30,20 +30,36 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#ifdef MODULE_GNRC_NETREG_HASH
+#define _BUCKETS_NUMOF  (CONFIG_GNRC_NETREG_HASH_BUCKETS)
+#define _BUCKET(ctx)    gnrc_netreg_hash(ctx)
+#else
+#define _BUCKETS_NUMOF  (1U)
+#define _BUCKET(ctx)    (0U)
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t, every type is split into
+ * hash buckets of the demux context with gnrc_netreg_hash. All entries with
+ * the same demux context are in the same bucket, so gnrc_netreg_getnext()
+ * only needs to follow the bucket's list. */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][_BUCKETS_NUMOF];
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
 {
 #if DEVELHELP
-# if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-    bool has_msg_q = (entry->type != GNRC_NETREG_TYPE_DEFAULT) ||
+# if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
+     defined(MODULE_GNRC_NETAPI_BATCH)
+    bool uses_msg = (entry->type == GNRC_NETREG_TYPE_DEFAULT);
+#  if defined(MODULE_GNRC_NETAPI_BATCH)
+    uses_msg |= (entry->type == GNRC_NETREG_TYPE_BATCH);
+#  endif
+    bool has_msg_q = !uses_msg ||
                      thread_has_msg_queue(thread_get(entry->target.pid));
 # else
     bool has_msg_q = thread_has_msg_queue(thread_get(entry->target.pid));
@@ -61,7 +77,7 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    LL_PREPEND(netreg[type][_BUCKET(entry->demux_ctx)], entry);
 
     return 0;
 }
@@ -72,7 +88,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(netreg[type][_BUCKET(entry->demux_ctx)], entry);
 }
 
 /**
@@ -94,7 +110,8 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
     gnrc_netreg_entry_t *res = NULL;
 
     if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
+        gnrc_netreg_entry_t *head = (from) ? from->next
+                                          : netreg[type][_BUCKET(demux_ctx)];
         LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
     }
 
@@ -68,6 +68,12 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 kernel_pid_t gnrc_ipv6_pid = KERNEL_PID_UNDEF;
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+/* collects packets passed to upper layers while handling a received batch */
+static gnrc_netapi_batch_t _upper_batch;
+static bool _in_batch;
+#endif
+
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
 /* Sends packet over the appropriate interface(s).
@@ -141,6 +147,18 @@ ipv6_hdr_t *gnrc_ipv6_get_header(gnrc_pktsnip_t *pkt)
 }
 
 /* internal functions */
+static int _dispatch_receive(gnrc_nettype_t type, uint32_t demux_ctx,
+                             gnrc_pktsnip_t *pkt)
+{
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    if (_in_batch) {
+        return gnrc_netapi_batch_put(&_upper_batch, type, demux_ctx,
+                                     GNRC_NETAPI_MSG_TYPE_RCV, pkt);
+    }
+#endif
+    return gnrc_netapi_dispatch_receive(type, demux_ctx, pkt);
+}
+
 static void _dispatch_next_header(gnrc_pktsnip_t *pkt, unsigned nh,
                                   bool interested)
 {
@@ -153,9 +171,7 @@ static void _dispatch_next_header(gnrc_pktsnip_t *pkt, unsigned nh,
         gnrc_pktbuf_hold(pkt, 1);   /* don't remove from packet buffer in
                                      * next dispatch */
     }
-    if (gnrc_netapi_dispatch_receive(pkt->type,
-                                     GNRC_NETREG_DEMUX_CTX_ALL,
-                                     pkt) == 0) {
+    if (_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL, pkt) == 0) {
         gnrc_pktbuf_release(pkt);
     }
     if (!has_nh_subs) {
@@ -166,16 +182,40 @@ static void _dispatch_next_header(gnrc_pktsnip_t *pkt, unsigned nh,
         gnrc_pktbuf_hold(pkt, 1);   /* don't remove from packet buffer in
                                      * next dispatch */
     }
-    if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, nh, pkt) == 0) {
+    if (_dispatch_receive(GNRC_NETTYPE_IPV6, nh, pkt) == 0) {
         gnrc_pktbuf_release(pkt);
     }
 }
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+/* handles GNRC_NETAPI_MSG_TYPE_RCV_BATCH commands */
+static void _receive_batch(gnrc_pktsnip_t *batch)
+{
+    _in_batch = true;
+    for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+        _receive(gnrc_netapi_batch_get(batch, i));
+    }
+    _in_batch = false;
+    gnrc_netapi_batch_flush(&_upper_batch);
+    gnrc_pktbuf_release(batch);
+}
+
+/* handles GNRC_NETAPI_MSG_TYPE_SND_BATCH commands */
+static void _send_batch(gnrc_pktsnip_t *batch)
+{
+    for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+        _send(gnrc_netapi_batch_get(batch, i), true);
+    }
+    gnrc_pktbuf_release(batch);
+}
+#endif
+
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
-    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
-                                                            thread_getpid());
+    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID_BATCH(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                                  thread_getpid());
 
     (void)args;
     msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
@@ -206,6 +246,18 @@ static void *_event_loop(void *args)
                 _send(msg.content.ptr, true);
                 break;
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                _receive_batch(msg.content.ptr);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND_BATCH received\n");
+                _send_batch(msg.content.ptr);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("ipv6: reply to unsupported get/set\n");
@@ -18,6 +18,7 @@
 #include <string.h>
 #include <kernel_defines.h>
 
+#include "irq.h"
 #include "net/gnrc/icmpv6/error.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/nib/conf.h"
@@ -28,6 +29,7 @@
 
 #include "_nib-internal.h"
 #include "_nib-router.h"
+#include "_nib-trie.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -40,6 +42,18 @@ static _nib_onl_entry_t _nodes[CONFIG_GNRC_IPV6_NIB_NUMOF];
 static _nib_offl_entry_t _dsts[CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
 static _nib_dr_entry_t _def_routers[CONFIG_GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH)
+/* list of on-link entries without address, but with an interface. In
+ * _nib_onl_alloc() they match any address on their interface */
+#define _ONL_UNSPEC     (CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS)
+#define _ONL_NONE       (UINT16_MAX)
+
+/* _nodes indexes chained per hash bucket of _nib_onl_entry_t::ipv6 */
+static uint16_t _onl_heads[CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS + 1];
+static uint16_t _onl_next[CONFIG_GNRC_IPV6_NIB_NUMOF];
+static uint16_t _onl_lists[CONFIG_GNRC_IPV6_NIB_NUMOF];
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C)
 static _nib_abr_entry_t _abrs[CONFIG_GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
@@ -65,6 +79,11 @@ void _nib_init(void)
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
 #endif  /* TEST_SUITES */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH)
+    memset(_onl_heads, 0xff, sizeof(_onl_heads));
+    memset(_onl_lists, 0xff, sizeof(_onl_lists));
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+    _nib_trie_init();
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -86,13 +105,11 @@ static inline bool _addr_equals(const ipv6_addr_t *addr,
            (ipv6_addr_equal(addr, &node->ipv6));
 }
 
-_nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
+static _nib_onl_entry_t *_onl_alloc_linear(const ipv6_addr_t *addr,
+                                            unsigned iface)
 {
     _nib_onl_entry_t *node = NULL;
 
-    DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
-          (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
-                                                     sizeof(addr_str)), iface);
     for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *tmp = &_nodes[i];
 
@@ -107,6 +124,132 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
             node = tmp;
         }
     }
+    return node;
+}
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH)
+static unsigned _onl_hash(const ipv6_addr_t *addr)
+{
+    /* neighbors mostly share the prefix, so fold all words to let the
+     * interface identifier spread the entries */
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bU;
+    hash ^= hash >> 16;
+    return hash % CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS;
+}
+
+static unsigned _onl_list(const _nib_onl_entry_t *node)
+{
+    if (!ipv6_addr_is_unspecified(&node->ipv6)) {
+        return _onl_hash(&node->ipv6);
+    }
+    return (_nib_onl_get_if(node) != 0) ? _ONL_UNSPEC : _ONL_NONE;
+}
+
+void _nib_onl_reindex(_nib_onl_entry_t *node)
+{
+    unsigned idx = node - _nodes;
+    unsigned list = _onl_list(node);
+    uint16_t *ptr;
+
+    assert(idx < CONFIG_GNRC_IPV6_NIB_NUMOF);
+    if (_onl_lists[idx] == list) {
+        return;
+    }
+    if (_onl_lists[idx] != _ONL_NONE) {
+        for (ptr = &_onl_heads[_onl_lists[idx]]; *ptr != idx;
+             ptr = &_onl_next[*ptr]) {}
+        *ptr = _onl_next[idx];
+    }
+    _onl_lists[idx] = list;
+    if (list != _ONL_NONE) {
+        /* keep lists in table order, so lookups find the same entry as a
+         * linear search over _nodes */
+        for (ptr = &_onl_heads[list]; (*ptr != _ONL_NONE) && (*ptr < idx);
+             ptr = &_onl_next[*ptr]) {}
+        _onl_next[idx] = *ptr;
+        *ptr = idx;
+    }
+}
+
+static _nib_onl_entry_t *_onl_alloc_hashed(const ipv6_addr_t *addr,
+                                           unsigned iface)
+{
+    _nib_onl_entry_t *node = NULL;
+
+    /* without address or interface almost any entry may match */
+    if ((addr == NULL) || (iface == 0) || ipv6_addr_is_unspecified(addr)) {
+        return _onl_alloc_linear(addr, iface);
+    }
+    for (unsigned i = _onl_heads[_onl_hash(addr)]; i != _ONL_NONE;
+         i = _onl_next[i]) {
+        if ((_nib_onl_get_if(&_nodes[i]) == iface) &&
+            ipv6_addr_equal(addr, &_nodes[i].ipv6)) {
+            node = &_nodes[i];
+            break;
+        }
+    }
+    /* an entry without address on the same interface takes precedence if it
+     * comes first in the table */
+    for (unsigned i = _onl_heads[_ONL_UNSPEC];
+         (i != _ONL_NONE) && ((node == NULL) || (&_nodes[i] < node));
+         i = _onl_next[i]) {
+        if ((_nib_onl_get_if(&_nodes[i]) == iface) &&
+            ipv6_addr_is_unspecified(&_nodes[i].ipv6)) {
+            node = &_nodes[i];
+            break;
+        }
+    }
+    if (node != NULL) {
+        DEBUG("  %p is an exact match\n", (void *)node);
+        return node;
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        if (_nodes[i].mode == _EMPTY) {
+            DEBUG("  using %p\n", (void *)&_nodes[i]);
+            return &_nodes[i];
+        }
+    }
+    return NULL;
+}
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+
+/* iterates all on-link entries that may have address addr in table order */
+static _nib_onl_entry_t *_onl_iter_addr(const ipv6_addr_t *addr,
+                                        const _nib_onl_entry_t *last)
+{
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH)
+    if (!ipv6_addr_is_unspecified(addr)) {
+        unsigned idx = (last) ? _onl_next[last - _nodes]
+                              : _onl_heads[_onl_hash(addr)];
+
+        return (idx != _ONL_NONE) ? &_nodes[idx] : NULL;
+    }
+#else   /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+    (void)addr;
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+    last = (last) ? (last + 1) : _nodes;
+    /* const modifier provided to assure internal consistency.
+     * Can now be discarded. */
+    return (last < (_nodes + CONFIG_GNRC_IPV6_NIB_NUMOF)) ?
+           (_nib_onl_entry_t *)last : NULL;
+}
+
+_nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
+{
+    _nib_onl_entry_t *node;
+
+    DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
+          (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
+                                                     sizeof(addr_str)), iface);
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH)
+    node = _onl_alloc_hashed(addr, iface);
+#else   /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+    node = _onl_alloc_linear(addr, iface);
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
     if (node != NULL) {
         _override_node(addr, iface, node);
     }
@@ -220,9 +363,8 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
-    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
-        _nib_onl_entry_t *node = &_nodes[i];
-
+    for (_nib_onl_entry_t *node = _onl_iter_addr(addr, NULL); node != NULL;
+         node = _onl_iter_addr(addr, node)) {
         if ((node->mode != _EMPTY) &&
             /* either requested or current interface undefined or
              * interfaces equal */
@@ -495,6 +637,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+                _nib_onl_reindex(tmp_node);
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -515,6 +658,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _nib_trie_add(dst);
     }
     return dst;
 }
@@ -551,6 +695,7 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        _nib_trie_remove(dst);
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -576,11 +721,14 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
 
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
+    DEBUG("nib: get match for destination %s from NIB\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE)
+    return _nib_trie_get_match(dst);
+#else   /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
     _nib_offl_entry_t *res = NULL;
     uint8_t best_match = 0;
 
-    DEBUG("nib: get match for destination %s from NIB\n",
-          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
     for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
         if (entry->mode != _EMPTY) {
             uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
@@ -601,6 +749,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
         }
     }
     return res;
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
 }
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
@@ -832,6 +981,7 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+    _nib_onl_reindex(node);
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
@@ -848,6 +998,30 @@ static inline bool _node_unreachable(_nib_onl_entry_t *node)
 
 uint32_t _evtimer_lookup(const void *ctx, uint16_t type)
 {
+#if IS_USED(MODULE_EVTIMER_HEAP)
+    evtimer_t *evtimer = (evtimer_t *)&_nib_evtimer;
+    evtimer_event_t *ptr = NULL;
+    uint32_t offset = UINT32_MAX;
+    /* the heap is not sorted, so all events need to be checked, without the
+     * handler restructuring it in between */
+    unsigned state = irq_disable();
+
+    DEBUG("nib: lookup ctx = %p, type = %04x\n", (void *)ctx, type);
+    while ((ptr = evtimer_iter(evtimer, ptr)) != NULL) {
+        evtimer_msg_event_t *event = (evtimer_msg_event_t *)ptr;
+
+        if ((event->msg.type == type) &&
+            ((ctx == NULL) || (event->msg.content.ptr == ctx))) {
+            uint32_t left = evtimer_left(evtimer, ptr);
+
+            if (left < offset) {
+                offset = left;
+            }
+        }
+    }
+    irq_restore(state);
+    return offset;
+#else
     evtimer_msg_event_t *event = (evtimer_msg_event_t *)_nib_evtimer.events;
     uint32_t offset = 0;
 
@@ -861,6 +1035,7 @@ uint32_t _evtimer_lookup(const void *ctx, uint16_t type)
         event = (evtimer_msg_event_t *)event->event.next;
     }
     return UINT32_MAX;
+#endif
 }
 
 /** @} */
@@ -195,7 +195,7 @@ typedef struct {
 /**
  * @brief   Off-link NIB entry
  */
-typedef struct {
+typedef struct _nib_offl_entry {
     _nib_onl_entry_t *next_hop; /**< next hop to destination */
     ipv6_addr_t pfx;            /**< prefix to the destination */
     /**
@@ -217,6 +217,14 @@ typedef struct {
                                      valid (UINT32_MAX means forever) */
     uint32_t pref_until;        /**< timestamp (in ms) until which the prefix
                                      preferred (UINT32_MAX means forever) */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE) || defined(DOXYGEN)
+    /**
+     * @brief   Next entry with the same prefix in the off-link trie
+     *
+     * @note    Only available if @ref CONFIG_GNRC_IPV6_NIB_OFFL_TRIE.
+     */
+    struct _nib_offl_entry *trie_next;
+#endif
 } _nib_offl_entry_t;
 
 /**
@@ -310,6 +318,22 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH) || defined(DOXYGEN)
+/**
+ * @brief   Updates the position of an on-link entry in the hash index
+ *
+ * Must be called whenever _nib_onl_entry_t::ipv6 or the interface of
+ * @p node changed.
+ *
+ * @note    Only available if @ref CONFIG_GNRC_IPV6_NIB_ONL_HASH.
+ *
+ * @param[in] node  An on-link entry.
+ */
+void _nib_onl_reindex(_nib_onl_entry_t *node);
+#else   /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+#define _nib_onl_reindex(node)  (void)node
+#endif  /* CONFIG_GNRC_IPV6_NIB_ONL_HASH */
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -322,6 +346,7 @@ static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
         memset(node, 0, sizeof(_nib_onl_entry_t));
+        _nib_onl_reindex(node);
         return true;
     }
     return false;
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <kernel_defines.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+
+#include "_nib-internal.h"
+#include "_nib-trie.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE)
+/**
+ * @brief   A trie with k prefixes has at most k - 1 branching nodes
+ */
+#define _TRIE_NODES_NUMOF   (2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF)
+
+typedef struct _trie_node {
+    ipv6_addr_t pfx;                /**< prefix bits leading to this node */
+    struct _trie_node *parent;      /**< parent node (next free node for
+                                     *   unused nodes) */
+    struct _trie_node *child[2];    /**< children for bit 0 and bit 1
+                                     *   following the prefix */
+    _nib_offl_entry_t *entries;     /**< off-link entries ending in this node
+                                     *   or NULL for pure branching nodes */
+    uint8_t pfx_len;                /**< length of _trie_node::pfx in bits */
+} _trie_node_t;
+
+static _trie_node_t _trie_nodes[_TRIE_NODES_NUMOF];
+static _trie_node_t *_root;
+static _trie_node_t *_free_nodes;
+
+static inline unsigned _bit(const ipv6_addr_t *addr, unsigned pos)
+{
+    return (addr->u8[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+/* checks if bits [start, end) of a and b are equal */
+static bool _bits_equal(const ipv6_addr_t *a, const ipv6_addr_t *b,
+                        unsigned start, unsigned end)
+{
+    for (unsigned i = start >> 3; (i << 3) < end; i++) {
+        uint8_t mask = 0xff;
+
+        if ((i << 3) < start) {
+            mask >>= (start & 0x7);
+        }
+        if (((i + 1) << 3) > end) {
+            mask &= (uint8_t)(0xff << (((i + 1) << 3) - end));
+        }
+        if ((a->u8[i] ^ b->u8[i]) & mask) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static _trie_node_t *_node_alloc(const ipv6_addr_t *pfx, unsigned pfx_len,
+                                 _trie_node_t *parent)
+{
+    _trie_node_t *node = _free_nodes;
+
+    /* the pool is sized so that it can not run out */
+    assert(node != NULL);
+    _free_nodes = node->parent;
+    memset(node, 0, sizeof(*node));
+    ipv6_addr_init_prefix(&node->pfx, pfx, pfx_len);
+    node->pfx_len = pfx_len;
+    node->parent = parent;
+    return node;
+}
+
+static void _node_free(_trie_node_t *node)
+{
+    node->parent = _free_nodes;
+    _free_nodes = node;
+}
+
+static _trie_node_t **_link(_trie_node_t *node)
+{
+    _trie_node_t *parent = node->parent;
+
+    if (parent == NULL) {
+        return &_root;
+    }
+    return &parent->child[parent->child[1] == node];
+}
+
+/* keeps the entries of a node in the order of the off-link table so the
+ * first usable entry is also the one the linear search would find */
+static void _entry_insert(_trie_node_t *node, _nib_offl_entry_t *dst)
+{
+    _nib_offl_entry_t **ptr = &node->entries;
+
+    while ((*ptr != NULL) && (*ptr < dst)) {
+        ptr = &(*ptr)->trie_next;
+    }
+    dst->trie_next = *ptr;
+    *ptr = dst;
+}
+
+void _nib_trie_init(void)
+{
+    _root = NULL;
+    _free_nodes = NULL;
+    for (unsigned i = 0; i < _TRIE_NODES_NUMOF; i++) {
+        _node_free(&_trie_nodes[i]);
+    }
+}
+
+void _nib_trie_add(_nib_offl_entry_t *dst)
+{
+    _trie_node_t **link = &_root;
+    _trie_node_t *parent = NULL;
+    _trie_node_t *node;
+
+    assert((dst != NULL) && (dst->pfx_len > 0));
+    while ((node = *link) != NULL) {
+        unsigned common = ipv6_addr_match_prefix(&node->pfx, &dst->pfx);
+
+        if (common > dst->pfx_len) {
+            common = dst->pfx_len;
+        }
+        if (common < node->pfx_len) {
+            /* prefix ends or branches off within the edge to node */
+            _trie_node_t *split = _node_alloc(&dst->pfx, common, parent);
+
+            split->child[_bit(&node->pfx, common)] = node;
+            node->parent = split;
+            *link = split;
+            if (common == dst->pfx_len) {
+                _entry_insert(split, dst);
+                return;
+            }
+            parent = split;
+            link = &split->child[_bit(&dst->pfx, common)];
+            break;
+        }
+        if (node->pfx_len == dst->pfx_len) {
+            _entry_insert(node, dst);
+            return;
+        }
+        parent = node;
+        link = &node->child[_bit(&dst->pfx, node->pfx_len)];
+    }
+    node = _node_alloc(&dst->pfx, dst->pfx_len, parent);
+    *link = node;
+    _entry_insert(node, dst);
+}
+
+void _nib_trie_remove(_nib_offl_entry_t *dst)
+{
+    _trie_node_t *node = _root;
+    _nib_offl_entry_t **ptr;
+
+    while ((node != NULL) && (node->pfx_len < dst->pfx_len)) {
+        node = node->child[_bit(&dst->pfx, node->pfx_len)];
+    }
+    if ((node == NULL) || (node->pfx_len != dst->pfx_len) ||
+        !ipv6_addr_equal(&node->pfx, &dst->pfx)) {
+        return;
+    }
+    for (ptr = &node->entries; (*ptr != NULL) && (*ptr != dst);
+         ptr = &(*ptr)->trie_next) {}
+    if (*ptr == NULL) {
+        return;
+    }
+    *ptr = dst->trie_next;
+    dst->trie_next = NULL;
+    /* remove nodes that neither hold entries nor branch anymore */
+    while ((node != NULL) && (node->entries == NULL) &&
+           ((node->child[0] == NULL) || (node->child[1] == NULL))) {
+        _trie_node_t *child = (node->child[0] != NULL) ? node->child[0]
+                                                        : node->child[1];
+        _trie_node_t *parent = node->parent;
+
+        *_link(node) = child;
+        _node_free(node);
+        if (child != NULL) {
+            child->parent = parent;
+            break;
+        }
+        node = parent;
+    }
+}
+
+_nib_offl_entry_t *_nib_trie_get_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+    _trie_node_t *node = _root;
+    unsigned matched = 0;
+
+    while ((node != NULL) &&
+           _bits_equal(&node->pfx, dst, matched, node->pfx_len)) {
+        for (_nib_offl_entry_t *entry = node->entries; entry != NULL;
+             entry = entry->trie_next) {
+            if (entry->mode != _EMPTY) {
+                /* a longer prefix always matches more bits of dst, unless it
+                 * is stored as the same address as a shorter one (e.g.
+                 * 2001:db8::/32 and 2001:db8::/64). Then the matches tie and
+                 * the entry first in the table wins */
+                if ((res == NULL) || (entry < res) ||
+                    !ipv6_addr_equal(&res->pfx, &entry->pfx)) {
+                    res = entry;
+                }
+                break;
+            }
+        }
+        matched = node->pfx_len;
+        if (matched >= IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        node = node->child[_bit(dst, matched)];
+    }
+    DEBUG("nib: trie match for destination is %p\n", (void *)res);
+    return res;
+}
+#else   /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
+typedef int dont_be_pedantic;
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
+
+/** @} */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_ipv6_nib
+ * @{
+ *
+ * @file
+ * @brief   Longest-prefix match trie for the off-link entries of the NIB
+ * @see     @ref CONFIG_GNRC_IPV6_NIB_OFFL_TRIE
+ *
+ * The trie is a path-compressed binary (Patricia) trie over the prefixes of
+ * all allocated off-link entries. Each node stores the prefix bits leading to
+ * it, so a lookup visits at most one node per bit of the destination address
+ * and a node is only created where two prefixes branch off or where a
+ * prefix ends. All off-link entries sharing the same prefix hang off the
+ * same node, ordered by their position in the off-link table.
+ */
+#ifndef PRIV_NIB_TRIE_H
+#define PRIV_NIB_TRIE_H
+
+#include <kernel_defines.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/ipv6/addr.h"
+
+#include "_nib-internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE) || defined(DOXYGEN)
+/**
+ * @brief   Empties the trie
+ */
+void _nib_trie_init(void);
+
+/**
+ * @brief   Adds an off-link entry to the trie
+ *
+ * @pre     `(dst != NULL) && (dst->pfx_len > 0)`
+ * @pre     @p dst is not in the trie yet.
+ *
+ * @param[in] dst   An off-link entry with _nib_offl_entry_t::pfx and
+ *                  _nib_offl_entry_t::pfx_len set.
+ */
+void _nib_trie_add(_nib_offl_entry_t *dst);
+
+/**
+ * @brief   Removes an off-link entry from the trie
+ *
+ * @param[in] dst   An off-link entry. Nothing happens if it is not in the
+ *                  trie.
+ */
+void _nib_trie_remove(_nib_offl_entry_t *dst);
+
+/**
+ * @brief   Gets the best matching off-link entry for a destination
+ *
+ * Yields the same entry as a linear search for the entry with the longest
+ * common prefix with @p dst would: among the entries covering @p dst and
+ * having a non-empty _nib_offl_entry_t::mode, the one matching the most bits
+ * of @p dst wins, ties are broken by the position in the off-link table.
+ *
+ * @param[in] dst   A destination address.
+ *
+ * @return  The best matching off-link entry for @p dst.
+ * @return  NULL, if no off-link entry covers @p dst.
+ */
+_nib_offl_entry_t *_nib_trie_get_match(const ipv6_addr_t *dst);
+#else   /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
+#define _nib_trie_init()            (void)0
+#define _nib_trie_add(dst)          (void)dst
+#define _nib_trie_remove(dst)       (void)dst
+#endif  /* CONFIG_GNRC_IPV6_NIB_OFFL_TRIE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIV_NIB_TRIE_H */
+/** @} */
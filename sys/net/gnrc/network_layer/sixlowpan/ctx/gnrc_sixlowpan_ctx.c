@@ -25,6 +25,8 @@
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
 static mutex_t _ctx_mutex = MUTEX_INIT;
+static uint32_t _ctx_gen;
+static uint32_t _ctx_gen_minute;
 
 static uint32_t _current_minute(void);
 static void _update_lifetime(uint8_t id);
@@ -124,11 +126,56 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    _ctx_gen++;
 
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
 }
 
+void gnrc_sixlowpan_ctx_remove(uint8_t id)
+{
+    if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
+        return;
+    }
+
+    mutex_lock(&_ctx_mutex);
+    _ctxs[id].prefix_len = 0;
+    _ctx_gen++;
+    mutex_unlock(&_ctx_mutex);
+}
+
+bool gnrc_sixlowpan_ctx_try_remove(uint8_t id)
+{
+    if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
+        return true;
+    }
+
+    if (!mutex_trylock(&_ctx_mutex)) {
+        return false;
+    }
+    _ctxs[id].prefix_len = 0;
+    _ctx_gen++;
+    mutex_unlock(&_ctx_mutex);
+    return true;
+}
+
+uint32_t gnrc_sixlowpan_ctx_generation(void)
+{
+    uint32_t now = _current_minute();
+    uint32_t res;
+
+    mutex_lock(&_ctx_mutex);
+    /* lifetimes expire with minute granularity, so a context may have become
+     * invalid for compression whenever a new minute started */
+    if (now != _ctx_gen_minute) {
+        _ctx_gen_minute = now;
+        _ctx_gen++;
+    }
+    res = _ctx_gen;
+    mutex_unlock(&_ctx_mutex);
+    return res;
+}
+
 static uint32_t _current_minute(void)
 {
     return xtimer_now_usec() / (US_PER_SEC * 60);
@@ -161,6 +208,7 @@ static void _update_lifetime(uint8_t id)
 void gnrc_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    _ctx_gen++;
 }
 #endif
 
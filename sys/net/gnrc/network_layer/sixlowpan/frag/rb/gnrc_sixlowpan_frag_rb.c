@@ -56,6 +56,24 @@ static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
 
 static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
 
+/* interval to start the search for a free interval at */
+static unsigned rbuf_int_next;
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+/* entries hashed by source, destination and tag. A removed entry stays in its
+ * bucket until it is reused, look-ups skip it since it is empty */
+static gnrc_sixlowpan_frag_rb_t *rbuf_buckets[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_HASH_BUCKETS];
+static gnrc_sixlowpan_frag_rb_t *rbuf_bucket_next[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+/* bucket + 1 of each entry, 0 if it is in no bucket */
+static uint8_t rbuf_bucket_of[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+#endif
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
+/* fragments added to each entry, as intervals of adjacent fragments are
+ * merged */
+static uint8_t rbuf_frags[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+#endif
+
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
 static xtimer_t _gc_timer;
@@ -77,6 +95,10 @@ static int _rbuf_get(const void *src, size_t src_len,
                      const void *dst, size_t dst_len,
                      size_t size, uint16_t tag,
                      unsigned page);
+/* gets an entry by its tuple, with RBUF_ANY_SIZE for any datagram size */
+static gnrc_sixlowpan_frag_rb_t *_rbuf_find(const uint8_t *src, size_t src_len,
+                                            const uint8_t *dst, size_t dst_len,
+                                            size_t size, uint16_t tag);
 /* gets an entry only by link-layer information and tag */
 static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
                                                   uint16_t tag);
@@ -84,6 +106,9 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
 static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                      size_t offset, unsigned page);
 
+/* wildcard datagram size for _rbuf_find() */
+#define RBUF_ANY_SIZE   (SIZE_MAX)
+
 /* status codes for _rbuf_add() */
 enum {
     RBUF_ADD_SUCCESS = 0,
@@ -96,23 +121,25 @@ static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
                             size_t frag_size, size_t offset)
 {
     gnrc_sixlowpan_frag_rb_int_t *ptr = entry->ints;
+    uint16_t end = (uint16_t)(offset + frag_size - 1);
 
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
     while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
+        /* intervals of adjacent fragments are merged, so a fragment within an
+         * interval was received already */
+        if ((ptr->start <= offset) && (end <= ptr->end)) {
+            DEBUG("6lo rbuf: fragment already in reassembly buffer\n");
+            return RBUF_ADD_DUPLICATE;
+        }
+        if (_rbuf_int_overlap_partially(ptr, offset, end)) {
 
             /* "A fresh reassembly may be commenced with the most recently
              * received link fragment"
              * https://tools.ietf.org/html/rfc4944#section-5.3 */
             return RBUF_ADD_REPEAT;
         }
-        /* End was already checked in overlap check */
-        if (ptr->start == offset) {
-            DEBUG("6lo rbuf: fragment already in reassembly buffer\n");
-            return RBUF_ADD_DUPLICATE;
-        }
         ptr = ptr->next;
     }
     return RBUF_ADD_SUCCESS;
@@ -157,29 +184,96 @@ void gnrc_sixlowpan_frag_rb_rm_by_datagram(const gnrc_netif_hdr_t *netif_hdr,
     }
 }
 
-static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
-                                                  uint16_t tag)
+static inline unsigned _rbuf_idx(const gnrc_sixlowpan_frag_rb_t *entry)
 {
-    assert(netif_hdr != NULL);
-    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
-    const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
-    const uint8_t src_len = netif_hdr->src_l2addr_len;
-    const uint8_t dst_len = netif_hdr->dst_l2addr_len;
+    return entry - &rbuf[0];
+}
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
+static inline bool _rbuf_match(const gnrc_sixlowpan_frag_rb_t *e,
+                               const uint8_t *src, size_t src_len,
+                               const uint8_t *dst, size_t dst_len,
+                               size_t size, uint16_t tag)
+{
+    return (e->pkt != NULL) && (e->super.tag == tag) &&
+           ((size == RBUF_ANY_SIZE) || (e->super.datagram_size == size)) &&
+           (e->super.src_len == src_len) &&
+           (e->super.dst_len == dst_len) &&
+           (memcmp(e->super.src, src, src_len) == 0) &&
+           (memcmp(e->super.dst, dst, dst_len) == 0);
+}
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len, uint16_t tag)
+{
+    /* djb2 over source and destination, seeded with the tag */
+    uint32_t hash = 5381U ^ tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = ((hash << 5) + hash) ^ src[i];
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = ((hash << 5) + hash) ^ dst[i];
+    }
+    return hash % CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_HASH_BUCKETS;
+}
 
-        if ((e->pkt != NULL) && (e->super.tag == tag) &&
-            (e->super.src_len == src_len) &&
-            (e->super.dst_len == dst_len) &&
-            (memcmp(e->super.src, src, src_len) == 0) &&
-            (memcmp(e->super.dst, dst, dst_len) == 0)) {
+/* moves entry to the bucket of its current tuple */
+static void _rbuf_hash_link(gnrc_sixlowpan_frag_rb_t *entry)
+{
+    unsigned idx = _rbuf_idx(entry);
+    unsigned bucket = _rbuf_hash(entry->super.src, entry->super.src_len,
+                                 entry->super.dst, entry->super.dst_len,
+                                 entry->super.tag);
+
+    if (rbuf_bucket_of[idx] != 0) {
+        gnrc_sixlowpan_frag_rb_t **ptr = &rbuf_buckets[rbuf_bucket_of[idx] - 1];
+
+        while (*ptr != entry) {
+            ptr = &rbuf_bucket_next[_rbuf_idx(*ptr)];
+        }
+        *ptr = rbuf_bucket_next[idx];
+    }
+    rbuf_bucket_next[idx] = rbuf_buckets[bucket];
+    rbuf_buckets[bucket] = entry;
+    rbuf_bucket_of[idx] = bucket + 1;
+}
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH) */
+
+static gnrc_sixlowpan_frag_rb_t *_rbuf_find(const uint8_t *src, size_t src_len,
+                                            const uint8_t *dst, size_t dst_len,
+                                            size_t size, uint16_t tag)
+{
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+    gnrc_sixlowpan_frag_rb_t *e = rbuf_buckets[_rbuf_hash(src, src_len,
+                                                          dst, dst_len, tag)];
+
+    while (e != NULL) {
+        if (_rbuf_match(e, src, src_len, dst, dst_len, size, tag)) {
             return e;
         }
+        e = rbuf_bucket_next[_rbuf_idx(e)];
+    }
+#else   /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH) */
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if (_rbuf_match(&rbuf[i], src, src_len, dst, dst_len, size, tag)) {
+            return &rbuf[i];
+        }
     }
+#endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH) */
     return NULL;
 }
 
+static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
+                                                  uint16_t tag)
+{
+    assert(netif_hdr != NULL);
+    return _rbuf_find(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                      netif_hdr->src_l2addr_len,
+                      gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                      netif_hdr->dst_l2addr_len, RBUF_ANY_SIZE, tag);
+}
+
 #ifndef NDEBUG
 static bool _valid_offset(gnrc_pktsnip_t *pkt, size_t offset)
 {
@@ -269,6 +363,9 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     if (_rbuf_update_ints(&entry->super, offset, frag_size)) {
         DEBUG("6lo rbuf: add fragment data\n");
         entry->super.current_size += (uint16_t)frag_size;
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
+        rbuf_frags[res]++;
+#endif
         if (offset == 0) {
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
             if (sixlowpan_iphc_is(data)) {
@@ -325,9 +422,16 @@ static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
 
 static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
 {
+    /* continue after the interval handed out last, intervals before it are
+     * likely still in use */
     for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
+        gnrc_sixlowpan_frag_rb_int_t *res = &rbuf_int[rbuf_int_next];
+
+        if (++rbuf_int_next >= RBUF_INT_SIZE) {
+            rbuf_int_next = 0;
+        }
+        if (res->end == 0) { /* start must be smaller than end anyways*/
+            return res;
         }
     }
 
@@ -337,30 +441,55 @@ static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
 static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
                               uint16_t offset, size_t frag_size)
 {
-    gnrc_sixlowpan_frag_rb_int_t *new;
+    gnrc_sixlowpan_frag_rb_int_t *ptr, *lhs = NULL, *rhs = NULL;
     uint16_t end = (uint16_t)(offset + frag_size - 1);
 
-    new = _rbuf_int_get_free();
+    /* _check_fragments() ensured that the fragment does not overlap any
+     * interval, so at most one interval ends right before it and at most one
+     * starts right after it */
+    LL_FOREACH(entry->ints, ptr) {
+        if ((ptr->end + 1U) == offset) {
+            lhs = ptr;
+        }
+        else if (ptr->start == (end + 1U)) {
+            rhs = ptr;
+        }
+    }
 
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+    if ((lhs != NULL) && (rhs != NULL)) {
+        /* fragment closes the gap between two intervals */
+        lhs->end = rhs->end;
+        LL_DELETE(entry->ints, rhs);
+        rhs->start = 0;
+        rhs->end = 0;
+        rhs->next = NULL;
+    }
+    else if (lhs != NULL) {
+        lhs->end = end;
     }
+    else if (rhs != NULL) {
+        rhs->start = offset;
+    }
+    else {
+        gnrc_sixlowpan_frag_rb_int_t *new = _rbuf_int_get_free();
 
-    new->start = offset;
-    new->end = end;
+        if (new == NULL) {
+            DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
+            return false;
+        }
+        new->start = offset;
+        new->end = end;
+        LL_PREPEND(entry->ints, new);
+    }
 
     DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(entry->src,
-                                                       entry->src_len,
-                                                       l2addr_str));
+          offset, end, gnrc_netif_addr_to_str(entry->src, entry->src_len,
+                                              l2addr_str));
     DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst,
                                                   entry->dst_len,
                                                   l2addr_str),
           entry->datagram_size, entry->tag);
 
-    LL_PREPEND(entry->ints, new);
-
     return true;
 }
 
@@ -416,38 +545,33 @@ static int _rbuf_get(const void *src, size_t src_len,
                      size_t size, uint16_t tag,
                      unsigned page)
 {
-    gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
+    gnrc_sixlowpan_frag_rb_t *res, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.datagram_size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+    /* check first if entry already available */
+    res = _rbuf_find(src, src_len, dst, dst_len, size, tag);
+    if (res != NULL) {
+        DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+              gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u) found\n",
+              gnrc_netif_addr_to_str(res->super.dst, res->super.dst_len,
+                                     l2addr_str),
+              (unsigned)res->super.datagram_size, res->super.tag);
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
-            if (rbuf[i].super.current_size == 0) {
-                /* ensure that only empty reassembly buffer entries and entries
-                 * scheduled for deletion have `current_size == 0` */
-                DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
-                return -1;
-            }
-#endif
-            rbuf[i].super.arrival = now_usec;
-            _set_rbuf_timeout();
-            return i;
+        if (res->super.current_size == 0) {
+            /* ensure that only empty reassembly buffer entries and entries
+             * scheduled for deletion have `current_size == 0` */
+            DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
+            return -1;
         }
+#endif
+        res->super.arrival = now_usec;
+        _set_rbuf_timeout();
+        return _rbuf_idx(res);
+    }
 
+    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         /* if there is a free spot: remember it */
         if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
             res = &(rbuf[i]);
@@ -518,6 +642,12 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+    _rbuf_hash_link(res);
+#endif
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
+    rbuf_frags[_rbuf_idx(res)] = 0;
+#endif
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -544,6 +674,11 @@ void gnrc_sixlowpan_frag_rb_reset(void)
         }
     }
     memset(rbuf, 0, sizeof(rbuf));
+    rbuf_int_next = 0;
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB_HASH)
+    memset(rbuf_buckets, 0, sizeof(rbuf_buckets));
+    memset(rbuf_bucket_of, 0, sizeof(rbuf_bucket_of));
+#endif
 }
 
 const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
@@ -584,20 +719,6 @@ static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
 #endif  /* CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER */
 }
 
-#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
-static inline unsigned _count_frags(gnrc_sixlowpan_frag_rb_t *rbuf)
-{
-    unsigned frags = 0;
-    gnrc_sixlowpan_frag_rb_int_t *frag = rbuf->super.ints;
-
-    while (frag) {
-        frag = frag->next;
-        frags++;
-    }
-    return frags;
-}
-#endif
-
 int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf,
                                                    gnrc_netif_hdr_t *netif_hdr)
 {
@@ -629,7 +750,7 @@ int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf
         new_netif_hdr->rssi = netif_hdr->rssi;
         rbuf->pkt = gnrc_pkt_append(rbuf->pkt, netif);
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
-        gnrc_sixlowpan_frag_stats_get()->fragments += _count_frags(rbuf);
+        gnrc_sixlowpan_frag_stats_get()->fragments += rbuf_frags[_rbuf_idx(rbuf)];
         gnrc_sixlowpan_frag_stats_get()->datagrams++;
 #endif
         gnrc_sixlowpan_dispatch_recv(rbuf->pkt, NULL, 0);
@@ -36,6 +36,12 @@ static char _stack[GNRC_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE];
 #endif
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+/* collects packets passed to upper layers while handling a received batch */
+static gnrc_netapi_batch_t _upper_batch;
+static bool _in_batch;
+#endif
+
 
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
@@ -81,6 +87,17 @@ void gnrc_sixlowpan_dispatch_recv(gnrc_pktsnip_t *pkt, void *context,
     /* just assume normal IPv6 traffic */
     type = GNRC_NETTYPE_IPV6;
 #endif  /* MODULE_GNRC_IPV6 */
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    if (_in_batch) {
+        if (!gnrc_netapi_batch_put(&_upper_batch, type,
+                                   GNRC_NETREG_DEMUX_CTX_ALL,
+                                   GNRC_NETAPI_MSG_TYPE_RCV, pkt)) {
+            DEBUG("6lo: No receivers for this packet found\n");
+            gnrc_pktbuf_release(pkt);
+        }
+        return;
+    }
+#endif
     if (!gnrc_netapi_dispatch_receive(type,
                                       GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
         DEBUG("6lo: No receivers for this packet found\n");
@@ -306,11 +323,34 @@ static void _send(gnrc_pktsnip_t *pkt)
     gnrc_sixlowpan_multiplex_by_size(pkt, datagram_size, netif, 0);
 }
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+/* handles GNRC_NETAPI_MSG_TYPE_RCV_BATCH commands */
+static void _receive_batch(gnrc_pktsnip_t *batch)
+{
+    _in_batch = true;
+    for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+        _receive(gnrc_netapi_batch_get(batch, i));
+    }
+    _in_batch = false;
+    gnrc_netapi_batch_flush(&_upper_batch);
+    gnrc_pktbuf_release(batch);
+}
+
+/* handles GNRC_NETAPI_MSG_TYPE_SND_BATCH commands */
+static void _send_batch(gnrc_pktsnip_t *batch)
+{
+    for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+        _send(gnrc_netapi_batch_get(batch, i));
+    }
+    gnrc_pktbuf_release(batch);
+}
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
-    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
-                                                            thread_getpid());
+    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID_BATCH(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                                  thread_getpid());
 
     (void)args;
     msg_init_queue(msg_q, GNRC_SIXLOWPAN_MSG_QUEUE_SIZE);
@@ -337,6 +377,18 @@ static void *_event_loop(void *args)
                 _send(msg.content.ptr);
                 break;
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                _receive_batch(msg.content.ptr);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_SND_BATCH received\n");
+                _send_batch(msg.content.ptr);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("6lo: reply to unsupported get/set\n");
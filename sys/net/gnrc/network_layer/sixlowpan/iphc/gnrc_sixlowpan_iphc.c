@@ -958,55 +958,9 @@ static inline bool _compressible_nh(uint8_t nh)
     }
 }
 
-static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
-                                const gnrc_netif_hdr_t *netif_hdr,
-                                gnrc_netif_t *iface,
-                                uint8_t *iphc_hdr)
+static uint16_t _iphc_tf_nh_hl_encode(const ipv6_hdr_t *ipv6_hdr,
+                                      uint8_t *iphc_hdr, uint16_t inline_pos)
 {
-    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
-    bool addr_comp = false;
-    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
-
-    assert(iface != NULL);
-
-    /* set initial dispatch value*/
-    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
-    iphc_hdr[IPHC2_IDX] = 0;
-
-    /* check for available contexts */
-    if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
-        src_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->src));
-        /* do not use source context for compression if */
-        /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
-        if (src_ctx && !(src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
-            src_ctx = NULL;
-        }
-    }
-
-    if (!ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
-        dst_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->dst));
-        /* do not use destination context for compression if */
-        /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
-        if (dst_ctx && !(dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
-            dst_ctx = NULL;
-        }
-    }
-
-    /* if contexts available and both != 0 */
-    /* since this moves inline_pos we have to do this ahead*/
-    if (((src_ctx != NULL) &&
-            ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) ||
-        ((dst_ctx != NULL) &&
-            ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0))) {
-        /* add context identifier extension */
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
-        iphc_hdr[CID_EXT_IDX] = 0;
-
-        /* move position to behind CID extension */
-        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
-    }
-
     /* compress flow label and traffic class */
     if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
         if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
@@ -1066,6 +1020,172 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
             break;
     }
 
+    return inline_pos;
+}
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+typedef struct {
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    const gnrc_netif_t *iface;
+    uint32_t ctx_gen;
+    uint8_t l2src[GNRC_NETIF_L2ADDR_MAXLEN];
+    uint8_t l2dst[GNRC_NETIF_L2ADDR_MAXLEN];
+    uint8_t l2src_len;
+    uint8_t l2dst_len;
+    uint8_t iphc2;
+    uint8_t cid_ext;
+    uint8_t addr_len;
+    uint8_t addr[2 * sizeof(ipv6_addr_t)];
+} _iphc_cache_t;
+
+static _iphc_cache_t _iphc_cache[CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static unsigned _iphc_cache_next;
+
+static inline uint8_t _iface_l2addr_len(const gnrc_netif_t *iface)
+{
+    return (iface->flags & GNRC_NETIF_FLAGS_HAS_L2ADDR) ? iface->l2addr_len
+                                                        : 0;
+}
+
+static _iphc_cache_t *_iphc_cache_get(const ipv6_hdr_t *ipv6_hdr,
+                                      const gnrc_netif_hdr_t *netif_hdr,
+                                      gnrc_netif_t *iface)
+{
+    _iphc_cache_t *res = NULL;
+
+    gnrc_netif_acquire(iface);
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        _iphc_cache_t *entry = &_iphc_cache[i];
+
+        if ((entry->iface == iface) &&
+            (entry->l2dst_len == netif_hdr->dst_l2addr_len) &&
+            (entry->l2src_len == _iface_l2addr_len(iface)) &&
+            ipv6_addr_equal(&entry->dst, &ipv6_hdr->dst) &&
+            ipv6_addr_equal(&entry->src, &ipv6_hdr->src) &&
+            (memcmp(entry->l2dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                    entry->l2dst_len) == 0) &&
+            (memcmp(entry->l2src, iface->l2addr, entry->l2src_len) == 0)) {
+            res = entry;
+            break;
+        }
+    }
+    gnrc_netif_release(iface);
+    return res;
+}
+
+static void _iphc_cache_put(_iphc_cache_t *entry,
+                            const ipv6_hdr_t *ipv6_hdr,
+                            const gnrc_netif_hdr_t *netif_hdr,
+                            gnrc_netif_t *iface, uint32_t ctx_gen,
+                            const uint8_t *iphc_hdr, uint16_t addr_pos,
+                            uint16_t inline_pos)
+{
+    if (entry == NULL) {
+        /* flows are replaced in the order they were added */
+        entry = &_iphc_cache[_iphc_cache_next];
+        _iphc_cache_next = (_iphc_cache_next + 1) %
+                           CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+        entry->src = ipv6_hdr->src;
+        entry->dst = ipv6_hdr->dst;
+        entry->iface = iface;
+        entry->l2dst_len = netif_hdr->dst_l2addr_len;
+        memcpy(entry->l2dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+               entry->l2dst_len);
+        gnrc_netif_acquire(iface);
+        entry->l2src_len = _iface_l2addr_len(iface);
+        memcpy(entry->l2src, iface->l2addr, entry->l2src_len);
+        gnrc_netif_release(iface);
+    }
+    DEBUG("6lo iphc: caching address compression of flow %p\n",
+          (void *)entry);
+    entry->ctx_gen = ctx_gen;
+    entry->iphc2 = iphc_hdr[IPHC2_IDX];
+    entry->cid_ext = iphc_hdr[CID_EXT_IDX];
+    entry->addr_len = inline_pos - addr_pos;
+    memcpy(entry->addr, iphc_hdr + addr_pos, entry->addr_len);
+}
+
+static uint16_t _iphc_cache_encode(const _iphc_cache_t *entry,
+                                   const ipv6_hdr_t *ipv6_hdr,
+                                   uint8_t *iphc_hdr)
+{
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+
+    iphc_hdr[IPHC2_IDX] = entry->iphc2;
+    if (entry->iphc2 & SIXLOWPAN_IPHC2_CID_EXT) {
+        iphc_hdr[CID_EXT_IDX] = entry->cid_ext;
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+    inline_pos = _iphc_tf_nh_hl_encode(ipv6_hdr, iphc_hdr, inline_pos);
+    memcpy(iphc_hdr + inline_pos, entry->addr, entry->addr_len);
+    return inline_pos + entry->addr_len;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_IPHC_CACHE */
+
+static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
+                                const gnrc_netif_hdr_t *netif_hdr,
+                                gnrc_netif_t *iface,
+                                uint8_t *iphc_hdr)
+{
+    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
+    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
+    bool addr_comp = false;
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+
+    assert(iface != NULL);
+
+    /* set initial dispatch value*/
+    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
+    iphc_hdr[IPHC2_IDX] = 0;
+
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+    uint32_t ctx_gen = gnrc_sixlowpan_ctx_generation();
+    _iphc_cache_t *cached = _iphc_cache_get(ipv6_hdr, netif_hdr, iface);
+
+    if ((cached != NULL) && (cached->ctx_gen == ctx_gen)) {
+        return _iphc_cache_encode(cached, ipv6_hdr, iphc_hdr);
+    }
+#endif
+
+    /* check for available contexts */
+    if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
+        src_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->src));
+        /* do not use source context for compression if */
+        /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
+        if (src_ctx && !(src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
+            src_ctx = NULL;
+        }
+    }
+
+    if (!ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
+        dst_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->dst));
+        /* do not use destination context for compression if */
+        /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
+        if (dst_ctx && !(dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
+            dst_ctx = NULL;
+        }
+    }
+
+    /* if contexts available and both != 0 */
+    /* since this moves inline_pos we have to do this ahead*/
+    if (((src_ctx != NULL) &&
+            ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) ||
+        ((dst_ctx != NULL) &&
+            ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0))) {
+        /* add context identifier extension */
+        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
+        iphc_hdr[CID_EXT_IDX] = 0;
+
+        /* move position to behind CID extension */
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+
+    inline_pos = _iphc_tf_nh_hl_encode(ipv6_hdr, iphc_hdr, inline_pos);
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+    uint16_t addr_pos = inline_pos;
+#endif
+
     if (ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
         iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_UNSPEC;
     }
@@ -1238,6 +1358,10 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
         inline_pos += 16;
     }
 
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE)
+    _iphc_cache_put(cached, ipv6_hdr, netif_hdr, iface, ctx_gen, iphc_hdr,
+                    addr_pos, inline_pos);
+#endif
     return inline_pos;
 }
 
@@ -0,0 +1,491 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer implementation using segregated size classes
+ *
+ * The packet buffer is split into three pools of fixed-size chunks: one for
+ * packet snip descriptors, one for small (header-sized) data and one for
+ * large (MTU-sized) data. Each pool keeps a free list, so allocation and
+ * release are O(1) and the buffer can not fragment beyond the internal
+ * fragmentation of a single chunk.
+ *
+ * Marking a header in a received packet does not move any data: both snips
+ * reference the same chunk, which carries a reference counter and is only
+ * returned to its pool once all parts were released.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "malloc_monitor.h"
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+#include "trace.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT_MASK     (sizeof(uintptr_t) - 1)
+#define _ALIGN(size)        (((size) + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+
+#define _SNIP_CHUNK_SIZE    _ALIGN(sizeof(gnrc_pktsnip_t))
+#define _SNIP_NUMOF         (CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF)
+#define _SMALL_CHUNK_SIZE   _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE)
+#define _SMALL_NUMOF        (CONFIG_GNRC_PKTBUF_SLAB_SMALL_NUMOF)
+#define _LARGE_CHUNK_SIZE   _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE)
+#define _SNIP_POOL_SIZE     (_SNIP_NUMOF * _SNIP_CHUNK_SIZE)
+#define _SMALL_POOL_SIZE    (_SMALL_NUMOF * _SMALL_CHUNK_SIZE)
+#define _LARGE_NUMOF        ((CONFIG_GNRC_PKTBUF_SIZE - _SNIP_POOL_SIZE - \
+                              _SMALL_POOL_SIZE) / _LARGE_CHUNK_SIZE)
+#define _LARGE_POOL_SIZE    (_LARGE_NUMOF * _LARGE_CHUNK_SIZE)
+#define _BUF_SIZE           (_SNIP_POOL_SIZE + _SMALL_POOL_SIZE + \
+                             _LARGE_POOL_SIZE)
+
+static_assert(CONFIG_GNRC_PKTBUF_SIZE > (_SNIP_POOL_SIZE + _SMALL_POOL_SIZE +
+                                         _LARGE_CHUNK_SIZE),
+              "CONFIG_GNRC_PKTBUF_SIZE too small for gnrc_pktbuf_slab "
+              "configuration");
+static_assert(_SMALL_CHUNK_SIZE < _LARGE_CHUNK_SIZE,
+              "CONFIG_GNRC_PKTBUF_SLAB_SMALL_SIZE must be smaller than "
+              "CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE");
+
+enum {
+    _CLASS_SNIP = 0,
+    _CLASS_SMALL,
+    _CLASS_LARGE,
+    _CLASS_NUMOF,
+};
+
+typedef struct _chunk {
+    struct _chunk *next;
+} _chunk_t;
+
+typedef struct {
+    _chunk_t *free;         /**< free list of the size class */
+    uint8_t *start;         /**< first chunk of the size class */
+    uint8_t *refs;          /**< reference counter for each chunk */
+    uint16_t chunk_size;    /**< size of one chunk */
+    uint16_t numof;         /**< number of chunks */
+    uint16_t avail;         /**< number of chunks in the free list */
+#ifdef DEVELHELP
+    uint16_t max_used;      /**< maximum number of chunks used at once */
+#endif
+} _slab_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+/* The static buffer needs to be aligned to word size, so that the chunk start
+ * addresses can be casted to `_chunk_t *` safely. */
+static uintptr_t _pktbuf_buf[_BUF_SIZE / sizeof(uintptr_t)];
+static uint8_t *_pktbuf = (uint8_t *)_pktbuf_buf;
+static uint8_t _snip_refs[_SNIP_NUMOF];
+static uint8_t _small_refs[_SMALL_NUMOF];
+static uint8_t _large_refs[_LARGE_NUMOF];
+static _slab_t _slabs[_CLASS_NUMOF];
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(unsigned cls, size_t size);
+static void _pktbuf_free(void *data);
+
+static inline bool _pktbuf_contains(void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - _pktbuf) < _BUF_SIZE;
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static void _slab_init(_slab_t *slab, uint8_t *start, uint8_t *refs,
+                       uint16_t chunk_size, uint16_t numof)
+{
+    slab->free = NULL;
+    slab->start = start;
+    slab->refs = refs;
+    slab->chunk_size = chunk_size;
+    slab->numof = numof;
+    slab->avail = numof;
+#ifdef DEVELHELP
+    slab->max_used = 0;
+#endif
+    memset(refs, 0, numof);
+    /* build free list backwards so chunks are handed out in address order */
+    for (int i = numof - 1; i >= 0; i--) {
+        _chunk_t *chunk = (_chunk_t *)(uintptr_t)&start[i * chunk_size];
+
+        chunk->next = slab->free;
+        slab->free = chunk;
+    }
+}
+
+/* returns the size class and chunk index of a pointer into the buffer */
+static _slab_t *_get_slab(const void *ptr, unsigned *idx)
+{
+    for (unsigned i = 0; i < _CLASS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        unsigned offset = (uint8_t *)ptr - slab->start;
+
+        if (offset < (unsigned)(slab->numof * slab->chunk_size)) {
+            *idx = offset / slab->chunk_size;
+            return slab;
+        }
+    }
+    return NULL;
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    _slab_init(&_slabs[_CLASS_SNIP], _pktbuf, _snip_refs,
+               _SNIP_CHUNK_SIZE, _SNIP_NUMOF);
+    _slab_init(&_slabs[_CLASS_SMALL], _pktbuf + _SNIP_POOL_SIZE, _small_refs,
+               _SMALL_CHUNK_SIZE, _SMALL_NUMOF);
+    _slab_init(&_slabs[_CLASS_LARGE],
+               _pktbuf + _SNIP_POOL_SIZE + _SMALL_POOL_SIZE, _large_refs,
+               _LARGE_CHUNK_SIZE, _LARGE_NUMOF);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > _LARGE_CHUNK_SIZE) {
+        DEBUG("pktbuf: size (%u) > CONFIG_GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, (unsigned)_LARGE_CHUNK_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(_CLASS_SNIP, sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(marked_snip, pkt->next, pkt->data, size, type);
+    if (pkt->size != size) {
+        /* both snips now reference the same chunk, so it must only be freed
+         * after both were released */
+        unsigned idx;
+        _slab_t *slab = _get_slab(pkt->data, &idx);
+
+        if (slab != NULL) {
+            assert(slab->refs[idx] < UINT8_MAX);
+            slab->refs[idx]++;
+        }
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data);
+        pkt->data = NULL;
+    }
+    /* if new size is bigger than old size */
+    else if (size > pkt->size) {
+        unsigned idx;
+        _slab_t *slab = (pkt->data) ? _get_slab(pkt->data, &idx) : NULL;
+
+        /* grow in place if the chunk is not shared and has enough room */
+        if ((slab == NULL) || (slab->refs[idx] > 1) ||
+            ((size_t)((uint8_t *)pkt->data - slab->start) + size >
+             (size_t)(idx + 1) * slab->chunk_size)) {
+            void *new_data = _pktbuf_alloc(_CLASS_SMALL, size);
+
+            if (new_data == NULL) {
+                DEBUG("pktbuf: error allocating new data section\n");
+                mutex_unlock(&_mutex);
+                return ENOMEM;
+            }
+            if (pkt->data != NULL) {            /* if old data exist */
+                memcpy(new_data, pkt->data, pkt->size);
+                _pktbuf_free(pkt->data);
+            }
+            pkt->data = new_data;
+        }
+    }
+    /* shrinking keeps the data in place, the rest of the chunk is simply
+     * left unused until the chunk is freed */
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pktbuf_contains(pkt));
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _pktbuf_free(pkt->data);
+            _pktbuf_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    static const char *names[] = { "snip", "small", "large" };
+
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&_pktbuf[0], (void *)&_pktbuf[_BUF_SIZE], (unsigned)_BUF_SIZE);
+    for (unsigned i = 0; i < _CLASS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        printf("  %-5s chunks: %4u B x %3u, used: %3u, max. used: %3u\n",
+               names[i], (unsigned)slab->chunk_size, (unsigned)slab->numof,
+               (unsigned)(slab->numof - slab->avail),
+               (unsigned)slab->max_used);
+    }
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _CLASS_NUMOF; i++) {
+        if (_slabs[i].avail != _slabs[i].numof) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall chunk in free list of a class: chunk is inside the class'
+     *    pool, aligned to the chunk size and its reference counter is 0
+     *  - the length of the free list of a class is equal to its `avail` count
+     *  - the number of chunks with reference counter > 0 in a class is
+     *    `numof - avail`
+     */
+    for (unsigned i = 0; i < _CLASS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        unsigned free_count = 0, used_count = 0;
+
+        for (_chunk_t *ptr = slab->free; ptr != NULL; ptr = ptr->next) {
+            unsigned offset = (uint8_t *)ptr - slab->start;
+
+            if ((offset >= (unsigned)(slab->numof * slab->chunk_size)) ||
+                ((offset % slab->chunk_size) != 0) ||
+                (slab->refs[offset / slab->chunk_size] != 0) ||
+                (++free_count > slab->numof)) {
+                return false;
+            }
+        }
+        for (unsigned j = 0; j < slab->numof; j++) {
+            if (slab->refs[j] > 0) {
+                used_count++;
+            }
+        }
+        if ((free_count != slab->avail) ||
+            (used_count != (unsigned)(slab->numof - slab->avail))) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(_CLASS_SNIP, sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(_CLASS_SMALL, size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt);
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+/* Data is allocated starting from _CLASS_SMALL, so that the snip class is
+ * reserved for packet snip descriptors and small payloads can not starve
+ * headers of their descriptors */
+static void *_pktbuf_alloc(unsigned cls, size_t size)
+{
+    /* try the best-fitting size class first and fall back to the larger ones
+     * if it is exhausted */
+    for (unsigned i = cls; i < _CLASS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        _chunk_t *chunk = slab->free;
+
+        if ((size > slab->chunk_size) || (chunk == NULL)) {
+            continue;
+        }
+        slab->free = chunk->next;
+        slab->avail--;
+        slab->refs[((uint8_t *)chunk - slab->start) / slab->chunk_size] = 1;
+#ifdef DEVELHELP
+        if ((slab->numof - slab->avail) > slab->max_used) {
+            slab->max_used = slab->numof - slab->avail;
+        }
+#endif
+        trace_event(TRACE_EVENT_PKTBUF_ALLOC, slab->chunk_size);
+        if (IS_USED(MODULE_MALLOC_MONITOR_PKTBUF)) {
+            malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_PKTBUF, chunk,
+                                        slab->chunk_size);
+        }
+        return chunk;
+    }
+    DEBUG("pktbuf: no space left in packet buffer\n");
+    if (IS_USED(MODULE_MALLOC_MONITOR_PKTBUF)) {
+        malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_PKTBUF, NULL, size);
+    }
+    return NULL;
+}
+
+static void _pktbuf_free(void *data)
+{
+    unsigned idx;
+    _slab_t *slab;
+
+    if (!_pktbuf_contains(data)) {
+        return;
+    }
+    slab = _get_slab(data, &idx);
+    assert(slab != NULL);
+    assert(slab->refs[idx] > 0);
+    if (--slab->refs[idx] == 0) {
+        _chunk_t *chunk = (_chunk_t *)(uintptr_t)&slab->start[idx * slab->chunk_size];
+
+        chunk->next = slab->free;
+        slab->free = chunk;
+        slab->avail++;
+        trace_event(TRACE_EVENT_PKTBUF_FREE, slab->chunk_size);
+        if (IS_USED(MODULE_MALLOC_MONITOR_PKTBUF)) {
+            malloc_monitor_record_free(MALLOC_MONITOR_SRC_PKTBUF, chunk, 0);
+        }
+    }
+}
+
+/** @} */
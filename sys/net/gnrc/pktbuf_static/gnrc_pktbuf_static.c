@@ -23,12 +23,14 @@
 #include <stdio.h>
 #include <sys/types.h>
 
+#include "malloc_monitor.h"
 #include "mutex.h"
 #include "od.h"
 #include "utlist.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
+#include "trace.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -416,6 +418,9 @@ static void *_pktbuf_alloc(size_t size)
     }
     if (ptr == NULL) {
         DEBUG("pktbuf: no space left in packet buffer\n");
+        if (IS_USED(MODULE_MALLOC_MONITOR_PKTBUF)) {
+            malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_PKTBUF, NULL, size);
+        }
         return NULL;
     }
     /* _unused_t struct would fit => add new space at ptr */
@@ -451,6 +456,10 @@ static void *_pktbuf_alloc(size_t size)
         max_byte_count = last_byte;
     }
 #endif
+    trace_event(TRACE_EVENT_PKTBUF_ALLOC, size);
+    if (IS_USED(MODULE_MALLOC_MONITOR_PKTBUF)) {
+        malloc_monitor_record_alloc(MALLOC_MONITOR_SRC_PKTBUF, ptr, size);
+    }
     return (void *)ptr;
 }
 
@@ -476,6 +485,13 @@ static void _pktbuf_free(void *data, size_t size)
     if (!_pktbuf_contains(data)) {
         return;
     }
+    trace_event(TRACE_EVENT_PKTBUF_FREE, _align(size));
+    if (IS_USED(MODULE_MALLOC_MONITOR_PKTBUF)) {
+        /* may release the tail of an allocation only, see
+         * gnrc_pktbuf_realloc_data() */
+        malloc_monitor_record_free(MALLOC_MONITOR_SRC_PKTBUF, data,
+                                   _align(size));
+    }
     while (ptr && (((void *)ptr) < data)) {
         prev = ptr;
         ptr = ptr->next;
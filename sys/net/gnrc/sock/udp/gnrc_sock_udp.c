@@ -30,7 +30,37 @@
 #include "gnrc_sock_internal.h"
 
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
-static sock_udp_t *_udp_socks = NULL;
+#ifdef MODULE_GNRC_NETREG_HASH
+/* bound socks are kept in the buckets of their local port, like the netreg
+ * entries for them */
+#define _UDP_SOCKS_NUMOF    (CONFIG_GNRC_NETREG_HASH_BUCKETS)
+#define _UDP_SOCKS_BUCKET(port) gnrc_netreg_hash(port)
+#else
+#define _UDP_SOCKS_NUMOF    (1U)
+#define _UDP_SOCKS_BUCKET(port) (0U)
+#endif
+
+static sock_udp_t *_udp_socks[_UDP_SOCKS_NUMOF];
+
+static void _udp_socks_add(sock_udp_t *sock)
+{
+    sock_udp_t **head = &_udp_socks[_UDP_SOCKS_BUCKET(sock->local.port)];
+
+    /* prepend to current socks */
+    sock->reg.next = (gnrc_sock_reg_t *)*head;
+    *head = sock;
+}
+
+static void _udp_socks_remove(sock_udp_t *sock)
+{
+    sock_udp_t **head = &_udp_socks[_UDP_SOCKS_BUCKET(sock->local.port)];
+
+    if (*head != NULL) {
+        gnrc_sock_reg_t *reg = (gnrc_sock_reg_t *)*head;
+        LL_DELETE(reg, (gnrc_sock_reg_t *)sock);
+        *head = (sock_udp_t *)reg;
+    }
+}
 #endif
 
 /**
@@ -39,19 +69,19 @@ static sock_udp_t *_udp_socks = NULL;
 static bool _dyn_port_used(uint16_t port)
 {
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
-    for (sock_udp_t *ptr = _udp_socks; ptr != NULL;
+    for (sock_udp_t *ptr = _udp_socks[_UDP_SOCKS_BUCKET(port)]; ptr != NULL;
          ptr = (sock_udp_t *)ptr->reg.next) {
         bool spec_addr = false;
+        if (ptr->local.port != port) {
+            continue;
+        }
         for (unsigned i = 0; i < sizeof(ptr->local.addr); i++) {
             const uint8_t *const p = (uint8_t *)&ptr->local.addr;
             if (p[i] != 0) {
                 spec_addr = true;
             }
         }
-        if (spec_addr) {
-            continue;
-        }
-        if (ptr->local.port == port) {
+        if (!spec_addr) {
             /* port already in use by another sock */
             return true;
         }
@@ -108,19 +138,19 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         }
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
         else if (!(flags & SOCK_FLAGS_REUSE_EP)) {
-            for (sock_udp_t *ptr = _udp_socks; ptr != NULL;
-                 ptr = (sock_udp_t *)ptr->reg.next) {
+            for (sock_udp_t *ptr = _udp_socks[_UDP_SOCKS_BUCKET(port)];
+                 ptr != NULL; ptr = (sock_udp_t *)ptr->reg.next) {
                 if (memcmp(&ptr->local, local, sizeof(sock_udp_ep_t)) == 0) {
                     return -EADDRINUSE;
                 }
             }
         }
-        /* prepend to current socks */
-        sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
-        _udp_socks = sock;
 #endif
         memcpy(&sock->local, local, sizeof(sock_udp_ep_t));
         sock->local.port = port;
+#ifdef MODULE_GNRC_SOCK_CHECK_REUSE
+        _udp_socks_add(sock);
+#endif
     }
     memset(&sock->remote, 0, sizeof(sock_udp_ep_t));
     if (remote != NULL) {
@@ -146,10 +176,7 @@ void sock_udp_close(sock_udp_t *sock)
     assert(sock != NULL);
     gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &sock->reg.entry);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
-    if (_udp_socks != NULL) {
-        gnrc_sock_reg_t *head = (gnrc_sock_reg_t *)_udp_socks;
-        LL_DELETE(head, (gnrc_sock_reg_t *)sock);
-    }
+    _udp_socks_remove(sock);
 #endif
 }
 
@@ -297,9 +324,7 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
             }
             gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, src_port);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
-            /* prepend to current socks */
-            sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
-            _udp_socks = sock;
+            _udp_socks_add(sock);
 #endif /* MODULE_GNRC_SOCK_CHECK_REUSE */
         }
     }
@@ -17,8 +17,10 @@
  * @}
  */
 
+#include <assert.h>
 #include <utlist.h>
 #include <errno.h>
+#include <string.h>
 #include "random.h"
 #include "net/af.h"
 #include "net/gnrc.h"
@@ -43,6 +45,16 @@
  */
 #define TCB_EQUAL(a,b)      ((a) != (b))
 
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#define DUP_ACK_THRESHOLD   (3U)
+
+static_assert(CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE >= 2,
+              "CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE must leave room for a FIN");
+static_assert(!IS_ACTIVE(CONFIG_GNRC_TCP_SACK) || CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE <= 32,
+              "The SACK scoreboard supports at most 32 packets in the retransmit queue");
+
 /**
  * @brief Checks if a given port number is currently used by a TCB as local_port.
  *
@@ -92,15 +104,250 @@ static uint16_t _get_random_local_port(void)
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
+    if (tcb->pkt_retransmit_numof > 0) {
         _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+        for (unsigned i = 0; i < tcb->pkt_retransmit_numof; i++) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+        }
+        tcb->pkt_retransmit_numof = 0;
+        _gnrc_tcp_pkt_clear_sack(tcb);
     }
     TCP_DEBUG_LEAVE;
     return 0;
 }
 
+/**
+ * @brief Copies the payload of a received segment into the receive buffer.
+ *
+ * @param[in,out] tcb    TCB holding the receive buffer.
+ * @param[in]     pkt    Received packet.
+ * @param[in]     skip   Number of payload bytes that were received already.
+ */
+static void _rcv_payload(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t skip)
+{
+    gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UNDEF);
+
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        if (skip < snp->size) {
+            tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), (char *)snp->data + skip,
+                                           snp->size - skip);
+            skip = 0;
+        }
+        else {
+            skip -= snp->size;
+        }
+        snp = snp->next;
+    }
+}
+
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+/**
+ * @brief Get the sequence number of a received segment.
+ *
+ * @param[in] pkt   Received packet.
+ *
+ * @return   Sequence number of @p pkt.
+ */
+static uint32_t _get_seq_num(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+    return byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+}
+
+/**
+ * @brief Releases all out-of-order segments.
+ *
+ * @param[in,out] tcb   TCB holding the out-of-order segments.
+ */
+static void _ooo_clear(gnrc_tcp_tcb_t *tcb)
+{
+    for (unsigned i = 0; i < tcb->pkt_ooo_numof; i++) {
+        gnrc_pktbuf_release(tcb->pkt_ooo[i]);
+    }
+    tcb->pkt_ooo_numof = 0;
+}
+
+/**
+ * @brief Keeps a segment received out of order, sorted by sequence number.
+ *
+ * The segment is dropped if it was kept already or if there is no room left.
+ *
+ * @param[in,out] tcb       TCB holding the out-of-order segments.
+ * @param[in]     pkt       Received packet.
+ * @param[in]     seg_seq   Sequence number of @p pkt.
+ */
+static void _ooo_insert(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seg_seq)
+{
+    unsigned pos = 0;
+
+    if (tcb->pkt_ooo_numof >= CONFIG_GNRC_TCP_SACK_QUEUE_SIZE) {
+        TCP_DEBUG_INFO("Out-of-order queue is full.");
+        return;
+    }
+    while (pos < tcb->pkt_ooo_numof) {
+        uint32_t seq = _get_seq_num(tcb->pkt_ooo[pos]);
+
+        if (seq == seg_seq) {
+            return;
+        }
+        if (LSS_32_BIT(seg_seq, seq)) {
+            break;
+        }
+        pos++;
+    }
+    memmove(&tcb->pkt_ooo[pos + 1], &tcb->pkt_ooo[pos],
+            (tcb->pkt_ooo_numof - pos) * sizeof(tcb->pkt_ooo[0]));
+    gnrc_pktbuf_hold(pkt, 1);
+    tcb->pkt_ooo[pos] = pkt;
+    tcb->pkt_ooo_numof++;
+    tcb->ooo_last_seq = seg_seq;
+}
+
+/**
+ * @brief Moves out-of-order segments, the gap in front of was filled, into
+ *        the receive buffer.
+ *
+ * @param[in,out] tcb   TCB holding the out-of-order segments.
+ */
+static void _ooo_drain(gnrc_tcp_tcb_t *tcb)
+{
+    while (tcb->pkt_ooo_numof > 0) {
+        uint32_t seq = _get_seq_num(tcb->pkt_ooo[0]);
+
+        if (LSS_32_BIT(tcb->rcv_nxt, seq)) {
+            break;
+        }
+        _rcv_payload(tcb, tcb->pkt_ooo[0], tcb->rcv_nxt - seq);
+        gnrc_pktbuf_release(tcb->pkt_ooo[0]);
+        tcb->pkt_ooo_numof--;
+        memmove(&tcb->pkt_ooo[0], &tcb->pkt_ooo[1],
+                tcb->pkt_ooo_numof * sizeof(tcb->pkt_ooo[0]));
+    }
+}
+#endif
+
+/**
+ * @brief Get the sender maximum segment size (SMSS) of a connection.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @return   The smaller one of the local and the peers MSS.
+ */
+static uint32_t _smss(const gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->mss == 0 || tcb->mss > CONFIG_GNRC_TCP_MSS) {
+        return CONFIG_GNRC_TCP_MSS;
+    }
+    return tcb->mss;
+}
+
+/**
+ * @brief Initializes congestion control of an established connection.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _init_congestion_control(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    /* Initial window according to RFC 5681, Section 3.1 */
+    tcb->cwnd = (smss > 2190) ? (2 * smss) : ((smss > 1095) ? (3 * smss) : (4 * smss));
+    tcb->ssthresh = UINT32_MAX;
+    tcb->recover = tcb->iss;
+    tcb->dup_acks = 0;
+    tcb->status &= ~(STATUS_FAST_RECOVERY | STATUS_RTO_RECOVERY);
+}
+
+/**
+ * @brief Congestion control for an ACK acknowledging new data (see RFC 5681 and 6582).
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ * @param[in]     ack     Acknowledgment number of the incoming packet.
+ */
+static void _cc_ack(gnrc_tcp_tcb_t *tcb, uint32_t acked, uint32_t ack)
+{
+    uint32_t smss = _smss(tcb);
+
+    tcb->dup_acks = 0;
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        if (LEQ_32_BIT(tcb->recover, ack)) {
+            /* Full acknowledgment: deflate the window, leave fast recovery */
+            uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+            flight = (flight > smss) ? flight : smss;
+            tcb->cwnd = (tcb->ssthresh < flight + smss) ? tcb->ssthresh : flight + smss;
+            tcb->status &= ~STATUS_FAST_RECOVERY;
+        }
+        else {
+            /* Partial acknowledgment: the next segment got lost as well */
+            _gnrc_tcp_pkt_resend_lost(tcb, false);
+            tcb->cwnd = (tcb->cwnd > acked) ? (tcb->cwnd - acked) : 0;
+            if (acked >= smss) {
+                tcb->cwnd += smss;
+            }
+        }
+        return;
+    }
+    if (tcb->status & STATUS_RTO_RECOVERY) {
+        /* Resend everything that was in flight when the timer expired */
+        if (LSS_32_BIT(ack, tcb->recover)) {
+            _gnrc_tcp_pkt_resend_lost(tcb, false);
+        }
+        else {
+            tcb->status &= ~STATUS_RTO_RECOVERY;
+        }
+    }
+    /* Grow the window only while it limits the transmission */
+    if (tcb->cwnd > tcb->snd_wnd) {
+        return;
+    }
+    if (tcb->cwnd < tcb->ssthresh) {
+        /* Slow start */
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    else {
+        /* Congestion avoidance */
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+}
+
+/**
+ * @brief Congestion control for a duplicate ACK (see RFC 5681 and 6582).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     ack   Acknowledgment number of the incoming packet.
+ */
+static void _cc_dup_ack(gnrc_tcp_tcb_t *tcb, uint32_t ack)
+{
+    uint32_t smss = _smss(tcb);
+
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* Every duplicate ACK signals a segment that left the network */
+        tcb->cwnd += smss;
+        tcb->status |= STATUS_NOTIFY_USER;
+
+        /* Fill further holes the peer reported via SACK */
+        _gnrc_tcp_pkt_resend_lost(tcb, true);
+        return;
+    }
+    /* No fast retransmit for losses of a previous recovery (see RFC 6582) */
+    if (++tcb->dup_acks == DUP_ACK_THRESHOLD &&
+        LEQ_32_BIT(tcb->recover, ack)) {
+        uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+        /* Fast retransmit, enter fast recovery */
+        tcb->ssthresh = (flight / 2 > 2 * smss) ? (flight / 2) : (2 * smss);
+        tcb->recover = tcb->snd_nxt;
+        tcb->cwnd = tcb->ssthresh + DUP_ACK_THRESHOLD * smss;
+        tcb->status |= STATUS_FAST_RECOVERY;
+        tcb->status &= ~STATUS_RTO_RECOVERY;
+        tcb->high_rxt = tcb->snd_una;
+        _gnrc_tcp_pkt_resend_lost(tcb, false);
+    }
+}
+
 /**
  * @brief Restarts timewait timer.
  *
@@ -138,6 +385,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
         case FSM_STATE_CLOSED:
             /* Clear retransmit queue */
             _clear_retransmit(tcb);
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+            _ooo_clear(tcb);
+#endif
 
             /* Remove connection from active connections */
             mutex_lock(&list->lock);
@@ -195,8 +445,12 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
             mutex_unlock(&list->lock);
             break;
 
-        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_ESTABLISHED:
+            _init_congestion_control(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            break;
+
+        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
             break;
@@ -278,27 +532,35 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     TCP_DEBUG_ENTER;
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
-
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
-        /* Calculate segment size */
-        payload = (payload < CONFIG_GNRC_TCP_MSS) ? payload : CONFIG_GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+    uint32_t wnd = (tcb->cwnd < tcb->snd_wnd) ? tcb->cwnd : tcb->snd_wnd;
+    size_t sent = 0;
+
+    /* Send segments while the window is open, keep one queue slot for the FIN */
+    while (sent < len &&
+           tcb->pkt_retransmit_numof < CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE - 1) {
+        uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+        if (flight >= wnd) {
+            break;
+        }
 
         /* Calculate payload size for this segment */
+        size_t payload = wnd - flight;
+        payload = (payload < _smss(tcb)) ? payload : _smss(tcb);
+        payload = (payload < len - sent) ? payload : len - sent;
+
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH,
-                            tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH,
+                                tcb->snd_nxt, tcb->rcv_nxt,
+                                (uint8_t *)buf + sent, payload) < 0) {
+            break;
+        }
         _gnrc_tcp_pkt_setup_retransmit(tcb, out_pkt, false);
         _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
-        TCP_DEBUG_LEAVE;
-        return payload;
+        sent += payload;
     }
     TCP_DEBUG_LEAVE;
-    return 0;
+    return sent;
 }
 
 /**
@@ -442,6 +704,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
 
+    /* The window of SYN segments is never scaled (see RFC 7323) */
+    if (!(ctl & MSK_SYN) && (tcb->status & STATUS_WINDOW_SCALE)) {
+        seg_wnd <<= tcb->snd_wnd_shift;
+    }
+
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
     snp = gnrc_pktsnip_search_type(in_pkt, GNRC_NETTYPE_IPV6);
@@ -671,10 +938,26 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2 || tcb->state == FSM_STATE_CLOSE_WAIT ||
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
+                /* Trust SACK blocks only of acceptable segments acknowledging sent data */
+                if (LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    _gnrc_tcp_option_parse_sack(tcb, tcp_hdr);
+                }
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
+                    _cc_ack(tcb, acked, seg_ack);
+
+                    /* Signal user that the retransmit queue has room again */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK: the peer received a segment out of order */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 &&
+                         !(ctl & MSK_FIN) && seg_wnd == tcb->snd_wnd &&
+                         tcb->pkt_retransmit_numof > 0) {
+                    _cc_dup_ack(tcb, seg_ack);
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -699,25 +982,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionally if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         TCP_DEBUG_LEAVE;
                         return 0;
@@ -733,24 +1016,28 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             /* Check if state is valid for payload receiving */
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2) {
-                /* Search for begin of payload */
-                snp = gnrc_pktsnip_search_type(in_pkt, GNRC_NETTYPE_UNDEF);
-
                 /* Accept only data that is expected, to be received */
                 if (tcb->rcv_nxt == seg_seq) {
                     /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
+                    _rcv_payload(tcb, in_pkt, 0);
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+                    /* Append out-of-order segments that became contiguous */
+                    _ooo_drain(tcb);
+#endif
                     /* Shrink receive window */
                     tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+                /* Keep data behind a gap, the ACK below reports it to the peer */
+                else if (LSS_32_BIT(tcb->rcv_nxt, seg_seq)) {
+                    _ooo_insert(tcb, in_pkt, seg_seq);
+                }
+#endif
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
-                if (!(ctl & MSK_FIN)) {
+                if (!(ctl & MSK_FIN) || LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
                     _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK,
                                         tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
                     _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
@@ -764,6 +1051,16 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 TCP_DEBUG_LEAVE;
                 return 0;
             }
+            /* Process FIN only if all data in front of it was received */
+            if (LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
+                if (pay_len == 0) {
+                    _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt,
+                                        tcb->rcv_nxt, NULL, 0);
+                    _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
+                }
+                TCP_DEBUG_LEAVE;
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt,
@@ -774,7 +1071,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->pkt_retransmit_numof == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -818,9 +1115,29 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
-        _gnrc_tcp_pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->pkt_retransmit_numof > 0) {
+        uint32_t smss = _smss(tcb);
+
+        /* Reduce the slow start threshold only on the first timeout (see RFC 5681) */
+        if (tcb->retries == 0) {
+            uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+            tcb->ssthresh = (flight / 2 > 2 * smss) ? (flight / 2) : (2 * smss);
+        }
+        tcb->cwnd = smss;
+        tcb->dup_acks = 0;
+        tcb->recover = tcb->snd_nxt;
+        tcb->status &= ~STATUS_FAST_RECOVERY;
+        tcb->status |= STATUS_RTO_RECOVERY;
+        tcb->high_rxt = tcb->snd_una;
+
+        /* The peer may have discarded what it reported via SACK (see RFC 2018) */
+        _gnrc_tcp_pkt_clear_sack(tcb);
+
+        _gnrc_tcp_pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
+
+        /* Only timeouts count as retries, fast retransmits are no sign of a dead peer */
+        tcb->retries += 1;
     }
     else {
         TCP_DEBUG_INFO("Retransmission queue is empty.");
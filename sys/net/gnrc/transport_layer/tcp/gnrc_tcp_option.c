@@ -16,13 +16,26 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
 #include "include/gnrc_tcp_common.h"
 #include "include/gnrc_tcp_option.h"
+#include "include/gnrc_tcp_pkt.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
+/**
+ * @brief Parses the options of a TCP header.
+ *
+ * @param[in,out] tcb         TCB holding the connection information.
+ * @param[in]     hdr         TCP header to be parsed.
+ * @param[in]     sack_only   Apply only the SACK blocks of @p hdr if true,
+ *                            everything but the SACK blocks otherwise.
+ *
+ * @returns   Zero on success.
+ *            Negative value on error.
+ */
+static int _parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr, const bool sack_only)
 {
     TCP_DEBUG_ENTER;
     /* Extract offset value. Return if no options are set */
@@ -35,6 +48,13 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
     /* Get pointer to option field and field size */
     uint8_t *opt_ptr = (uint8_t *) hdr + sizeof(tcp_hdr_t);
     uint8_t opt_left = (offset - TCP_HDR_OFFSET_MIN) * 4;
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+
+    /* Window scaling and SACK are negotiated with every SYN */
+    if (!sack_only && (ctl & MSK_SYN)) {
+        tcb->status &= ~(STATUS_WINDOW_SCALE | STATUS_SACK);
+        tcb->snd_wnd_shift = 0;
+    }
 
     /* Parse options via tcp_hdr_opt_t */
     while (opt_left > 0) {
@@ -61,7 +81,59 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                     return -1;
                 }
                 TCP_DEBUG_INFO("MSS option found.");
-                tcb->mss = (option->value[0] << 8) | option->value[1];
+                if (!sack_only) {
+                    tcb->mss = (option->value[0] << 8) | option->value[1];
+                }
+                break;
+
+            case TCP_OPTION_KIND_WS:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_WS) {
+                    TCP_DEBUG_ERROR("Invalid window scale option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("Window scale option found.");
+                if (IS_ACTIVE(CONFIG_GNRC_TCP_WINDOW_SCALE) && !sack_only &&
+                    (ctl & MSK_SYN)) {
+                    tcb->status |= STATUS_WINDOW_SCALE;
+                    tcb->snd_wnd_shift = (option->value[0] < TCP_OPTION_WS_SHIFT_MAX)
+                                       ? option->value[0] : TCP_OPTION_WS_SHIFT_MAX;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    TCP_DEBUG_ERROR("Invalid SACK permitted option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK permitted option found.");
+                if (IS_ACTIVE(CONFIG_GNRC_TCP_SACK) && !sack_only && (ctl & MSK_SYN)) {
+                    tcb->status |= STATUS_SACK;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    ((option->length - TCP_OPTION_LENGTH_MIN) % TCP_OPTION_LENGTH_SACK_BLOCK)) {
+                    TCP_DEBUG_ERROR("Invalid SACK option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK option found.");
+                if (sack_only && (tcb->status & STATUS_SACK)) {
+                    for (uint8_t *blk = option->value; blk < opt_ptr + option->length;
+                         blk += TCP_OPTION_LENGTH_SACK_BLOCK) {
+                        network_uint32_t left, right;
+
+                        memcpy(&left, blk, sizeof(left));
+                        memcpy(&right, blk + sizeof(left), sizeof(right));
+                        _gnrc_tcp_pkt_sack(tcb, byteorder_ntohl(left),
+                                           byteorder_ntohl(right));
+                    }
+                }
                 break;
 
             default:
@@ -83,3 +155,142 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
     TCP_DEBUG_LEAVE;
     return 0;
 }
+
+int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
+{
+    return _parse(tcb, hdr, false);
+}
+
+void _gnrc_tcp_option_parse_sack(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
+{
+    /* The options were validated by _gnrc_tcp_option_parse() */
+    _parse(tcb, hdr, true);
+}
+
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+/**
+ * @brief Maximum number of SACK blocks, next to two NOPs for alignment
+ */
+#define SACK_BLOCKS_MAX ((TCP_OPTION_SPACE_MAX - 4) / TCP_OPTION_LENGTH_SACK_BLOCK)
+
+/**
+ * @brief Get the sequence number range of a received segment.
+ *
+ * @param[in]  pkt     Received packet.
+ * @param[out] right   Sequence number following the payload of @p pkt.
+ *
+ * @returns   Sequence number of the first payload byte of @p pkt.
+ */
+static uint32_t _seg_range(gnrc_pktsnip_t *pkt, uint32_t *right)
+{
+    gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+    uint32_t left = byteorder_ntohl(((tcp_hdr_t *)snp->data)->seq_num);
+
+    *right = left + _gnrc_tcp_pkt_get_pay_len(pkt);
+    return left;
+}
+
+/**
+ * @brief Writes the SACK blocks for the out-of-order segments of a connection.
+ *
+ * The block holding the latest segment is reported first (see RFC 2018).
+ *
+ * @param[in]  tcb    TCB holding the out-of-order segments.
+ * @param[out] opts   Option buffer to write the option to.
+ *
+ * @returns   Size of the option in bytes.
+ */
+static size_t _build_sack(const gnrc_tcp_tcb_t *tcb, uint8_t *opts)
+{
+    uint32_t blocks[SACK_BLOCKS_MAX][2];
+    unsigned numof = 0;
+
+    for (unsigned i = 0; i < tcb->pkt_ooo_numof;) {
+        uint32_t right;
+        uint32_t left = _seg_range(tcb->pkt_ooo[i++], &right);
+
+        /* Merge adjacent and overlapping segments into one block */
+        while (i < tcb->pkt_ooo_numof) {
+            uint32_t next_right;
+            uint32_t next_left = _seg_range(tcb->pkt_ooo[i], &next_right);
+
+            if (LSS_32_BIT(right, next_left)) {
+                break;
+            }
+            if (LSS_32_BIT(right, next_right)) {
+                right = next_right;
+            }
+            i++;
+        }
+
+        if (LEQ_32_BIT(left, tcb->ooo_last_seq) && LSS_32_BIT(tcb->ooo_last_seq, right)) {
+            /* Move the block of the latest segment to the front */
+            if (numof == SACK_BLOCKS_MAX) {
+                numof--;
+            }
+            memmove(&blocks[1], &blocks[0], numof * sizeof(blocks[0]));
+            blocks[0][0] = left;
+            blocks[0][1] = right;
+            numof++;
+        }
+        else if (numof < SACK_BLOCKS_MAX) {
+            blocks[numof][0] = left;
+            blocks[numof][1] = right;
+            numof++;
+        }
+    }
+
+    /* Two NOPs align the blocks to four bytes */
+    opts[0] = TCP_OPTION_KIND_NOP;
+    opts[1] = TCP_OPTION_KIND_NOP;
+    opts[2] = TCP_OPTION_KIND_SACK;
+    opts[3] = TCP_OPTION_LENGTH_MIN + numof * TCP_OPTION_LENGTH_SACK_BLOCK;
+    for (unsigned i = 0; i < numof; i++) {
+        network_uint32_t edges[2] = { byteorder_htonl(blocks[i][0]),
+                                      byteorder_htonl(blocks[i][1]) };
+
+        memcpy(&opts[4 + i * TCP_OPTION_LENGTH_SACK_BLOCK], edges, sizeof(edges));
+    }
+    return 4 + numof * TCP_OPTION_LENGTH_SACK_BLOCK;
+}
+#endif
+
+size_t _gnrc_tcp_option_build(const gnrc_tcp_tcb_t *tcb, uint16_t ctl,
+                              uint8_t *opts)
+{
+    TCP_DEBUG_ENTER;
+    size_t len = 0;
+
+    if (ctl & MSK_SYN) {
+        network_uint32_t mss_option = byteorder_htonl(
+            _gnrc_tcp_option_build_mss(CONFIG_GNRC_TCP_MSS));
+
+        memcpy(opts, &mss_option, sizeof(mss_option));
+        len += sizeof(mss_option);
+
+        /* Offer window scaling, or accept the peers offer */
+        if (IS_ACTIVE(CONFIG_GNRC_TCP_WINDOW_SCALE) &&
+            (!(ctl & MSK_ACK) || (tcb->status & STATUS_WINDOW_SCALE))) {
+            opts[len++] = TCP_OPTION_KIND_NOP;
+            opts[len++] = TCP_OPTION_KIND_WS;
+            opts[len++] = TCP_OPTION_LENGTH_WS;
+            opts[len++] = _gnrc_tcp_option_rcv_wnd_shift();
+        }
+        /* Offer SACK, or accept the peers offer */
+        if (IS_ACTIVE(CONFIG_GNRC_TCP_SACK) &&
+            (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK))) {
+            opts[len++] = TCP_OPTION_KIND_NOP;
+            opts[len++] = TCP_OPTION_KIND_NOP;
+            opts[len++] = TCP_OPTION_KIND_SACK_PERM;
+            opts[len++] = TCP_OPTION_LENGTH_SACK_PERM;
+        }
+    }
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+    else if ((ctl & MSK_ACK) && !(ctl & MSK_RST) && (tcb->status & STATUS_SACK) &&
+             tcb->pkt_ooo_numof > 0) {
+        len += _build_sack(tcb, opts);
+    }
+#endif
+    TCP_DEBUG_LEAVE;
+    return len;
+}
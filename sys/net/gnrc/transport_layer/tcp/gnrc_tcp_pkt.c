@@ -49,6 +49,82 @@ static inline uint32_t _max(const uint32_t x, const uint32_t y)
   return (x > y) ? x : y;
 }
 
+/**
+ * @brief Calculates the receive window to advertise in an outgoing segment.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ * @param[in] ctl   Control bits of the outgoing segment.
+ *
+ * @returns   Value of the window field, scaled if window scaling is in use.
+ */
+static uint16_t _adv_wnd(const gnrc_tcp_tcb_t *tcb, const uint16_t ctl)
+{
+    uint32_t wnd = tcb->rcv_wnd;
+
+    /* The window of SYN segments is never scaled (see RFC 7323) */
+    if (!(ctl & MSK_SYN) && (tcb->status & STATUS_WINDOW_SCALE)) {
+        wnd >>= _gnrc_tcp_option_rcv_wnd_shift();
+    }
+    return (wnd > UINT16_MAX) ? UINT16_MAX : wnd;
+}
+
+/**
+ * @brief Get the sequence number range of a packet in the retransmit queue.
+ *
+ * @param[in]  pkt   Packet in the retransmit queue.
+ * @param[out] end   Sequence number following the segment.
+ *
+ * @returns   Sequence number of the segment.
+ */
+static uint32_t _seq_range(gnrc_pktsnip_t *pkt, uint32_t *end)
+{
+    gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+    uint32_t seq = byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+
+    *end = seq + _gnrc_tcp_pkt_get_seg_len(pkt);
+    return seq;
+}
+
+/**
+ * @brief Updates the retransmission timeout of a connection (see RFC 6298).
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     backoff   Double the current timeout instead of deriving
+ *                          it from the round trip time estimation.
+ */
+static void _set_rto(gnrc_tcp_tcb_t *tcb, const bool backoff)
+{
+    if (!backoff) {
+        /* If there is no round trip time sample: rto is 1 sec (Lower Bound) */
+        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+            tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+        }
+        else {
+            tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
+                                        CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+        }
+    }
+    else {
+        /* If this is a retransmission: Double the rto (Timer Backoff) */
+        tcb->rto *= 2;
+
+        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
+        /* New measurements must be taken the next time something is sent. */
+        if (tcb->retries >= 5) {
+            tcb->srtt = RTO_UNINITIALIZED;
+            tcb->rtt_var = RTO_UNINITIALIZED;
+        }
+    }
+
+    /* Perform boundary checks on current RTO before usage */
+    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+    }
+    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+    }
+}
+
 int _gnrc_tcp_pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt,
                                        gnrc_pktsnip_t *in_pkt)
 {
@@ -155,6 +231,8 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
     gnrc_pktsnip_t *tcp_snp = NULL;
     tcp_hdr_t tcp_hdr;
     uint8_t offset = TCP_HDR_OFFSET_MIN;
+    uint8_t opts[TCP_OPTION_SPACE_MAX];
+    size_t opts_len;
 
     /* Add payload, if supplied */
     if (payload != NULL && payload_len > 0) {
@@ -173,14 +251,12 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
+    tcp_hdr.window = byteorder_htons(_adv_wnd(tcb, ctl));
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
     /* Calculate option field size. */
-    /* Add MSS option if SYN is sent */
-    if (ctl & MSK_SYN) {
-        offset += 1;
-    }
+    opts_len = _gnrc_tcp_option_build(tcb, ctl, opts);
+    offset += opts_len / sizeof(network_uint32_t);
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(
         _gnrc_tcp_option_build_offset_control(offset, ctl));
@@ -205,21 +281,7 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
 
         /* Add options if existing */
         if (TCP_HDR_OFFSET_MIN < offset) {
-            uint8_t *opt_ptr = (uint8_t *) tcp_snp->data + sizeof(tcp_hdr);
-            uint8_t opt_left = (offset - TCP_HDR_OFFSET_MIN) * sizeof(network_uint32_t);
-
-            /* Init options field with 'End Of List' - option (0) */
-            memset(opt_ptr, TCP_OPTION_KIND_EOL, opt_left);
-
-            /* If SYN flag is set: Add MSS option */
-            if (ctl & MSK_SYN) {
-                network_uint32_t mss_option = byteorder_htonl(
-                    _gnrc_tcp_option_build_mss(CONFIG_GNRC_TCP_MSS));
-
-                memcpy(opt_ptr, &mss_option, sizeof(mss_option));
-            }
-            /* Increase opt_ptr and decrease opt_left, if other options are added */
-            /* NOTE: Add additional options here */
+            memcpy((uint8_t *) tcp_snp->data + sizeof(tcp_hdr), opts, opts_len);
         }
         *(out_pkt) = tcp_snp;
     }
@@ -287,12 +349,17 @@ int _gnrc_tcp_pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt,
 
     /* If this is no retransmission, advance sequence number and measure time */
     if (!retransmit) {
-        tcb->retries = 0;
+        /* Time one segment per round trip, the one sent while no measurement is running */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_PENDING)) {
+            tcb->status |= STATUS_RTT_PENDING;
+            tcb->rtt_seq = tcb->snd_nxt + seq_con;
+            tcb->rtt_start = evtimer_now_msec();
+        }
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = evtimer_now_msec();
     }
     else {
-        tcb->retries += 1;
+        /* Retransmissions make the measurement ambiguous (Karns Algorithm) */
+        tcb->status &= ~STATUS_RTT_PENDING;
     }
 
     /* Pass packet down the network stack */
@@ -390,13 +457,6 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        TCP_DEBUG_ERROR("-ENOMEM: Retransmit queue is full.");
-        TCP_DEBUG_LEAVE;
-        return -ENOMEM;
-    }
-
     /* Extract control bits and segment length */
     snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
     ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
@@ -408,42 +468,27 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
-    gnrc_pktbuf_hold(pkt, 1);
-
-    /* RTO adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
-                                        CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+        /* Check if retransmit queue is full */
+        if (tcb->pkt_retransmit_numof >= CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+            TCP_DEBUG_ERROR("-ENOMEM: Retransmit queue is full.");
+            TCP_DEBUG_LEAVE;
+            return -ENOMEM;
         }
+        tcb->pkt_retransmit[tcb->pkt_retransmit_numof++] = pkt;
     }
-    else {
-        /* If this is a retransmission: Double the rto (Timer Backoff) */
-        tcb->rto *= 2;
 
-        /* If the transmission has been tried five times, we assume srtt and rtt_var are bogus */
-        /* New measurements must be taken the next time something is sent. */
-        if (tcb->retries >= 5) {
-            tcb->srtt = RTO_UNINITIALIZED;
-            tcb->rtt_var = RTO_UNINITIALIZED;
-        }
-    }
+    /* Increase users: every send attempt consumes a user */
+    gnrc_pktbuf_hold(pkt, 1);
 
-    /* Perform boundary checks on current RTO before usage */
-    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
-    }
-    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+    /* The timer is already running for the packets in front of this one */
+    if (!retransmit && tcb->pkt_retransmit_numof > 1) {
+        TCP_DEBUG_LEAVE;
+        return 0;
     }
 
     /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    _set_rto(tcb, retransmit);
     _gnrc_tcp_eventloop_sched(&tcb->event_retransmit, tcb->rto,
                               MSG_TYPE_RETRANSMISSION, tcb);
     TCP_DEBUG_LEAVE;
@@ -454,34 +499,45 @@ int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
     TCP_DEBUG_ENTER;
     uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    uint8_t acked = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->pkt_retransmit_numof == 0) {
         TCP_DEBUG_ERROR("-ENODATA: No packet to acknowledge.");
         TCP_DEBUG_LEAVE;
         return -ENODATA;
     }
 
-    snp = gnrc_pktsnip_search_type(tcb->pkt_retransmit, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _gnrc_tcp_pkt_get_seg_len(
-        tcb->pkt_retransmit) - 1;
+    /* Release all packets that are covered by the cumulative acknowledgment */
+    while (acked < tcb->pkt_retransmit_numof) {
+        _seq_range(tcb->pkt_retransmit[acked], &seg);
+        if (!LEQ_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(tcb->pkt_retransmit[acked]);
+        acked++;
+    }
 
-        /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+    if (acked == 0) {
+        TCP_DEBUG_LEAVE;
+        return 0;
+    }
+    tcb->pkt_retransmit_numof -= acked;
+    memmove(&tcb->pkt_retransmit[0], &tcb->pkt_retransmit[acked],
+            tcb->pkt_retransmit_numof * sizeof(tcb->pkt_retransmit[0]));
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+    tcb->pkt_retransmit_sacked >>= acked;
+#endif
+    tcb->retries = 0;
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_PENDING) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = evtimer_now_msec() - tcb->rtt_start;
 
-        /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_PENDING;
+
+        /* Use time only if there was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -496,10 +552,82 @@ int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* Stop timer if everything was acknowledged, restart it for the remaining packets otherwise */
+    _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
+    if (tcb->pkt_retransmit_numof > 0) {
+        _set_rto(tcb, false);
+        _gnrc_tcp_eventloop_sched(&tcb->event_retransmit, tcb->rto,
+                                  MSG_TYPE_RETRANSMISSION, tcb);
+    }
     TCP_DEBUG_LEAVE;
     return 0;
 }
 
+void _gnrc_tcp_pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left,
+                        const uint32_t right)
+{
+    TCP_DEBUG_ENTER;
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+    for (unsigned i = 0; i < tcb->pkt_retransmit_numof; i++) {
+        uint32_t end;
+        uint32_t seq = _seq_range(tcb->pkt_retransmit[i], &end);
+
+        if (LEQ_32_BIT(left, seq) && LEQ_32_BIT(end, right)) {
+            tcb->pkt_retransmit_sacked |= (1UL << i);
+        }
+    }
+#else
+    (void)tcb;
+    (void)left;
+    (void)right;
+#endif
+    TCP_DEBUG_LEAVE;
+}
+
+void _gnrc_tcp_pkt_clear_sack(gnrc_tcp_tcb_t *tcb)
+{
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+    tcb->pkt_retransmit_sacked = 0;
+#else
+    (void)tcb;
+#endif
+}
+
+int _gnrc_tcp_pkt_resend_lost(gnrc_tcp_tcb_t *tcb, const bool holes_only)
+{
+    TCP_DEBUG_ENTER;
+    uint32_t sacked = 0;
+
+#if IS_ACTIVE(CONFIG_GNRC_TCP_SACK)
+    sacked = tcb->pkt_retransmit_sacked;
+#endif
+    for (unsigned i = 0; i < tcb->pkt_retransmit_numof; i++) {
+        gnrc_pktsnip_t *pkt = tcb->pkt_retransmit[i];
+        uint32_t end;
+
+        _seq_range(pkt, &end);
+
+        /* Skip packets the peer has or that were retransmitted already */
+        if ((sacked & (1UL << i)) || LEQ_32_BIT(end, tcb->high_rxt)) {
+            continue;
+        }
+        /* A hole is a packet in front of a selectively acknowledged one */
+        if (holes_only && (sacked >> i) == 0) {
+            break;
+        }
+        tcb->high_rxt = end;
+
+        /* Increase users: every send attempt consumes a user */
+        gnrc_pktbuf_hold(pkt, 1);
+        _gnrc_tcp_pkt_send(tcb, pkt, 0, true);
+        TCP_DEBUG_LEAVE;
+        return 0;
+    }
+    TCP_DEBUG_LEAVE;
+    return -ENODATA;
+}
+
 uint16_t _gnrc_tcp_pkt_calc_csum(const gnrc_pktsnip_t *hdr,
                                  const gnrc_pktsnip_t *pseudo_hdr,
                                  const gnrc_pktsnip_t *payload)
@@ -56,9 +56,29 @@ static inline uint16_t _gnrc_tcp_option_build_offset_control(uint16_t nopts, uin
     return (nopts << 12) | ctl;
 }
 
+/**
+ * @brief Helper function to get the shift count of the local receive window.
+ *
+ * @returns   Smallest shift count that fits the receive buffer into the
+ *            16 bit window field of the TCP header.
+ */
+static inline uint8_t _gnrc_tcp_option_rcv_wnd_shift(void)
+{
+    uint8_t shift = 0;
+
+    while (((uint32_t)GNRC_TCP_RCV_BUF_SIZE >> shift) > UINT16_MAX &&
+           shift < TCP_OPTION_WS_SHIFT_MAX) {
+        shift++;
+    }
+    return shift;
+}
+
 /**
  * @brief Parses options of a given TCP header.
  *
+ * Window scale and SACK permitted options are only accepted on SYN segments.
+ * SACK blocks are ignored, see _gnrc_tcp_option_parse_sack().
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     hdr   TCP header to be parsed.
  *
@@ -67,6 +87,34 @@ static inline uint16_t _gnrc_tcp_option_build_offset_control(uint16_t nopts, uin
  */
 int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr);
 
+/**
+ * @brief Applies the SACK blocks of a given TCP header.
+ *
+ * SACK blocks mark the covered packets in the retransmit queue of @p tcb.
+ * Call this only for segments that passed the acceptability check and
+ * whose options were parsed by _gnrc_tcp_option_parse().
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     hdr   TCP header to be parsed.
+ */
+void _gnrc_tcp_option_parse_sack(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr);
+
+/**
+ * @brief Builds the options of an outgoing TCP segment.
+ *
+ * SYN segments carry the MSS option and offer window scaling and SACK, if
+ * enabled. A SYN+ACK only agrees on what the peer offered. Other segments
+ * carry SACK blocks for the out-of-order segments received.
+ *
+ * @param[in]  tcb    TCB holding the connection information.
+ * @param[in]  ctl    Control bits of the outgoing segment.
+ * @param[out] opts   Buffer of at least TCP_OPTION_SPACE_MAX bytes.
+ *
+ * @returns   Size of the options in bytes, always a multiple of four.
+ */
+size_t _gnrc_tcp_option_build(const gnrc_tcp_tcb_t *tcb, uint16_t ctl,
+                              uint8_t *opts);
+
 #ifdef __cplusplus
 }
 #endif
@@ -123,7 +123,10 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
                                    const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
+ *
+ * All packets covered by the cumulative acknowledgment @p ack are released.
+ * The retransmission timer is restarted if packets remain in the queue.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -133,6 +136,39 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
  */
 int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+/**
+ * @brief Marks packets of the retransmission queue as selectively acknowledged.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    Left edge of the SACK block.
+ * @param[in]     right   Right edge of the SACK block.
+ */
+void _gnrc_tcp_pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left,
+                        const uint32_t right);
+
+/**
+ * @brief Forgets all selective acknowledgments of the retransmission queue.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _gnrc_tcp_pkt_clear_sack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Retransmits the oldest packet considered lost.
+ *
+ * That is the oldest packet in the retransmission queue, which was neither
+ * selectively acknowledged nor retransmitted since tcb->high_rxt was set.
+ * The retransmission timer is not touched.
+ *
+ * @param[in,out] tcb          TCB holding the connection information.
+ * @param[in]     holes_only   Only retransmit a packet, if a later one was
+ *                             selectively acknowledged.
+ *
+ * @returns   Zero if a packet was retransmitted.
+ *            -ENODATA if there is no packet to retransmit.
+ */
+int _gnrc_tcp_pkt_resend_lost(gnrc_tcp_tcb_t *tcb, const bool holes_only);
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
@@ -220,13 +220,31 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+static void _receive_batch(gnrc_pktsnip_t *batch)
+{
+    for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+        _receive(gnrc_netapi_batch_get(batch, i));
+    }
+    gnrc_pktbuf_release(batch);
+}
+
+static void _send_batch(gnrc_pktsnip_t *batch)
+{
+    for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+        _send(gnrc_netapi_batch_get(batch, i));
+    }
+    gnrc_pktbuf_release(batch);
+}
+#endif
+
 static void *_event_loop(void *arg)
 {
     (void)arg;
     msg_t msg, reply;
     msg_t msg_queue[GNRC_UDP_MSG_QUEUE_SIZE];
-    gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
-                                                            thread_getpid());
+    gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_PID_BATCH(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                                  thread_getpid());
     /* preset reply message */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
     reply.content.value = (uint32_t)-ENOTSUP;
@@ -247,6 +265,16 @@ static void *_event_loop(void *arg)
                 DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
                 _send(msg.content.ptr);
                 break;
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV_BATCH\n");
+                _receive_batch(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND_BATCH\n");
+                _send_batch(msg.content.ptr);
+                break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_SET:
             case GNRC_NETAPI_MSG_TYPE_GET:
                 msg_reply(&msg, &reply);
@@ -65,6 +65,307 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+#ifdef MODULE_FIB_INDEX
+/**
+ * @brief hashes the first @p len bytes of @p addr (FNV-1a) into a bucket
+ */
+static unsigned fib_index_hash(const uint8_t *addr, size_t len, uint32_t salt)
+{
+    uint32_t hash = 2166136261U ^ salt;
+
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ addr[i]) * 16777619U;
+    }
+    return hash % CONFIG_FIB_INDEX_BUCKETS;
+}
+
+static bool fib_index_is_all_zeros(universal_address_container_t *addr)
+{
+    for (size_t i = 0; i < addr->address_size; i++) {
+        if (addr->address[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief returns the number of leading bytes a destination must share with
+ *        the address of a prefix entry to be matched by it
+ *
+ * universal_address_compare() reports at most 7 matching bits within the
+ * first distinct byte, so a prefix of n bits can only match destinations
+ * sharing its first n / 8 bytes. The result is capped to fit
+ * fib_table_t::pfx_index_keys, comparing fewer bytes is still safe.
+ *
+ * @return the number of leading bytes
+ * @return -1 if the entry can only ever be matched exactly
+ */
+static int fib_index_pfx_key(fib_entry_t *entry)
+{
+    size_t prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                        >> FIB_FLAG_NET_PREFIX_SHIFT;
+
+    if ((prefix_len == 0) ||
+        (prefix_len >= (size_t)(entry->global->address_size << 3))) {
+        return -1;
+    }
+    prefix_len >>= 3;
+    return (prefix_len < 32) ? (int)prefix_len : 31;
+}
+
+/**
+ * @brief returns the head of the default route or prefix list @p entry
+ *        belongs to, or NULL if it is in neither
+ */
+static fib_entry_t **fib_index_pfx_list(fib_table_t *table, fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    int key;
+
+    if (fib_index_is_all_zeros(global)) {
+        return &table->default_routes;
+    }
+    if ((key = fib_index_pfx_key(entry)) < 0) {
+        return NULL;
+    }
+    table->pfx_index_keys |= (1UL << key);
+    return &table->pfx_index[fib_index_hash(global->address, key,
+                                            (global->address_size << 8) | key)];
+}
+
+static void fib_index_init(fib_table_t *table)
+{
+    memset(table->addr_index, 0, sizeof(table->addr_index));
+    memset(table->pfx_index, 0, sizeof(table->pfx_index));
+    table->default_routes = NULL;
+    table->pfx_index_keys = 0;
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+}
+
+static inline void fib_index_lifetime(fib_table_t *table, fib_entry_t *entry)
+{
+    if (entry->lifetime < table->next_expiry) {
+        table->next_expiry = entry->lifetime;
+    }
+}
+
+/* both lists are kept in table order, so the first usable entry of a list is
+ * also the one the linear search would find first */
+static void fib_index_add(fib_table_t *table, fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    fib_entry_t **ptr;
+
+    fib_index_lifetime(table, entry);
+    if (global == NULL) {
+        return;
+    }
+    ptr = &table->addr_index[fib_index_hash(global->address,
+                                            global->address_size,
+                                            global->address_size)];
+    while ((*ptr != NULL) && (*ptr < entry)) {
+        ptr = &(*ptr)->addr_next;
+    }
+    entry->addr_next = *ptr;
+    *ptr = entry;
+    if ((ptr = fib_index_pfx_list(table, entry)) != NULL) {
+        while ((*ptr != NULL) && (*ptr < entry)) {
+            ptr = &(*ptr)->pfx_next;
+        }
+        entry->pfx_next = *ptr;
+        *ptr = entry;
+    }
+}
+
+static void fib_index_del(fib_table_t *table, fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    fib_entry_t **ptr;
+
+    if (global == NULL) {
+        return;
+    }
+    ptr = &table->addr_index[fib_index_hash(global->address,
+                                            global->address_size,
+                                            global->address_size)];
+    while ((*ptr != NULL) && (*ptr != entry)) {
+        ptr = &(*ptr)->addr_next;
+    }
+    if (*ptr != NULL) {
+        *ptr = entry->addr_next;
+    }
+    if ((ptr = fib_index_pfx_list(table, entry)) != NULL) {
+        while ((*ptr != NULL) && (*ptr != entry)) {
+            ptr = &(*ptr)->pfx_next;
+        }
+        if (*ptr != NULL) {
+            *ptr = entry->pfx_next;
+        }
+    }
+    entry->addr_next = NULL;
+    entry->pfx_next = NULL;
+}
+#else
+static inline void fib_index_init(fib_table_t *table)
+{
+    (void)table;
+}
+
+static inline void fib_index_lifetime(fib_table_t *table, fib_entry_t *entry)
+{
+    (void)table;
+    (void)entry;
+}
+
+static inline void fib_index_add(fib_table_t *table, fib_entry_t *entry)
+{
+    (void)table;
+    (void)entry;
+}
+
+static inline void fib_index_del(fib_table_t *table, fib_entry_t *entry)
+{
+    (void)table;
+    (void)entry;
+}
+#endif
+
+/**
+ * @brief removes the given entry
+ *
+ * @param[in] table the FIB table the entry is part of
+ * @param[in] entry the entry to be removed
+ *
+ * @return 0 on success
+ */
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_index_del(table, entry);
+
+    if (entry->global != NULL) {
+        universal_address_rem(entry->global);
+    }
+
+    if (entry->next_hop) {
+        universal_address_rem(entry->next_hop);
+    }
+
+    entry->global = NULL;
+    entry->global_flags = 0;
+    entry->next_hop = NULL;
+    entry->next_hop_flags = 0;
+
+    entry->iface_id = KERNEL_PID_UNDEF;
+    entry->lifetime = 0;
+
+    return 0;
+}
+
+#ifdef MODULE_FIB_INDEX
+/**
+ * @brief removes all expired entries, but only if the earliest lifetime in
+ *        the table has passed
+ *
+ * @param[in] table  the FIB table
+ * @param[in] now    the current time
+ */
+static void fib_index_expire(fib_table_t *table, uint64_t now)
+{
+    if (table->next_expiry >= now) {
+        return;
+    }
+    DEBUG("[fib_index_expire] sweeping table\n");
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+    /* also drop the prefix lengths of removed entries from the bitmap */
+    table->pfx_index_keys = 0;
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        if ((entry->lifetime != FIB_LIFETIME_NO_EXPIRE) &&
+            (entry->lifetime < now)) {
+            fib_remove(table, entry);
+        }
+        else if (entry->global != NULL) {
+            fib_index_lifetime(table, entry);
+            fib_index_pfx_list(table, entry);
+        }
+    }
+}
+
+/**
+ * @brief index based implementation of fib_find_entry()
+ *
+ * Yields the same entry as the linear search: an exact match wins, then the
+ * prefix entry with the most matching bits as counted by
+ * universal_address_compare() and first in the table on ties, then the last
+ * default route in the table.
+ */
+static int fib_index_find(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                          fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    fib_entry_t *res = NULL;
+    size_t prefix_size = 0;
+
+    fib_index_expire(table, xtimer_now_usec64());
+    *entry_arr_size = 0;
+    if (dst_size == 0) {
+        return -EHOSTUNREACH;
+    }
+
+    for (fib_entry_t *entry = table->addr_index[fib_index_hash(dst, dst_size,
+                                                               dst_size)];
+         entry != NULL; entry = entry->addr_next) {
+        if ((entry->global->address_size == dst_size) &&
+            (memcmp(entry->global->address, dst, dst_size) == 0)) {
+            entry_arr[0] = entry;
+            *entry_arr_size = 1;
+            return 1;
+        }
+    }
+
+    for (int key = 0; (key < 32) && ((size_t)key < dst_size); key++) {
+        if (!(table->pfx_index_keys & (1UL << key))) {
+            continue;
+        }
+        for (fib_entry_t *entry = table->pfx_index[
+                 fib_index_hash(dst, key, (dst_size << 8) | key)];
+             entry != NULL; entry = entry->pfx_next) {
+            size_t match_size = dst_size << 3;
+
+            if ((fib_index_pfx_key(entry) != key) ||
+                (universal_address_compare(entry->global, dst, &match_size)
+                 != UNIVERSAL_ADDRESS_MATCHING_PREFIX)) {
+                continue;
+            }
+            if ((match_size >= ((entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                                >> FIB_FLAG_NET_PREFIX_SHIFT)) &&
+                ((res == NULL) || (match_size > prefix_size) ||
+                 ((match_size == prefix_size) && (entry < res)))) {
+                res = entry;
+                prefix_size = match_size;
+            }
+        }
+    }
+
+    if (res == NULL) {
+        /* default routes are only taken if there is no better one */
+        for (fib_entry_t *entry = table->default_routes; entry != NULL;
+             entry = entry->pfx_next) {
+            if (entry->global->address_size == dst_size) {
+                res = entry;
+            }
+        }
+    }
+    if (res == NULL) {
+        return -EHOSTUNREACH;
+    }
+    entry_arr[0] = res;
+    *entry_arr_size = 1;
+    return 0;
+}
+#endif
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -81,6 +382,9 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
+#ifdef MODULE_FIB_INDEX
+    return fib_index_find(table, dst, dst_size, entry_arr, entry_arr_size);
+#else
     uint64_t now = xtimer_now_usec64();
 
     size_t count = 0;
@@ -187,11 +491,13 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
     *entry_arr_size = count;
     return ret;
+#endif
 }
 
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table the entry is part of
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,7 +507,8 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry,
+                         uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
@@ -221,6 +528,7 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
     else {
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
     }
+    fib_index_lifetime(table, entry);
 
     return 0;
 }
@@ -267,43 +575,18 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                 else {
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
+                fib_index_add(table, &table->data.entries[i]);
 
                 return 0;
             }
+            /* let the next lookup clean up this incomplete entry */
+            fib_index_lifetime(table, &table->data.entries[i]);
         }
     }
 
     return -ENOMEM;
 }
 
-/**
- * @brief removes the given entry
- *
- * @param[in] entry the entry to be removed
- *
- * @return 0 on success
- */
-static int fib_remove(fib_entry_t *entry)
-{
-    if (entry->global != NULL) {
-        universal_address_rem(entry->global);
-    }
-
-    if (entry->next_hop) {
-        universal_address_rem(entry->next_hop);
-    }
-
-    entry->global = NULL;
-    entry->global_flags = 0;
-    entry->next_hop = NULL;
-    entry->next_hop_flags = 0;
-
-    entry->iface_id = KERNEL_PID_UNDEF;
-    entry->lifetime = 0;
-
-    return 0;
-}
-
 /**
  * @brief signals (sends a message to) all registered routing protocols
  *        registered with a matching prefix (usually this should be only one).
@@ -403,7 +686,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,7 +716,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +740,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +760,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -596,6 +879,7 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        fib_index_init(table);
     }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
@@ -621,6 +905,7 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        fib_index_init(table);
     }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
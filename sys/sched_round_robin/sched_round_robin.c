@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "irq.h"
+#include "sched_round_robin.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define NO_PRIO         (UINT8_MAX)
+
+static void _slice_end(void *arg);
+
+static uint32_t _slices[SCHED_PRIO_LEVELS];
+static ztimer_t _timer = { .callback = _slice_end };
+/* priority the running slice belongs to */
+static uint8_t _slice_prio = NO_PRIO;
+static bool _initialized;
+
+/* must be called with interrupts disabled */
+static void _update(void)
+{
+    uint8_t prio = 0;
+
+    /* the highest runnable priority is the one that is scheduled */
+    while ((prio < SCHED_PRIO_LEVELS) && sched_runq_is_empty(prio)) {
+        prio++;
+    }
+    if ((prio >= SCHED_PRIO_LEVELS) || (_slices[prio] == 0) ||
+        sched_runq_exactly_one(prio)) {
+        /* no peers to take turns with: stay tickless */
+        if (_slice_prio != NO_PRIO) {
+            ztimer_remove(ZTIMER_USEC, &_timer);
+            _slice_prio = NO_PRIO;
+        }
+        return;
+    }
+    if (_slice_prio != prio) {
+        DEBUG("sched_rr: starting slice of %" PRIu32 " us for prio %u\n",
+              _slices[prio], prio);
+        _slice_prio = prio;
+        ztimer_set(ZTIMER_USEC, &_timer, _slices[prio]);
+    }
+}
+
+static void _slice_end(void *arg)
+{
+    uint8_t prio = _slice_prio;
+    unsigned state;
+
+    (void)arg;
+    state = irq_disable();
+    _slice_prio = NO_PRIO;
+    if ((prio != NO_PRIO) && !sched_runq_is_empty(prio)) {
+        sched_runq_advance(prio);
+        thread_yield_higher();
+    }
+    /* start the slice of the next thread in line */
+    _update();
+    irq_restore(state);
+}
+
+void sched_runq_callback(uint8_t prio)
+{
+    (void)prio;
+    /* ztimer may not be initialized yet while the first threads are
+     * created */
+    if (_initialized) {
+        _update();
+    }
+}
+
+void sched_round_robin_init(void)
+{
+    unsigned state;
+
+    for (unsigned prio = 0; prio < SCHED_PRIO_LEVELS; prio++) {
+        _slices[prio] = (CONFIG_SCHED_RR_MASK & (1UL << prio))
+                      ? CONFIG_SCHED_RR_SLICE_US : 0;
+    }
+    state = irq_disable();
+    _initialized = true;
+    _update();
+    irq_restore(state);
+}
+
+void sched_rr_set_slice(uint8_t prio, uint32_t slice_us)
+{
+    unsigned state;
+
+    assert(prio < SCHED_PRIO_LEVELS);
+    state = irq_disable();
+    _slices[prio] = slice_us;
+    if ((slice_us == 0) && (_slice_prio == prio)) {
+        ztimer_remove(ZTIMER_USEC, &_timer);
+        _slice_prio = NO_PRIO;
+    }
+    else if (_initialized) {
+        _update();
+    }
+    irq_restore(state);
+}
+
+uint32_t sched_rr_get_slice(uint8_t prio)
+{
+    assert(prio < SCHED_PRIO_LEVELS);
+    return _slices[prio];
+}
+
+/** @} */
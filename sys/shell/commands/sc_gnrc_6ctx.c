@@ -26,12 +26,19 @@
 #include "timex.h"
 #include "xtimer.h"
 
+#define DEL_RETRY_US    (US_PER_MS)
+
 static xtimer_t del_timer[GNRC_SIXLOWPAN_CTX_SIZE];
 void _del_cb(void *ptr)
 {
     gnrc_sixlowpan_ctx_t *ctx = ptr;
     uint8_t cid = ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK;
-    ctx->prefix_len = 0;
+    /* called in interrupt context, so the context buffer can't be waited for
+     * if it is in use */
+    if (!gnrc_sixlowpan_ctx_try_remove(cid)) {
+        xtimer_set(&del_timer[cid], DEL_RETRY_US);
+        return;
+    }
     del_timer[cid].callback = NULL;
 }
 
@@ -116,8 +123,9 @@ int _gnrc_6ctx_del(char *cmd_str, char *ctx_str)
     if (del_timer[cid].callback == NULL) {
         ctx = gnrc_sixlowpan_ctx_lookup_id(cid);
         if (ctx != NULL) {
-            ctx->flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
-            ctx->ltime = 0;
+            /* keep context for decompression only until it is removed */
+            ctx = gnrc_sixlowpan_ctx_update(cid, &ctx->prefix,
+                                            ctx->prefix_len, 0, false);
             del_timer[cid].callback = _del_cb;
             del_timer[cid].arg = ctx;
             xtimer_set(&del_timer[cid],
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the memory allocation monitor
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "malloc_monitor.h"
+
+int _malloc_monitor_handler(int argc, char **argv)
+{
+    if (argc == 1) {
+        malloc_monitor_print();
+        return 0;
+    }
+    if ((argc == 2) && (strcmp(argv[1], "reset") == 0)) {
+        malloc_monitor_reset_peaks();
+        return 0;
+    }
+    printf("usage: %s [reset]\n", argv[0]);
+    return 1;
+}
+
+/** @} */
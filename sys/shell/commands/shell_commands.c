@@ -38,6 +38,10 @@ extern int _sc_dfplayer(int argc, char **argv);
 extern int _heap_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_MALLOC_MONITOR
+extern int _malloc_monitor_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_PERIPH_PM
 extern int _pm_handler(int argc, char **argv);
 #endif
@@ -204,6 +208,10 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_HEAP_CMD
     {"heap", "Prints heap statistics.", _heap_handler},
 #endif
+#ifdef MODULE_MALLOC_MONITOR
+    {"memstat", "Prints memory usage per thread and tag, 'reset' resets "
+                "the peaks", _malloc_monitor_handler},
+#endif
 #ifdef MODULE_PERIPH_PM
     { "pm", "interact with layered PM subsystem", _pm_handler },
 #endif
@@ -29,6 +29,9 @@
 #include "log.h"
 #include "net/nanocoap.h"
 #include "net/nanocoap_sock.h"
+#ifdef MODULE_GCOAP_BLOCK
+#include "net/gcoap_block.h"
+#endif
 #include "thread.h"
 #include "periph/pm.h"
 
@@ -129,6 +132,21 @@ static inline uint32_t deadline_left(uint32_t deadline)
     return left;
 }
 
+#ifdef MODULE_GCOAP_BLOCK
+int suit_coap_get_blockwise(sock_udp_ep_t *remote, const char *path,
+                            coap_blksize_t blksize,
+                            coap_blockwise_cb_t callback, void *arg)
+{
+    /* only the SUIT thread fetches, so a single context suffices */
+    static gcoap_block2_t ctx;
+
+    /* a manifest or image sent without Block2 option fails with -ENOBUFS
+     * unless it fits into CONFIG_GCOAP_BLOCK_SIZE_MAX */
+    int res = gcoap_block2_fetch(&ctx, remote, path, blksize, callback, arg);
+    DEBUG("res=%i\n", res);
+    return (res < 0) ? -1 : 0;
+}
+#else
 static ssize_t _nanocoap_request(sock_udp_t *sock, coap_pkt_t *pkt, size_t len)
 {
     ssize_t res = -EAGAIN;
@@ -272,6 +290,7 @@ out:
     sock_udp_close(&sock);
     return res;
 }
+#endif /* MODULE_GCOAP_BLOCK */
 
 int suit_coap_get_blockwise_url(const char *url,
                                 coap_blksize_t blksize,
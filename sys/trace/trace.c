@@ -22,9 +22,17 @@
 
 #include <stdio.h>
 
+#include "cpu.h"
 #include "irq.h"
+#include "thread.h"
+#include "trace.h"
 #include "xtimer.h"
 
+#if IS_USED(MODULE_TRACE_EVENTS) && defined(DWT_CTRL_CYCCNTENA_Msk)
+#include "periph_conf.h"
+#define TRACE_EVENTS_CYCLES     (1)
+#endif
+
 #ifndef CONFIG_TRACE_BUFSIZE
 #define CONFIG_TRACE_BUFSIZE 512
 #endif
@@ -68,3 +76,123 @@ void trace_reset(void)
     tracebuf_pos = 0;
     irq_restore(state);
 }
+
+#if IS_USED(MODULE_TRACE_EVENTS)
+#if (CONFIG_TRACE_EVENTS_BUFSIZE & (CONFIG_TRACE_EVENTS_BUFSIZE - 1)) != 0
+#error "CONFIG_TRACE_EVENTS_BUFSIZE must be a power of two"
+#endif
+
+#define TRACE_EVENTS_PREFIX     "trace_events: "
+/* records per line of trace_events_dump() */
+#define TRACE_EVENTS_PER_LINE   (8U)
+
+uint16_t trace_events_mask;
+
+static trace_event_t _events[CONFIG_TRACE_EVENTS_BUFSIZE];
+static uint32_t _events_pos;
+
+static inline uint32_t _events_now(void)
+{
+#ifdef TRACE_EVENTS_CYCLES
+    return DWT->CYCCNT;
+#else
+    return xtimer_now_usec();
+#endif
+}
+
+void trace_event_record(trace_event_type_t type, uint16_t arg)
+{
+    unsigned state = irq_disable();
+    trace_event_t *event = &_events[_events_pos++ &
+                                    (CONFIG_TRACE_EVENTS_BUFSIZE - 1)];
+
+    event->time = _events_now();
+    event->type = type;
+    /* context switches may run in interrupt context, e.g. in PendSV, but
+     * are recorded for the thread switched to */
+    event->pid = (irq_is_in() && (type != TRACE_EVENT_SCHED))
+               ? KERNEL_PID_ISR : thread_getpid();
+    event->arg = arg;
+    irq_restore(state);
+}
+
+void trace_events_enable(uint16_t mask)
+{
+#ifdef TRACE_EVENTS_CYCLES
+    if (mask && !(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+    trace_events_mask = mask;
+}
+
+static void _print_le(uint32_t val, unsigned bytes)
+{
+    while (bytes--) {
+        printf("%02x", (unsigned)(val & 0xff));
+        val >>= 8;
+    }
+}
+
+void trace_events_dump(void)
+{
+    unsigned state = irq_disable();
+    uint16_t mask = trace_events_mask;
+    uint32_t end = _events_pos;
+
+    /* stop recording so the records printed last are not overwritten */
+    trace_events_mask = 0;
+    irq_restore(state);
+
+    uint32_t n = (end > CONFIG_TRACE_EVENTS_BUFSIZE)
+               ? CONFIG_TRACE_EVENTS_BUFSIZE : end;
+    uint32_t hz;
+
+#if defined(TRACE_EVENTS_CYCLES) && defined(CLOCK_CORECLOCK)
+    hz = CLOCK_CORECLOCK;
+#elif defined(TRACE_EVENTS_CYCLES)
+    /* unknown, needs to be given to the decoder */
+    hz = 0;
+#else
+    hz = US_PER_SEC;
+#endif
+    printf(TRACE_EVENTS_PREFIX "v1 hz=%" PRIu32 " records=%" PRIu32
+           " lost=%" PRIu32 " isr=%d\n", hz, n, end - n, (int)KERNEL_PID_ISR);
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        if (thread_get(pid) != NULL) {
+            const char *name = thread_getname(pid);
+
+            printf(TRACE_EVENTS_PREFIX "thread %d %s\n", (int)pid,
+                   (name != NULL) ? name : "-");
+        }
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        const trace_event_t *event = &_events[(end - n + i) &
+                                              (CONFIG_TRACE_EVENTS_BUFSIZE - 1)];
+
+        if ((i % TRACE_EVENTS_PER_LINE) == 0) {
+            printf(TRACE_EVENTS_PREFIX);
+        }
+        _print_le(event->time, sizeof(event->time));
+        _print_le(event->type, sizeof(event->type));
+        _print_le(event->pid, sizeof(event->pid));
+        _print_le(event->arg, sizeof(event->arg));
+        if (((i % TRACE_EVENTS_PER_LINE) == (TRACE_EVENTS_PER_LINE - 1)) ||
+            (i == (n - 1))) {
+            puts("");
+        }
+    }
+    puts(TRACE_EVENTS_PREFIX "end");
+    trace_events_mask = mask;
+}
+
+void trace_events_reset(void)
+{
+    unsigned state = irq_disable();
+
+    _events_pos = 0;
+    irq_restore(state);
+}
+#endif /* IS_USED(MODULE_TRACE_EVENTS) */
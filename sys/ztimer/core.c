@@ -35,6 +35,8 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifndef MODULE_ZTIMER_WHEEL
+/* with ztimer_wheel, the timer list functions are replaced by wheel.c */
 static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry);
 static void _del_entry_from_list(ztimer_clock_t *clock, ztimer_base_t *entry);
 static void _ztimer_update(ztimer_clock_t *clock);
@@ -144,6 +146,7 @@ static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
           entry->offset);
 
 }
+#endif /* !MODULE_ZTIMER_WHEEL */
 
 static uint32_t _add_modulo(uint32_t a, uint32_t b, uint32_t mod)
 {
@@ -173,6 +176,7 @@ ztimer_now_t _ztimer_now_extend(ztimer_clock_t *clock)
 }
 #endif /* MODULE_ZTIMER_EXTEND */
 
+#ifndef MODULE_ZTIMER_WHEEL
 void ztimer_update_head_offset(ztimer_clock_t *clock)
 {
     uint32_t old_base = clock->list.offset;
@@ -388,3 +392,4 @@ static void _ztimer_print(const ztimer_clock_t *clock)
     } while ((entry = entry->next));
     puts("");
 }
+#endif /* !MODULE_ZTIMER_WHEEL */
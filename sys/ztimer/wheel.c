@@ -0,0 +1,407 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     sys_ztimer
+ * @{
+ *
+ * @file
+ * @brief       ztimer core functionality on a hierarchical timing wheel
+ *
+ * Replaces the timer list of ztimer core by a timing wheel, see
+ * "Timer handling" in @ref sys_ztimer. All times handled here are in the
+ * 32 bit domain of the clock and compared relative to
+ * ztimer_clock_t::wheel_now, so they may wrap around.
+ *
+ * The next event of the wheel is the earliest time at which a slot needs to
+ * be processed: for level 0 that is when the targets of its timers are
+ * reached, for the higher levels when their timers need to be moved down.
+ * Up to the next event, ztimer_clock_t::wheel_now can be advanced without
+ * touching any timer.
+ *
+ * @}
+ */
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#include "kernel_defines.h"
+#ifdef MODULE_PM_LAYERED
+#include "pm_layered.h"
+#endif
+#include "ztimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _SLOT_MASK      (ZTIMER_WHEEL_SLOTS - 1)
+
+static inline uint32_t _min_u32(uint32_t a, uint32_t b)
+{
+    return a < b ? a : b;
+}
+
+static inline unsigned _slot(uint32_t time, unsigned level)
+{
+    return (time >> (level * ZTIMER_WHEEL_BITS)) & _SLOT_MASK;
+}
+
+static void _push(ztimer_base_t **head, ztimer_base_t *entry)
+{
+    entry->next = *head;
+    if (entry->next) {
+        entry->next->pprev = &entry->next;
+    }
+    entry->pprev = head;
+    *head = entry;
+}
+
+static void _unlink(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    ztimer_base_t **pprev = entry->pprev;
+    uintptr_t first = (uintptr_t)&clock->wheel[0][0];
+    uintptr_t link = (uintptr_t)pprev;
+
+    *pprev = entry->next;
+    if (entry->next) {
+        entry->next->pprev = pprev;
+    }
+    entry->next = NULL;
+    entry->pprev = NULL;
+    /* only the link of the first timer of a slot points into the wheel */
+    if ((link >= first) && (link < first + sizeof(clock->wheel)) &&
+        (*pprev == NULL)) {
+        unsigned idx = (link - first) / sizeof(clock->wheel[0][0]);
+
+        clock->wheel_used[idx / ZTIMER_WHEEL_SLOTS] &=
+            ~(1U << (idx % ZTIMER_WHEEL_SLOTS));
+    }
+}
+
+/* stores entry in the slot of the highest group of bits in which its target
+ * differs from wheel_now */
+static void _place(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    uint32_t diff = entry->offset ^ clock->wheel_now;
+    unsigned level = ZTIMER_WHEEL_LEVELS - 1;
+
+    while ((level > 0) && (_slot(diff, level) == 0)) {
+        level--;
+    }
+    /* a target that lies almost a full period ahead matches the upper bits of
+     * wheel_now although they wrap before it is reached */
+    if ((level < ZTIMER_WHEEL_LEVELS - 1) &&
+        ((entry->offset - clock->wheel_now) >> ((level + 1) * ZTIMER_WHEEL_BITS))) {
+        level = ZTIMER_WHEEL_LEVELS - 1;
+    }
+
+    unsigned slot = _slot(entry->offset, level);
+
+    _push(&clock->wheel[level][slot], entry);
+    clock->wheel_used[level] |= (1U << slot);
+}
+
+/* stores the distance of the first used slot of level to wheel_now in dist,
+ * returns false if the level is empty */
+static bool _level_event(const ztimer_clock_t *clock, unsigned level,
+                         uint32_t *dist)
+{
+    uint32_t used = clock->wheel_used[level];
+
+    if (!used) {
+        return false;
+    }
+
+    unsigned shift = level * ZTIMER_WHEEL_BITS;
+    unsigned now = _slot(clock->wheel_now, level);
+    /* rotate, so that bit 0 is the slot wheel_now is in */
+    uint32_t rotated = ((used >> now) | (used << (ZTIMER_WHEEL_SLOTS - now)))
+                       & ((1UL << ZTIMER_WHEEL_SLOTS) - 1);
+    /* the slot starts with the lower bits of wheel_now cleared */
+    uint32_t low = clock->wheel_now & ((1UL << shift) - 1);
+
+    /* once wheel_now moved into a slot, it is only used again by timers
+     * wrapping around a full period on the top level */
+    if (low && (rotated & ~1UL)) {
+        rotated &= ~1UL;
+    }
+    *dist = ((uint32_t)bitarithm_lsb(rotated) << shift) - low;
+    return true;
+}
+
+/* returns the level of the next event and stores its distance to wheel_now
+ * in next, or returns -1 if the wheel is empty */
+static int _next_event(const ztimer_clock_t *clock, uint32_t *next)
+{
+    int res = -1;
+
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        uint32_t dist;
+
+        /* on a tie, the higher level needs to be cascaded first */
+        if (_level_event(clock, level, &dist) &&
+            ((res < 0) || (dist <= *next))) {
+            *next = dist;
+            res = level;
+        }
+    }
+    return res;
+}
+
+/* moves the timers of the slot at wheel_now down to the levels their targets
+ * now differ in, oldest first */
+static void _cascade(ztimer_clock_t *clock, unsigned level)
+{
+    unsigned slot = _slot(clock->wheel_now, level);
+    ztimer_base_t *entry = clock->wheel[level][slot];
+    ztimer_base_t *list = NULL;
+
+    clock->wheel[level][slot] = NULL;
+    clock->wheel_used[level] &= ~(1U << slot);
+    while (entry) {
+        ztimer_base_t *next = entry->next;
+
+        entry->next = list;
+        list = entry;
+        entry = next;
+    }
+    while (list) {
+        entry = list;
+        list = entry->next;
+        _place(clock, entry);
+    }
+}
+
+/* advances wheel_now towards now, cascading the slots passed on the way, up
+ * to the first expired timer */
+static void _sync(ztimer_clock_t *clock, uint32_t now)
+{
+    while (1) {
+        uint32_t next;
+        int level = _next_event(clock, &next);
+
+        if ((level < 0) || (next > (now - clock->wheel_now))) {
+            clock->wheel_now = now;
+            return;
+        }
+        clock->wheel_now += next;
+        if (level == 0) {
+            return;
+        }
+        _cascade(clock, level);
+    }
+}
+
+/* sets the backend to the earliest target on the wheel */
+static void _ztimer_update(ztimer_clock_t *clock)
+{
+    uint32_t next = UINT32_MAX;
+    int level = -1;
+
+    /* the earliest timer of a level is in the first used slot, which starts
+     * at the distance of the level's event */
+    for (unsigned i = 0; i < ZTIMER_WHEEL_LEVELS; i++) {
+        uint32_t dist;
+
+        if (!_level_event(clock, i, &dist) || ((level >= 0) && (dist >= next))) {
+            continue;
+        }
+        level = i;
+        if (i == 0) {
+            next = dist;
+            continue;
+        }
+
+        ztimer_base_t *entry = clock->wheel[i][_slot(clock->wheel_now + dist,
+                                                     i)];
+
+        for (; entry; entry = entry->next) {
+            next = _min_u32(next, entry->offset - clock->wheel_now);
+        }
+    }
+    if (level >= 0) {
+        uint32_t now = ztimer_now(clock);
+        uint32_t elapsed = now - clock->wheel_now;
+        uint32_t val = (next > elapsed) ? next - elapsed : 0;
+
+        clock->wheel_target = clock->wheel_now + next;
+#ifdef MODULE_ZTIMER_EXTEND
+        if (clock->max_value < UINT32_MAX) {
+            val = _min_u32(val, clock->max_value >> 1);
+        }
+#endif
+        clock->ops->set(clock, val);
+    }
+    else {
+#if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_NOW64
+        if (IS_USED(MODULE_ZTIMER_NOW64) || (clock->max_value < UINT32_MAX)) {
+            /* ensure there's at least one ISR per half period */
+            clock->ops->set(clock, clock->max_value >> 1);
+            return;
+        }
+#endif
+        clock->ops->cancel(clock);
+    }
+}
+
+static void _del_entry(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    _unlink(clock, entry);
+    clock->wheel_numof--;
+#ifdef MODULE_PM_LAYERED
+    /* The last timer just got removed from the clock's wheel */
+    if (clock->wheel_numof == 0 &&
+        clock->required_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_unblock(clock->required_pm_mode);
+    }
+#endif
+}
+
+void ztimer_remove(ztimer_clock_t *clock, ztimer_t *timer)
+{
+    unsigned state = irq_disable();
+
+    /* the backend stays set, firing it for nothing is cheaper than searching
+     * the wheel for the next target */
+    if (timer->base.pprev) {
+        _del_entry(clock, &timer->base);
+    }
+
+    irq_restore(state);
+}
+
+void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
+{
+    DEBUG("ztimer_set(): %p: set %p at %" PRIu32 " offset %" PRIu32 "\n",
+          (void *)clock, (void *)timer, clock->ops->now(clock), val);
+
+    unsigned state = irq_disable();
+    uint32_t now = ztimer_now(clock);
+
+    if (timer->base.pprev) {
+        _del_entry(clock, &timer->base);
+    }
+    _sync(clock, now);
+
+    /* optionally subtract a configurable adjustment value */
+    if (val > clock->adjust_set) {
+        val -= clock->adjust_set;
+    }
+    else {
+        val = 0;
+    }
+    /* the target must stay within 32 bit of wheel_now, which lags behind now
+     * only while the handler for an expired timer is pending */
+    val = _min_u32(val, UINT32_MAX - (now - clock->wheel_now));
+
+    timer->base.offset = now + val;
+#ifdef MODULE_PM_LAYERED
+    /* First timer on the clock's wheel */
+    if (clock->wheel_numof == 0 &&
+        clock->required_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
+        pm_block(clock->required_pm_mode);
+    }
+#endif
+    _place(clock, &timer->base);
+    if ((clock->wheel_numof++ == 0) ||
+        ((timer->base.offset - clock->wheel_now) <
+         (clock->wheel_target - clock->wheel_now))) {
+        clock->wheel_target = timer->base.offset;
+#ifdef MODULE_ZTIMER_EXTEND
+        if (clock->max_value < UINT32_MAX) {
+            val = _min_u32(val, clock->max_value >> 1);
+        }
+        DEBUG("ztimer_set(): %p setting %" PRIu32 "\n", (void *)clock, val);
+#endif
+        clock->ops->set(clock, val);
+    }
+
+    irq_restore(state);
+}
+
+void ztimer_update_head_offset(ztimer_clock_t *clock)
+{
+    unsigned state = irq_disable();
+
+    _sync(clock, ztimer_now(clock));
+    irq_restore(state);
+}
+
+/* triggers all timers expired by now, including those that expire while the
+ * callbacks run */
+static void _advance(ztimer_clock_t *clock)
+{
+    while (1) {
+        unsigned state = irq_disable();
+        uint32_t next;
+
+        /* calling now triggers checkpointing */
+        _sync(clock, ztimer_now(clock));
+        if ((_next_event(clock, &next) != 0) || (next != 0)) {
+            irq_restore(state);
+            return;
+        }
+
+        /* all timers in the level 0 slot at wheel_now expired, detach them
+         * oldest first */
+        unsigned slot = _slot(clock->wheel_now, 0);
+        ztimer_base_t *entry = clock->wheel[0][slot];
+        ztimer_base_t *expired = NULL;
+
+        clock->wheel[0][slot] = NULL;
+        clock->wheel_used[0] &= ~(1U << slot);
+        while (entry) {
+            ztimer_base_t *next_entry = entry->next;
+
+            entry->next = expired;
+            if (expired) {
+                expired->pprev = &entry->next;
+            }
+            entry->pprev = &expired;
+            expired = entry;
+            entry = next_entry;
+        }
+        irq_restore(state);
+
+        /* expired timers stay linked until triggered, so the callbacks may
+         * still remove or set any of them */
+        while (1) {
+            state = irq_disable();
+            ztimer_t *timer = (ztimer_t *)expired;
+
+            if (!timer) {
+                irq_restore(state);
+                break;
+            }
+            _del_entry(clock, &timer->base);
+            irq_restore(state);
+            DEBUG("ztimer_handler(): trigger %p at %" PRIu32 "\n",
+                  (void *)timer, clock->ops->now(clock));
+            timer->callback(timer->arg);
+        }
+    }
+}
+
+void ztimer_handler(ztimer_clock_t *clock)
+{
+    DEBUG("ztimer_handler(): %p now=%" PRIu32 "\n", (void *)clock,
+          clock->ops->now(clock));
+
+    _advance(clock);
+
+    unsigned state = irq_disable();
+    _ztimer_update(clock);
+    irq_restore(state);
+
+    DEBUG("ztimer_handler(): %p done.\n", (void *)clock);
+    if (!irq_is_in()) {
+        thread_yield_higher();
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Reschedule benchmark and stress test for evtimer
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "evtimer.h"
+#include "irq.h"
+#include "random.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RESCHEDULES
+#define BENCH_RESCHEDULES   (10000UL)
+#endif
+
+#ifndef BENCH_EVENTS_NUMOF
+#define BENCH_EVENTS_NUMOF  (2048U)
+#endif
+
+/* the benchmark events are far enough in the future to never trigger */
+#define BENCH_OFFSET_MIN    (60UL * MS_PER_SEC)
+#define BENCH_OFFSET_MAX    (3600UL * MS_PER_SEC)
+
+/* upper bound for the offsets of the stress test */
+#define STRESS_OFFSET_MAX   (500U)
+
+typedef struct {
+    evtimer_event_t event;      /**< the event, must be first */
+    uint32_t target;            /**< earliest time to trigger, in ms */
+    uint32_t triggered;         /**< time it triggered at, in ms */
+} bench_event_t;
+
+static const uint16_t _events_numof[] = { 64, 128, 256, 512, 1024, 2048,
+                                          4096 };
+
+static evtimer_t _evtimer;
+static bench_event_t _events[BENCH_EVENTS_NUMOF];
+static volatile unsigned _triggered;
+
+static void _cb(evtimer_event_t *event)
+{
+    bench_event_t *ev = (bench_event_t *)event;
+
+    ev->triggered = evtimer_now_msec();
+    _triggered++;
+}
+
+static uint32_t _offset(void)
+{
+    return random_uint32_range(BENCH_OFFSET_MIN, BENCH_OFFSET_MAX);
+}
+
+static void _bench(unsigned numof)
+{
+    uint32_t time;
+
+    for (unsigned i = 0; i < numof; i++) {
+        _events[i].event.offset = _offset();
+        evtimer_add(&_evtimer, &_events[i].event);
+    }
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_RESCHEDULES; i++) {
+        evtimer_event_t *event = &_events[random_uint32_range(0, numof)].event;
+
+        evtimer_del(&_evtimer, event);
+        event->offset = _offset();
+        evtimer_add(&_evtimer, event);
+    }
+    time = xtimer_now_usec() - time;
+    for (unsigned i = 0; i < numof; i++) {
+        evtimer_del(&_evtimer, &_events[i].event);
+    }
+
+    printf("{ \"heap\" : %d, \"events\" : %u, \"reschedules\" : %lu, "
+           "\"time\" : %" PRIu32 ", \"ns_per_reschedule\" : %" PRIu32 " }\n",
+           IS_USED(MODULE_EVTIMER_HEAP), numof, BENCH_RESCHEDULES,
+           time, (uint32_t)(((uint64_t)time * NS_PER_US) / BENCH_RESCHEDULES));
+}
+
+static int _stress(void)
+{
+    unsigned early = 0;
+
+    _triggered = 0;
+    for (unsigned i = 0; i < BENCH_EVENTS_NUMOF; i++) {
+        bench_event_t *ev = &_events[i];
+        unsigned state = irq_disable();
+
+        ev->event.offset = random_uint32_range(0, STRESS_OFFSET_MAX);
+        ev->target = evtimer_now_msec() + ev->event.offset;
+        evtimer_add(&_evtimer, &ev->event);
+        irq_restore(state);
+    }
+    xtimer_usleep(2 * STRESS_OFFSET_MAX * US_PER_MS);
+    for (unsigned i = 0; i < BENCH_EVENTS_NUMOF; i++) {
+        if ((int32_t)(_events[i].triggered - _events[i].target) < 0) {
+            early++;
+        }
+    }
+    printf("{ \"events\" : %u, \"triggered\" : %u, \"early\" : %u }\n",
+           BENCH_EVENTS_NUMOF, _triggered, early);
+    return ((_triggered == BENCH_EVENTS_NUMOF) && (early == 0)) ? 0 : -1;
+}
+
+int main(void)
+{
+    puts("evtimer reschedule benchmark\n");
+
+    evtimer_init(&_evtimer, _cb);
+    for (unsigned i = 0; i < ARRAY_SIZE(_events_numof); i++) {
+        if (_events_numof[i] > BENCH_EVENTS_NUMOF) {
+            break;
+        }
+        _bench(_events_numof[i]);
+    }
+    if (_stress() < 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Lookup latency benchmark for the FIB
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/fib.h"
+#include "xtimer.h"
+
+#ifndef BENCH_LOOKUPS
+#define BENCH_LOOKUPS       (10000UL)
+#endif
+
+#ifndef BENCH_TABLE_NUMOF
+#define BENCH_TABLE_NUMOF   (1024U)
+#endif
+
+#define BENCH_IFACE         (1U)
+#define BENCH_ADDR_SIZE     (16U)
+#define BENCH_DSTS_NUMOF    (64U)
+
+static const uint16_t _table_sizes[] = { 16, 32, 64, 128, 256, 512, 1024 };
+
+static fib_entry_t _entries[BENCH_TABLE_NUMOF];
+static fib_table_t _table;
+
+static uint8_t _dsts[BENCH_DSTS_NUMOF][BENCH_ADDR_SIZE];
+
+/* entry i is 2001:db8:<i / 4>::/48 for every fourth i, the others are
+ * 2001:db8:<i / 4>:<i % 4>::/64 below it */
+static void _prefix(unsigned i, uint8_t *pfx, unsigned *pfx_len)
+{
+    static const uint8_t base[] = { 0x20, 0x01, 0x0d, 0xb8 };
+
+    memset(pfx, 0, BENCH_ADDR_SIZE);
+    memcpy(pfx, base, sizeof(base));
+    pfx[4] = (i >> 2) >> 8;
+    pfx[5] = (i >> 2) & 0xff;
+    pfx[7] = i & 0x3;
+    *pfx_len = (i & 0x3) ? 64 : 48;
+}
+
+static int _fill(unsigned from, unsigned to)
+{
+    uint8_t next_hop[BENCH_ADDR_SIZE] = { 0xfe, 0x80 };
+
+    for (unsigned i = from; i < to; i++) {
+        uint8_t pfx[BENCH_ADDR_SIZE];
+        unsigned pfx_len;
+
+        _prefix(i, pfx, &pfx_len);
+        next_hop[15] = 1 + (i & 0x7f);
+        if (fib_add_entry(&_table, BENCH_IFACE, pfx, sizeof(pfx),
+                          pfx_len << FIB_FLAG_NET_PREFIX_SHIFT, next_hop,
+                          sizeof(next_hop), 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) < 0) {
+            printf("unable to add entry %u\n", i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _bench(unsigned entries)
+{
+    uint8_t next_hop[BENCH_ADDR_SIZE];
+    size_t next_hop_size;
+    uint32_t next_hop_flags;
+    kernel_pid_t iface;
+    uint32_t time;
+
+    /* spread the destinations over the whole table, every fourth one is only
+     * covered by a /48 prefix */
+    for (unsigned i = 0; i < BENCH_DSTS_NUMOF; i++) {
+        unsigned pfx_len;
+
+        _prefix((i * 7919U) % entries, _dsts[i], &pfx_len);
+        if ((i & 0x3) == 0) {
+            _dsts[i][6] = 0xff;
+            _dsts[i][7] = 0xff;
+        }
+        _dsts[i][15] = 1;
+        next_hop_size = sizeof(next_hop);
+        if (fib_get_next_hop(&_table, &iface, next_hop, &next_hop_size,
+                             &next_hop_flags, _dsts[i], BENCH_ADDR_SIZE,
+                             0) < 0) {
+            printf("no entry for destination %u\n", i);
+            return -1;
+        }
+    }
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_LOOKUPS; i++) {
+        next_hop_size = sizeof(next_hop);
+        fib_get_next_hop(&_table, &iface, next_hop, &next_hop_size,
+                         &next_hop_flags, _dsts[i % BENCH_DSTS_NUMOF],
+                         BENCH_ADDR_SIZE, 0);
+    }
+    time = xtimer_now_usec() - time;
+
+    printf("{ \"index\" : %d, \"entries\" : %u, \"lookups\" : %lu, "
+           "\"time\" : %" PRIu32 ", \"ns_per_lookup\" : %" PRIu32 " }\n",
+           IS_USED(MODULE_FIB_INDEX), entries, BENCH_LOOKUPS,
+           time, (uint32_t)(((uint64_t)time * NS_PER_US) / BENCH_LOOKUPS));
+    return 0;
+}
+
+int main(void)
+{
+    unsigned numof = 0;
+
+    puts("FIB lookup benchmark\n");
+
+    _table.data.entries = _entries;
+    _table.table_type = FIB_TABLE_TYPE_SH;
+    _table.size = BENCH_TABLE_NUMOF;
+    fib_init(&_table);
+    for (unsigned i = 0; i < ARRAY_SIZE(_table_sizes); i++) {
+        unsigned entries = _table_sizes[i];
+
+        if (entries > BENCH_TABLE_NUMOF) {
+            break;
+        }
+        if ((_fill(numof, entries) < 0) || (_bench(entries) < 0)) {
+            return 1;
+        }
+        numof = entries;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
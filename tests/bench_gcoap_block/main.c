@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for pipelined Block2 downloads with gcoap
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gcoap_block.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#ifndef BENCH_FETCHES
+#define BENCH_FETCHES       (20U)
+#endif
+
+#define BENCH_SIZE          (4096U)
+#define BENCH_SZX           (2U)    /* 64 byte blocks */
+
+static ssize_t _pattern_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/pattern", COAP_GET, _pattern_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    &_resources[0],
+    ARRAY_SIZE(_resources),
+    NULL,
+    NULL
+};
+
+static uint8_t _pattern[BENCH_SIZE];
+static gcoap_block2_t _ctx;
+static size_t _received;
+
+static ssize_t _pattern_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                void *ctx)
+{
+    (void)ctx;
+    coap_block_slicer_t slicer;
+    ssize_t plen;
+
+    coap_block2_init(pdu, &slicer);
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    coap_opt_add_format(pdu, COAP_FORMAT_OCTET);
+    coap_opt_add_block2(pdu, &slicer, 1);
+    plen = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+    plen += coap_blockwise_put_bytes(&slicer, pdu->payload, _pattern,
+                                     sizeof(_pattern));
+    coap_block2_finish(&slicer);
+    return plen;
+}
+
+static int _check(void *arg, size_t offset, uint8_t *buf, size_t len,
+                  int more)
+{
+    (void)arg;
+    (void)more;
+    if ((offset != _received) || (offset + len > sizeof(_pattern)) ||
+        memcmp(buf, &_pattern[offset], len)) {
+        printf("unexpected block at offset %u\n", (unsigned)offset);
+        return -1;
+    }
+    _received += len;
+    return 0;
+}
+
+int main(void)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6,
+                             .netif = SOCK_ADDR_ANY_NETIF,
+                             .port = CONFIG_GCOAP_PORT };
+    unsigned blocks = BENCH_SIZE >> (BENCH_SZX + 4);
+    uint32_t time;
+
+    puts("gcoap Block2 download benchmark\n");
+
+    for (unsigned i = 0; i < sizeof(_pattern); i++) {
+        _pattern[i] = (uint8_t)((i * 7) + (i >> 8));
+    }
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+    gcoap_register_listener(&_listener);
+
+    time = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_FETCHES; i++) {
+        int res;
+
+        _received = 0;
+        res = gcoap_block2_fetch(&_ctx, &remote, "/pattern", BENCH_SZX,
+                                 _check, NULL);
+        if ((res < 0) || (_received != sizeof(_pattern))) {
+            printf("download %u failed: %d, %u bytes\n", i, res,
+                   (unsigned)_received);
+            return 1;
+        }
+    }
+    time = xtimer_now_usec() - time;
+
+    printf("{ \"window\" : %u, \"block_size\" : %u, \"blocks\" : %u, "
+           "\"ns_per_block\" : %" PRIu32 " }\n",
+           CONFIG_GCOAP_BLOCK_WINDOW, 1U << (BENCH_SZX + 4),
+           blocks * BENCH_FETCHES,
+           (uint32_t)(((uint64_t)time * NS_PER_US) / (blocks * BENCH_FETCHES)));
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Load benchmark for gcoap with many open requests
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#ifndef OPEN_NUMOF
+#define OPEN_NUMOF          (2048U)
+#endif
+
+#ifndef BENCH_REQUESTS
+#define BENCH_REQUESTS      (1000UL)
+#endif
+
+#define BENCH_RESP_TIMEOUT  (US_PER_SEC)
+
+static const uint16_t _open_numofs[] = { 0, 16, 128, 512, 1024, 2048, 4096 };
+
+static ssize_t _bench_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/bench", COAP_GET, _bench_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    &_resources[0],
+    ARRAY_SIZE(_resources),
+    NULL,
+    NULL
+};
+
+static mutex_t _resp_lock = MUTEX_INIT_LOCKED;
+static unsigned _resps;
+
+static ssize_t _bench_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    (void)ctx;
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote)
+{
+    (void)pdu;
+    (void)remote;
+    if (memo->state == GCOAP_MEMO_RESP) {
+        _resps++;
+    }
+    mutex_unlock(&_resp_lock);
+}
+
+static int _send(uint16_t port, const char *path,
+                 gcoap_resp_handler_t resp_handler)
+{
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    sock_udp_ep_t remote = { .family = AF_INET6,
+                             .netif = SOCK_ADDR_ANY_NETIF,
+                             .port = port };
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+    gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET, path);
+    coap_hdr_set_type(pdu.hdr, COAP_TYPE_CON);
+    len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+    return (gcoap_req_send(buf, len, &remote, resp_handler, NULL) > 0) ? 0 : -1;
+}
+
+static int _open(unsigned from, unsigned to)
+{
+    /* nobody listens on the port after gcoap's, so these stay open */
+    for (unsigned i = from; i < to; i++) {
+        if (_send(CONFIG_GCOAP_PORT + 1, "/open", NULL) < 0) {
+            printf("unable to send open request %u\n", i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _bench(unsigned open)
+{
+    uint32_t time;
+
+    _resps = 0;
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_REQUESTS; i++) {
+        if ((_send(CONFIG_GCOAP_PORT, "/bench", _resp_handler) < 0) ||
+            (xtimer_mutex_lock_timeout(&_resp_lock, BENCH_RESP_TIMEOUT) < 0)) {
+            printf("no response to request %lu\n", i);
+            return -1;
+        }
+    }
+    time = xtimer_now_usec() - time;
+
+    if (_resps != BENCH_REQUESTS) {
+        printf("%u of %lu responses\n", _resps, BENCH_REQUESTS);
+        return -1;
+    }
+    /* gcoap_op_state() returns a uint8_t, larger counts can't be checked */
+    if ((open <= UINT8_MAX) && (gcoap_op_state() != open)) {
+        printf("%u open requests, expected %u\n", gcoap_op_state(), open);
+        return -1;
+    }
+
+    printf("{ \"hash\" : %d, \"open\" : %u, \"requests\" : %lu, "
+           "\"ns_per_request\" : %" PRIu32 " }\n",
+           IS_USED(MODULE_GCOAP_HASH), open, BENCH_REQUESTS,
+           (uint32_t)(((uint64_t)time * NS_PER_US) / BENCH_REQUESTS));
+    return 0;
+}
+
+int main(void)
+{
+    unsigned numof = 0;
+
+    puts("gcoap request load benchmark\n");
+
+    gcoap_register_listener(&_listener);
+    for (unsigned i = 0; i < ARRAY_SIZE(_open_numofs); i++) {
+        unsigned open = _open_numofs[i];
+
+        if (open > OPEN_NUMOF) {
+            break;
+        }
+        if ((_open(numof, open) < 0) || (_bench(open) < 0)) {
+            return 1;
+        }
+        numof = open;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Lookup latency benchmark for the NIB forwarding table
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "xtimer.h"
+
+#ifndef BENCH_LOOKUPS
+#define BENCH_LOOKUPS       (10000UL)
+#endif
+
+#define BENCH_IFACE         (1U)
+#define BENCH_DSTS_NUMOF    (64U)
+
+static const uint16_t _table_sizes[] = { 16, 32, 64, 128, 256, 512, 1024 };
+
+static ipv6_addr_t _dsts[BENCH_DSTS_NUMOF];
+
+/* route i is 2001:db8:<i / 4>::/48 for every fourth i, the others are
+ * 2001:db8:<i / 4>:<i % 4>::/64 below it */
+static void _route(unsigned i, ipv6_addr_t *pfx, unsigned *pfx_len)
+{
+    ipv6_addr_from_str(pfx, "2001:db8::");
+    pfx->u16[2] = byteorder_htons(i >> 2);
+    pfx->u16[3] = byteorder_htons(i & 0x3);
+    *pfx_len = (i & 0x3) ? 64 : 48;
+}
+
+static int _fill(unsigned from, unsigned to)
+{
+    ipv6_addr_t next_hop;
+
+    ipv6_addr_from_str(&next_hop, "fe80::1");
+    for (unsigned i = from; i < to; i++) {
+        ipv6_addr_t pfx;
+        unsigned pfx_len;
+
+        _route(i, &pfx, &pfx_len);
+        next_hop.u8[15] = 1 + (i & 0x1);
+        if (gnrc_ipv6_nib_ft_add(&pfx, pfx_len, &next_hop, BENCH_IFACE,
+                                 0) < 0) {
+            printf("unable to add route %u\n", i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _bench(unsigned routes)
+{
+    gnrc_ipv6_nib_ft_t fte;
+    uint32_t time;
+
+    /* spread the destinations over the whole table, every fourth one is only
+     * covered by a /48 route */
+    for (unsigned i = 0; i < BENCH_DSTS_NUMOF; i++) {
+        unsigned pfx_len;
+
+        _route((i * 7919U) % routes, &_dsts[i], &pfx_len);
+        if ((i & 0x3) == 0) {
+            _dsts[i].u16[3] = byteorder_htons(0xffff);
+        }
+        _dsts[i].u8[15] = 1;
+        if (gnrc_ipv6_nib_ft_get(&_dsts[i], NULL, &fte) < 0) {
+            printf("no route for destination %u\n", i);
+            return -1;
+        }
+    }
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_LOOKUPS; i++) {
+        gnrc_ipv6_nib_ft_get(&_dsts[i % BENCH_DSTS_NUMOF], NULL, &fte);
+    }
+    time = xtimer_now_usec() - time;
+
+    printf("{ \"trie\" : %d, \"routes\" : %u, \"lookups\" : %lu, "
+           "\"time\" : %" PRIu32 ", \"ns_per_lookup\" : %" PRIu32 " }\n",
+           IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_OFFL_TRIE), routes, BENCH_LOOKUPS,
+           time, (uint32_t)(((uint64_t)time * NS_PER_US) / BENCH_LOOKUPS));
+    return 0;
+}
+
+int main(void)
+{
+    unsigned numof = 0;
+
+    puts("NIB forwarding table lookup benchmark\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_table_sizes); i++) {
+        unsigned routes = _table_sizes[i];
+
+        if (routes > CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF) {
+            break;
+        }
+        if ((_fill(numof, routes) < 0) || (_bench(routes) < 0)) {
+            return 1;
+        }
+        numof = routes;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
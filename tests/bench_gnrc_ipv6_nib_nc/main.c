@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Lookup latency benchmark for the NIB neighbor cache
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/netdev/eth.h"
+#include "xtimer.h"
+
+#ifndef BENCH_LOOKUPS
+#define BENCH_LOOKUPS       (10000UL)
+#endif
+
+#ifndef BENCH_TABLE_NUMOF
+#define BENCH_TABLE_NUMOF   (CONFIG_GNRC_IPV6_NIB_NUMOF - 4)
+#endif
+
+#define BENCH_DSTS_NUMOF    (64U)
+
+#define _MAC_STACKSIZE      (THREAD_STACKSIZE_DEFAULT)
+#define _MAC_PRIO           (THREAD_PRIORITY_MAIN - 4)
+
+static const uint16_t _table_sizes[] = { 16, 32, 64, 128, 256, 512, 1024 };
+
+static const uint8_t _dev_addr[] = { 0x6c, 0x5d, 0xff, 0x73, 0x84, 0x6f };
+
+static gnrc_netif_t _netif;
+static netdev_t _dev;
+static char _mac_stack[_MAC_STACKSIZE];
+
+static ipv6_addr_t _dsts[BENCH_DSTS_NUMOF];
+
+static int _recv(netdev_t *dev, void *buf, size_t len, void *info)
+{
+    (void)dev;
+    (void)buf;
+    (void)len;
+    (void)info;
+    return 0;
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    return iolist_size(iolist);
+}
+
+static int _init(netdev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
+{
+    if (opt == NETOPT_ADDRESS) {
+        if (max_len < sizeof(_dev_addr)) {
+            return -EOVERFLOW;
+        }
+        memcpy(value, _dev_addr, sizeof(_dev_addr));
+        return sizeof(_dev_addr);
+    }
+    return netdev_eth_get(dev, opt, value, max_len);
+}
+
+static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t len)
+{
+    return netdev_eth_set(dev, opt, value, len);
+}
+
+static const netdev_driver_t _driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .get = _get,
+    .set = _set,
+};
+
+static void _neighbor(unsigned i, ipv6_addr_t *addr, uint8_t *l2addr)
+{
+    ipv6_addr_from_str(addr, "fe80::");
+    addr->u16[6] = byteorder_htons(0x4200 | (i >> 16));
+    addr->u16[7] = byteorder_htons(i & 0xffff);
+    memset(l2addr, 0x42, ETHERNET_ADDR_LEN);
+    l2addr[4] = i >> 8;
+    l2addr[5] = i & 0xff;
+}
+
+static int _fill(unsigned from, unsigned to)
+{
+    for (unsigned i = from; i < to; i++) {
+        ipv6_addr_t addr;
+        uint8_t l2addr[ETHERNET_ADDR_LEN];
+
+        _neighbor(i, &addr, l2addr);
+        if (gnrc_ipv6_nib_nc_set(&addr, _netif.pid, l2addr,
+                                 sizeof(l2addr)) < 0) {
+            printf("unable to add neighbor %u\n", i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _bench(unsigned neighbors)
+{
+    gnrc_ipv6_nib_nc_t nce;
+    uint32_t time;
+
+    /* spread the destinations over the whole neighbor cache */
+    for (unsigned i = 0; i < BENCH_DSTS_NUMOF; i++) {
+        uint8_t l2addr[ETHERNET_ADDR_LEN];
+
+        _neighbor((i * 7919U) % neighbors, &_dsts[i], l2addr);
+        if ((gnrc_ipv6_nib_get_next_hop_l2addr(&_dsts[i], &_netif, NULL,
+                                               &nce) < 0) ||
+            (nce.l2addr_len != sizeof(l2addr)) ||
+            (memcmp(nce.l2addr, l2addr, sizeof(l2addr)) != 0)) {
+            printf("unable to resolve destination %u\n", i);
+            return -1;
+        }
+    }
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_LOOKUPS; i++) {
+        gnrc_ipv6_nib_get_next_hop_l2addr(&_dsts[i % BENCH_DSTS_NUMOF],
+                                          &_netif, NULL, &nce);
+    }
+    time = xtimer_now_usec() - time;
+
+    printf("{ \"hash\" : %d, \"neighbors\" : %u, \"lookups\" : %lu, "
+           "\"time\" : %" PRIu32 ", \"ns_per_lookup\" : %" PRIu32 " }\n",
+           IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ONL_HASH), neighbors, BENCH_LOOKUPS,
+           time, (uint32_t)(((uint64_t)time * NS_PER_US) / BENCH_LOOKUPS));
+    return 0;
+}
+
+int main(void)
+{
+    unsigned numof = 0;
+
+    puts("NIB neighbor cache lookup benchmark\n");
+
+    _dev.driver = &_driver;
+    if (gnrc_netif_ethernet_create(&_netif, _mac_stack, _MAC_STACKSIZE,
+                                   _MAC_PRIO, "bench_eth", &_dev) < 0) {
+        puts("unable to create network interface");
+        return 1;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_table_sizes); i++) {
+        unsigned neighbors = _table_sizes[i];
+
+        if (neighbors > BENCH_TABLE_NUMOF) {
+            break;
+        }
+        if ((_fill(numof, neighbors) < 0) || (_bench(neighbors) < 0)) {
+            return 1;
+        }
+        numof = neighbors;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Packet rate benchmark for gnrc_netif -> IPv6 -> UDP
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev/eth.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS        (2000U)
+#endif
+
+#ifndef BENCH_BURST
+#define BENCH_BURST         (8U)
+#endif
+
+#define BENCH_PORT          (5683U)
+#define BENCH_PAYLOAD_LEN   (32U)
+
+#define _MAC_STACKSIZE      (THREAD_STACKSIZE_DEFAULT)
+#define _MAC_PRIO           (THREAD_PRIORITY_MAIN - 4)
+#define _IRQ_STACKSIZE      (THREAD_STACKSIZE_DEFAULT)
+#define _IRQ_PRIO           (1)
+
+#define _MAIN_MSG_QUEUE_SIZE    (2 * BENCH_BURST)
+
+static const uint8_t _dev_addr[] = { 0x6c, 0x5d, 0xff, 0x73, 0x84, 0x6f };
+
+static gnrc_netif_t _netif;
+static netdev_t _dev;
+static char _mac_stack[_MAC_STACKSIZE];
+static char _irq_stack[_IRQ_STACKSIZE];
+static kernel_pid_t _irq_pid;
+static msg_t _main_msg_queue[_MAIN_MSG_QUEUE_SIZE];
+
+static uint8_t _frame[sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) +
+                      sizeof(udp_hdr_t) + BENCH_PAYLOAD_LEN];
+
+static int _recv(netdev_t *dev, void *buf, size_t len, void *info)
+{
+    (void)dev;
+    (void)info;
+
+    if (buf == NULL) {
+        return sizeof(_frame);
+    }
+    if (len < sizeof(_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, sizeof(_frame));
+    return sizeof(_frame);
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    return iolist_size(iolist);
+}
+
+static void _isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static int _init(netdev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
+{
+    if (opt == NETOPT_ADDRESS) {
+        if (max_len < sizeof(_dev_addr)) {
+            return -EOVERFLOW;
+        }
+        memcpy(value, _dev_addr, sizeof(_dev_addr));
+        return sizeof(_dev_addr);
+    }
+    return netdev_eth_get(dev, opt, value, max_len);
+}
+
+static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t len)
+{
+    return netdev_eth_set(dev, opt, value, len);
+}
+
+static const netdev_driver_t _driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static void _init_frame(void)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+    uint8_t *payload = (uint8_t *)(udp + 1);
+    const uint16_t udp_len = sizeof(udp_hdr_t) + BENCH_PAYLOAD_LEN;
+    uint16_t csum;
+
+    /* all-nodes multicast */
+    memcpy(eth->dst, "\x33\x33\x00\x00\x00\x01", ETHERNET_ADDR_LEN);
+    memset(eth->src, 0x42, ETHERNET_ADDR_LEN);
+    eth->type = byteorder_htons(ETHERTYPE_IPV6);
+
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(udp_len);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = 64;
+    ipv6_addr_from_str(&ipv6->src, "fe80::4042:42ff:fe42:4242");
+    ipv6_addr_set_all_nodes_multicast(&ipv6->dst,
+                                      IPV6_ADDR_MCAST_SCP_LINK_LOCAL);
+
+    udp->src_port = byteorder_htons(BENCH_PORT);
+    udp->dst_port = byteorder_htons(BENCH_PORT);
+    udp->length = byteorder_htons(udp_len);
+    udp->checksum = byteorder_htons(0);
+    for (unsigned i = 0; i < BENCH_PAYLOAD_LEN; i++) {
+        payload[i] = i;
+    }
+    csum = inet_csum(0, (uint8_t *)udp, udp_len);
+    csum = ~ipv6_hdr_inet_csum(csum, ipv6, PROTNUM_UDP, udp_len);
+    udp->checksum = byteorder_htons((csum == 0) ? 0xffff : csum);
+}
+
+/* simulates a device raising a burst of interrupts */
+static void *_irq_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        for (unsigned i = 0; i < BENCH_BURST; i++) {
+            _dev.event_callback(&_dev, NETDEV_EVENT_ISR);
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t me = GNRC_NETREG_ENTRY_INIT_PID(BENCH_PORT,
+                                                        thread_getpid());
+    unsigned long packets = 0;
+    uint32_t time;
+
+    puts("netapi batch benchmark\n");
+
+    msg_init_queue(_main_msg_queue, _MAIN_MSG_QUEUE_SIZE);
+    _init_frame();
+    _dev.driver = &_driver;
+    if (gnrc_netif_ethernet_create(&_netif, _mac_stack, _MAC_STACKSIZE,
+                                   _MAC_PRIO, "bench_eth", &_dev) < 0) {
+        puts("unable to create network interface");
+        return 1;
+    }
+    _irq_pid = thread_create(_irq_stack, sizeof(_irq_stack), _IRQ_PRIO,
+                             THREAD_CREATE_STACKTEST, _irq_thread, NULL,
+                             "irq");
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &me);
+    /* let interface configuration settle */
+    xtimer_sleep(1);
+
+    time = xtimer_now_usec();
+    for (unsigned round = 0; round < BENCH_ROUNDS; round++) {
+        msg_t msg;
+
+        msg_send(&msg, _irq_pid);
+        for (unsigned i = 0; i < BENCH_BURST; i++) {
+            msg_receive(&msg);
+            if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+                printf("unexpected message type 0x%04x\n", msg.type);
+                return 1;
+            }
+            gnrc_pktbuf_release(msg.content.ptr);
+            packets++;
+        }
+    }
+    time = xtimer_now_usec() - time;
+
+    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &me);
+    printf("{ \"batching\" : %d, \"burst\" : %u, \"packets\" : %lu, "
+           "\"time\" : %" PRIu32 ", \"pps\" : %" PRIu32 " }\n",
+           IS_USED(MODULE_GNRC_NETAPI_BATCH), BENCH_BURST, packets, time,
+           (uint32_t)(((uint64_t)packets * US_PER_SEC) / time));
+    puts("[SUCCESS]");
+    return 0;
+}
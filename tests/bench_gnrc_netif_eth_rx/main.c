@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for the number of copies on Ethernet reception
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/netdev/eth.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10000UL)
+#endif
+
+#define _MAC_STACKSIZE      (THREAD_STACKSIZE_DEFAULT)
+#define _MAC_PRIO           (THREAD_PRIORITY_MAIN - 4)
+
+static const uint16_t _frame_sizes[] = { 64, 512, ETHERNET_FRAME_LEN };
+
+static const uint8_t _dev_addr[] = { 0x6c, 0x5d, 0xff, 0x73, 0x84, 0x6f };
+
+static gnrc_netif_t _netif;
+static char _mac_stack[_MAC_STACKSIZE];
+static netdev_t _dev;
+
+static uint8_t _frame[ETHERNET_FRAME_LEN];
+static uint16_t _frame_len;
+/* bytes written by the driver and location the payload was written to */
+static unsigned long _copied;
+static const void *_payload_dst;
+
+static int _recv(netdev_t *dev, void *buf, size_t len, void *info)
+{
+    (void)dev;
+    (void)info;
+
+    if (buf == NULL) {
+        return _frame_len;
+    }
+    if (len < _frame_len) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, _frame_len);
+    _copied += _frame_len;
+    _payload_dst = (uint8_t *)buf + sizeof(ethernet_hdr_t);
+    return _frame_len;
+}
+
+static int _recv_iol(netdev_t *dev, const iolist_t *iolist, void *info)
+{
+    size_t pos = 0;
+
+    (void)dev;
+    (void)info;
+
+    if (iolist_size(iolist) < _frame_len) {
+        return -ENOBUFS;
+    }
+    for (; pos < _frame_len; iolist = iolist->iol_next) {
+        size_t len = _frame_len - pos;
+
+        if (len > iolist->iol_len) {
+            len = iolist->iol_len;
+        }
+        if (pos == sizeof(ethernet_hdr_t)) {
+            _payload_dst = iolist->iol_base;
+        }
+        memcpy(iolist->iol_base, &_frame[pos], len);
+        pos += len;
+    }
+    _copied += _frame_len;
+    return _frame_len;
+}
+
+static int _init(netdev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    return iolist_size(iolist);
+}
+
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
+{
+    if (opt == NETOPT_ADDRESS) {
+        if (max_len < sizeof(_dev_addr)) {
+            return -EOVERFLOW;
+        }
+        memcpy(value, _dev_addr, sizeof(_dev_addr));
+        return sizeof(_dev_addr);
+    }
+    return netdev_eth_get(dev, opt, value, max_len);
+}
+
+static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t len)
+{
+    return netdev_eth_set(dev, opt, value, len);
+}
+
+static const netdev_driver_t _driver_recv = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .get = _get,
+    .set = _set,
+};
+
+static const netdev_driver_t _driver_recv_iol = {
+    .send = _send,
+    .recv = _recv,
+    .recv_iol = _recv_iol,
+    .init = _init,
+    .get = _get,
+    .set = _set,
+};
+
+static void _init_frame(uint16_t len)
+{
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)_frame;
+
+    memcpy(hdr->dst, _dev_addr, sizeof(hdr->dst));
+    memset(hdr->src, 0x42, sizeof(hdr->src));
+    hdr->type = byteorder_htons(ETHERTYPE_UNKNOWN);
+    for (unsigned i = sizeof(ethernet_hdr_t); i < len; i++) {
+        _frame[i] = i;
+    }
+    _frame_len = len;
+}
+
+static int _bench(const char *mode, const netdev_driver_t *driver)
+{
+    uint32_t time;
+
+    _dev.driver = driver;
+    _copied = 0;
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        gnrc_pktsnip_t *pkt = _netif.ops->recv(&_netif);
+
+        if (pkt == NULL) {
+            printf("%s: unable to receive frame\n", mode);
+            return -1;
+        }
+        if (pkt->data != _payload_dst) {
+            /* payload was moved within the packet buffer */
+            _copied += pkt->size;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    time = xtimer_now_usec() - time;
+
+    printf("{ \"mode\" : \"%s\", \"frame\" : %u, \"copied\" : %lu, "
+           "\"time\" : %" PRIu32 " }\n", mode, _frame_len,
+           _copied / BENCH_RUNS, (uint32_t)(time / BENCH_RUNS));
+    return 0;
+}
+
+int main(void)
+{
+    puts("Ethernet receive copy benchmark\n");
+
+    _dev.driver = &_driver_recv;
+    if (gnrc_netif_ethernet_create(&_netif, _mac_stack, _MAC_STACKSIZE,
+                                   _MAC_PRIO, "bench_eth", &_dev) < 0) {
+        puts("unable to create network interface");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_frame_sizes); i++) {
+        _init_frame(_frame_sizes[i]);
+        if ((_bench("recv", &_driver_recv) < 0) ||
+            (_bench("recv_iol", &_driver_recv_iol) < 0)) {
+            return 1;
+        }
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
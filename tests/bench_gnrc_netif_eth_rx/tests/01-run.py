@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+FRAME_SIZES = (64, 512, 1514)
+
+
+def testfunc(child):
+    child.expect_exact("Ethernet receive copy benchmark")
+    for size in FRAME_SIZES:
+        for mode in ("recv", "recv_iol"):
+            child.expect(r"{{ \"mode\" : \"{}\", \"frame\" : {}, "
+                         r"\"copied\" : (\d+), \"time\" : \d+ }}"
+                         .format(mode, size))
+            if mode == "recv_iol":
+                # the frame must only be copied once by the driver
+                assert int(child.match.group(1)) == size
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
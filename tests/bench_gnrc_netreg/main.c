@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for UDP demultiplexing and port allocation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/gnrc/netreg.h"
+#include "net/iana/portrange.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#ifndef SOCK_NUMOF
+#define SOCK_NUMOF          (256U)
+#endif
+
+#ifndef BENCH_LOOKUPS
+#define BENCH_LOOKUPS       (10000UL)
+#endif
+
+#ifndef BENCH_BINDS
+#define BENCH_BINDS         (1000UL)
+#endif
+
+#define BENCH_PORT(i)       (IANA_DYNAMIC_PORTRANGE_MIN + (((i) * 7919U) % 16384U))
+
+static const uint16_t _sock_numofs[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+
+static sock_udp_t _socks[SOCK_NUMOF];
+static sock_udp_t _bind_sock;
+
+static int _fill(unsigned from, unsigned to)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+
+    for (unsigned i = from; i < to; i++) {
+        local.port = BENCH_PORT(i);
+        if (sock_udp_create(&_socks[i], &local, NULL, 0) < 0) {
+            printf("unable to bind sock %u\n", i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int _bench(unsigned socks)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    uint32_t lookup_time, bind_time;
+
+    for (unsigned i = 0; i < socks; i++) {
+        if (gnrc_netreg_lookup(GNRC_NETTYPE_UDP,
+                               BENCH_PORT(i)) != &_socks[i].reg.entry) {
+            printf("sock %u not found\n", i);
+            return -1;
+        }
+    }
+    lookup_time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_LOOKUPS; i++) {
+        gnrc_netreg_lookup(GNRC_NETTYPE_UDP, BENCH_PORT(i % socks));
+    }
+    lookup_time = xtimer_now_usec() - lookup_time;
+
+    /* local.port == 0 picks a random port from the dynamic port range */
+    bind_time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_BINDS; i++) {
+        if (sock_udp_create(&_bind_sock, &local, NULL, 0) < 0) {
+            puts("unable to bind sock to dynamic port");
+            return -1;
+        }
+        sock_udp_close(&_bind_sock);
+    }
+    bind_time = xtimer_now_usec() - bind_time;
+
+    printf("{ \"hash\" : %d, \"socks\" : %u, \"lookups\" : %lu, "
+           "\"ns_per_lookup\" : %" PRIu32 ", \"ns_per_bind\" : %" PRIu32 " }\n",
+           IS_USED(MODULE_GNRC_NETREG_HASH), socks, BENCH_LOOKUPS,
+           (uint32_t)(((uint64_t)lookup_time * NS_PER_US) / BENCH_LOOKUPS),
+           (uint32_t)(((uint64_t)bind_time * NS_PER_US) / BENCH_BINDS));
+    return 0;
+}
+
+int main(void)
+{
+    unsigned numof = 0;
+
+    puts("UDP demultiplexing benchmark\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_sock_numofs); i++) {
+        unsigned socks = _sock_numofs[i];
+
+        if (socks > SOCK_NUMOF) {
+            break;
+        }
+        if ((_fill(numof, socks) < 0) || (_bench(socks) < 0)) {
+            return 1;
+        }
+        numof = socks;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Fragmentation stress benchmark for the packet buffer
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100000UL)
+#endif
+
+#ifndef BENCH_SLOTS
+#define BENCH_SLOTS         (8U)
+#endif
+
+#define L2_HDR_SIZE         (24U)
+#define IPV6_HDR_SIZE       (40U)
+#define FRAG_PAYLOAD_MIN    (48U)
+#define FRAG_PAYLOAD_MAX    (127U)
+#define MTU_PAYLOAD_SIZE    (1280U)
+
+static gnrc_pktsnip_t *_slots[BENCH_SLOTS];
+static uint32_t _seed = 1;
+
+/* deterministic PRNG so all implementations see the same workload */
+static uint32_t _rand(void)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return _seed >> 16;
+}
+
+static size_t _payload_size(void)
+{
+    /* mostly single fragments, every fourth packet is a full datagram */
+    if ((_rand() % 4) == 0) {
+        return MTU_PAYLOAD_SIZE;
+    }
+    return FRAG_PAYLOAD_MIN + (_rand() % (FRAG_PAYLOAD_MAX - FRAG_PAYLOAD_MIN));
+}
+
+static gnrc_pktsnip_t *_receive(size_t size)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    if (gnrc_pktbuf_mark(pkt, IPV6_HDR_SIZE, GNRC_NETTYPE_UNDEF) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    netif = gnrc_pktbuf_add(NULL, NULL, L2_HDR_SIZE, GNRC_NETTYPE_NETIF);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return gnrc_pkt_append(pkt, netif);
+}
+
+int main(void)
+{
+    unsigned long allocs = 0, fails = 0;
+    uint32_t time;
+
+    puts("Packet buffer fragmentation benchmark\n");
+    gnrc_pktbuf_init();
+
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        unsigned slot = _rand() % BENCH_SLOTS;
+
+        if (_slots[slot] != NULL) {
+            gnrc_pktbuf_release(_slots[slot]);
+            _slots[slot] = NULL;
+        }
+        else {
+            allocs++;
+            _slots[slot] = _receive(_payload_size());
+            if (_slots[slot] == NULL) {
+                fails++;
+            }
+        }
+    }
+    time = xtimer_now_usec() - time;
+
+    for (unsigned i = 0; i < BENCH_SLOTS; i++) {
+        gnrc_pktbuf_release(_slots[i]);
+    }
+
+    printf("{ \"runs\" : %lu, \"allocs\" : %lu, \"fails\" : %lu, "
+           "\"time\" : %" PRIu32 ", \"ns_per_op\" : %" PRIu32 " }\n",
+           BENCH_RUNS, allocs, fails, time,
+           (uint32_t)(((uint64_t)time * 1000U) / BENCH_RUNS));
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       iperf-like throughput benchmark for GNRC TCP
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "shell.h"
+#include "xtimer.h"
+
+#ifndef BENCH_BYTES
+#define BENCH_BYTES         (1048576UL)
+#endif
+
+#ifndef BENCH_CHUNK_SIZE
+#define BENCH_CHUNK_SIZE    (2048U)
+#endif
+
+#define BENCH_RECV_TIMEOUT_MS   (10U * MS_PER_SEC)
+
+#define MAIN_QUEUE_SIZE     (8)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static gnrc_tcp_tcb_t _tcb;
+static uint8_t _buf[BENCH_CHUNK_SIZE];
+
+static void _print_result(const char *role, uint32_t bytes, uint32_t time)
+{
+    /* bytes * 8 / us == Mbit/s, report in kbit/s to stay integer */
+    uint32_t kbps = (time > 0) ? (uint32_t)(((uint64_t)bytes * 8000) / time) : 0;
+
+    printf("{ \"role\" : \"%s\", \"bytes\" : %" PRIu32 ", \"time\" : %" PRIu32
+           ", \"kbit_per_s\" : %" PRIu32 ", \"queue_size\" : %u"
+           ", \"window\" : %u }\n", role, bytes, time, kbps,
+           (unsigned)CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE,
+           (unsigned)CONFIG_GNRC_TCP_DEFAULT_WINDOW);
+}
+
+static int _server(int argc, char **argv)
+{
+    gnrc_tcp_ep_t local = { .family = AF_INET6 };
+    uint32_t bytes = 0;
+    uint32_t time = 0;
+    ssize_t res;
+
+    if (argc < 2) {
+        printf("usage: %s <port>\n", argv[0]);
+        return 1;
+    }
+    local.port = atoi(argv[1]);
+
+    gnrc_tcp_tcb_init(&_tcb);
+    puts("server: waiting for connection");
+    if (gnrc_tcp_open_passive(&_tcb, &local) < 0) {
+        puts("server: unable to open connection");
+        return 1;
+    }
+    /* Receive until the peer closes the connection */
+    while ((res = gnrc_tcp_recv(&_tcb, _buf, sizeof(_buf),
+                                BENCH_RECV_TIMEOUT_MS)) > 0) {
+        if (bytes == 0) {
+            time = xtimer_now_usec();
+        }
+        bytes += res;
+    }
+    time = xtimer_now_usec() - time;
+    gnrc_tcp_close(&_tcb);
+    if (res < 0) {
+        printf("server: receive failed (%d)\n", (int)res);
+        return 1;
+    }
+    _print_result("server", bytes, time);
+    return 0;
+}
+
+static int _client(int argc, char **argv)
+{
+    gnrc_tcp_ep_t remote;
+    uint32_t bytes = 0;
+    uint32_t time;
+
+    if (argc < 2) {
+        printf("usage: %s <[addr%%netif]:port>\n", argv[0]);
+        return 1;
+    }
+    if (gnrc_tcp_ep_from_str(&remote, argv[1]) < 0) {
+        puts("client: invalid endpoint");
+        return 1;
+    }
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = i;
+    }
+
+    gnrc_tcp_tcb_init(&_tcb);
+    if (gnrc_tcp_open_active(&_tcb, &remote, 0) < 0) {
+        puts("client: unable to open connection");
+        return 1;
+    }
+    time = xtimer_now_usec();
+    while (bytes < BENCH_BYTES) {
+        size_t len = BENCH_BYTES - bytes;
+        ssize_t res;
+
+        len = (len < sizeof(_buf)) ? len : sizeof(_buf);
+        res = gnrc_tcp_send(&_tcb, _buf, len, 0);
+        if (res < 0) {
+            printf("client: send failed (%d)\n", (int)res);
+            gnrc_tcp_abort(&_tcb);
+            return 1;
+        }
+        bytes += res;
+    }
+    /* Closing waits until all data was acknowledged */
+    gnrc_tcp_close(&_tcb);
+    time = xtimer_now_usec() - time;
+    _print_result("client", bytes, time);
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "server", "receive data until the peer closes the connection", _server },
+    { "client", "send BENCH_BYTES bytes to a server", _client },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("GNRC TCP throughput benchmark");
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
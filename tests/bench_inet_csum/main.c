@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Internet Checksum benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL)
+#endif
+
+static const uint16_t _lens[] = { 64, 128, 256, 512, 1024, 1280 };
+
+static uint32_t _buf[(1280 + sizeof(uint32_t)) / sizeof(uint32_t)];
+
+/* sums up 16 bit at a time, for comparison */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < (len >> 1U); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if (len & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static int _bench(uint16_t len, unsigned offset)
+{
+    const uint8_t *buf = (uint8_t *)_buf + offset;
+    volatile uint16_t sum = 0;
+    uint32_t time, ref_time;
+
+    if (inet_csum(0, buf, len) != _ref_csum(0, buf, len)) {
+        printf("checksum mismatch for %u bytes at offset %u\n", len, offset);
+        return -1;
+    }
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        sum = inet_csum(sum, buf, len);
+    }
+    time = xtimer_now_usec() - time;
+    ref_time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        sum = _ref_csum(sum, buf, len);
+    }
+    ref_time = xtimer_now_usec() - ref_time;
+
+    printf("{ \"len\" : %u, \"offset\" : %u, \"runs\" : %lu, "
+           "\"time\" : %" PRIu32 ", \"ref_time\" : %" PRIu32 ", "
+           "\"ns_per_byte\" : %" PRIu32 " }\n",
+           len, offset, BENCH_RUNS, time, ref_time,
+           (uint32_t)(((uint64_t)time * NS_PER_US) / (BENCH_RUNS * len)));
+    return 0;
+}
+
+int main(void)
+{
+    uint8_t *buf = (uint8_t *)_buf;
+
+    puts("Internet Checksum benchmark\n");
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        buf[i] = (i * 7919U) >> 3;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_lens); i++) {
+        if ((_bench(_lens[i], 0) < 0) || (_bench(_lens[i], 1) < 0)) {
+            return 1;
+        }
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Internet Checksum benchmark")
+    child.expect(r"{ \"len\" : 64, \"offset\" : 0, \"runs\" : \d+, "
+                 r"\"time\" : \d+, \"ref_time\" : \d+, "
+                 r"\"ns_per_byte\" : \d+ }")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
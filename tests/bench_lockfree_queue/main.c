@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of the lock-free queues against tsrb and ringbuffer
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "irq.h"
+#include "mpscq.h"
+#include "ringbuffer.h"
+#include "spscq.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "tsrb.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (1000UL * 1000UL)
+#endif
+
+#define QUEUE_SIZE          (16U)
+#define FLAG_DATA           (0x0001)
+
+static uint8_t _tsrb_buf[QUEUE_SIZE * sizeof(uint32_t)];
+static tsrb_t _tsrb = TSRB_INIT(_tsrb_buf);
+static char _rb_buf[QUEUE_SIZE * sizeof(uint32_t)];
+static ringbuffer_t _rb = RINGBUFFER_INIT(_rb_buf);
+static uint8_t _spscq_buf[QUEUE_SIZE * sizeof(uint32_t)];
+static spscq_t _spscq;
+MPSCQ_BUF(_mpscq_buf, sizeof(uint32_t), QUEUE_SIZE);
+static mpscq_t _mpscq;
+
+static char _tsrb_stack[THREAD_STACKSIZE_DEFAULT];
+static char _spscq_stack[THREAD_STACKSIZE_DEFAULT];
+static char _mpscq_stack[THREAD_STACKSIZE_DEFAULT];
+static thread_t *_tsrb_consumer;
+
+static uint32_t _value;
+static volatile uint32_t _received;
+
+static void _tsrb_put_get(void)
+{
+    uint32_t out;
+
+    tsrb_add(&_tsrb, (uint8_t *)&_value, sizeof(_value));
+    tsrb_get(&_tsrb, (uint8_t *)&out, sizeof(out));
+    _received = out;
+}
+
+static void _ringbuffer_put_get(void)
+{
+    uint32_t out;
+    unsigned state;
+
+    /* ringbuffer is not safe against concurrent access on its own */
+    state = irq_disable();
+    ringbuffer_add(&_rb, (char *)&_value, sizeof(_value));
+    irq_restore(state);
+    state = irq_disable();
+    ringbuffer_get(&_rb, (char *)&out, sizeof(out));
+    irq_restore(state);
+    _received = out;
+}
+
+static void _spscq_put_get(void)
+{
+    uint32_t out;
+
+    spscq_put(&_spscq, &_value);
+    spscq_get(&_spscq, &out);
+    _received = out;
+}
+
+static void _mpscq_put_get(void)
+{
+    uint32_t out;
+
+    mpscq_put(&_mpscq, &_value);
+    mpscq_get(&_mpscq, &out);
+    _received = out;
+}
+
+static void *_tsrb_thread(void *arg)
+{
+    (void)arg;
+    while (1) {
+        uint32_t out;
+
+        thread_flags_wait_any(FLAG_DATA);
+        while (tsrb_get(&_tsrb, (uint8_t *)&out, sizeof(out)) > 0) {
+            _received = out;
+        }
+    }
+    return NULL;
+}
+
+static void *_spscq_thread(void *arg)
+{
+    (void)arg;
+    spscq_set_consumer(&_spscq, thread_get_active(), FLAG_DATA);
+    while (1) {
+        uint32_t out;
+
+        spscq_get_blocking(&_spscq, &out);
+        _received = out;
+    }
+    return NULL;
+}
+
+static void *_mpscq_thread(void *arg)
+{
+    (void)arg;
+    mpscq_set_consumer(&_mpscq, thread_get_active(), FLAG_DATA);
+    while (1) {
+        uint32_t out;
+
+        mpscq_get_blocking(&_mpscq, &out);
+        _received = out;
+    }
+    return NULL;
+}
+
+static void _tsrb_handoff(void)
+{
+    tsrb_add(&_tsrb, (uint8_t *)&_value, sizeof(_value));
+    thread_flags_set(_tsrb_consumer, FLAG_DATA);
+}
+
+static unsigned _check(void)
+{
+    if (_received != _value) {
+        printf("received %" PRIu32 " instead of %" PRIu32 "\n",
+               _received, _value);
+        return 1;
+    }
+    _received = 0;
+    return 0;
+}
+
+int main(void)
+{
+    unsigned errors = 0;
+
+    puts("Lock-free queue benchmark\n");
+
+    spscq_init(&_spscq, _spscq_buf, sizeof(uint32_t), QUEUE_SIZE);
+    mpscq_init(&_mpscq, _mpscq_buf, sizeof(uint32_t), QUEUE_SIZE);
+    _value = 0x1f2e3d4c;
+
+    BENCHMARK_FUNC("tsrb put/get", BENCH_RUNS, _tsrb_put_get());
+    errors += _check();
+    BENCHMARK_FUNC("ringbuffer put/get", BENCH_RUNS, _ringbuffer_put_get());
+    errors += _check();
+    BENCHMARK_FUNC("spscq put/get", BENCH_RUNS, _spscq_put_get());
+    errors += _check();
+    BENCHMARK_FUNC("mpscq put/get", BENCH_RUNS, _mpscq_put_get());
+    errors += _check();
+    puts("");
+
+    /* consumers have higher priority, so each put hands over to them */
+    _tsrb_consumer = thread_get(thread_create(_tsrb_stack,
+                                              sizeof(_tsrb_stack),
+                                              THREAD_PRIORITY_MAIN - 1,
+                                              THREAD_CREATE_STACKTEST,
+                                              _tsrb_thread, NULL,
+                                              "tsrb"));
+    thread_create(_spscq_stack, sizeof(_spscq_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _spscq_thread, NULL, "spscq");
+    thread_create(_mpscq_stack, sizeof(_mpscq_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _mpscq_thread, NULL, "mpscq");
+
+    BENCHMARK_FUNC("tsrb + thread flags handoff", BENCH_RUNS,
+                   _tsrb_handoff());
+    errors += _check();
+    BENCHMARK_FUNC("spscq handoff", BENCH_RUNS, spscq_put(&_spscq, &_value));
+    errors += _check();
+    BENCHMARK_FUNC("mpscq handoff", BENCH_RUNS, mpscq_put(&_mpscq, &_value));
+    errors += _check();
+
+    if (errors) {
+        puts("\n[FAILED]");
+        return 1;
+    }
+    puts("\n[SUCCESS]");
+    return 0;
+}
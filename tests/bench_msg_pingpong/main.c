@@ -19,16 +19,41 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "macros/units.h"
 #include "thread.h"
 
 #include "msg.h"
 #include "xtimer.h"
+#ifdef MODULE_MSG_BUF
+#include "msg_buf.h"
+#endif
 
 #ifndef TEST_DURATION
 #define TEST_DURATION       (1000000U)
 #endif
 
+#ifdef MODULE_MSG_BUF
+#ifndef SWEEP_DURATION
+#define SWEEP_DURATION      (TEST_DURATION / 4)
+#endif
+
+#ifndef SWEEP_PAYLOAD_MAX
+#define SWEEP_PAYLOAD_MAX   (512U)
+#endif
+
+enum {
+    MSG_TYPE_COPY = 0x4350,
+    MSG_TYPE_BUF,
+};
+
+static uint8_t _payload[SWEEP_PAYLOAD_MAX];
+static uint8_t _shared[SWEEP_PAYLOAD_MAX];
+static uint8_t _received[SWEEP_PAYLOAD_MAX];
+MSG_BUF_POOL(_pool_data, SWEEP_PAYLOAD_MAX, 1);
+static msg_buf_pool_t _pool;
+#endif
+
 volatile unsigned _flag = 0;
 static char _stack[THREAD_STACKSIZE_MAIN];
 
@@ -46,11 +71,82 @@ static void *_second_thread(void *arg)
 
     while(1) {
         msg_receive(&test);
+#ifdef MODULE_MSG_BUF
+        switch (test.type) {
+            case MSG_TYPE_COPY:
+                /* payload size is passed as content */
+                memcpy(_received, _shared, test.content.value);
+                break;
+            case MSG_TYPE_BUF:
+                /* consume in place and hand the buffer back to the pool */
+                msg_buf_free(msg_buf_get(&test));
+                break;
+            default:
+                break;
+        }
+#endif
     }
 
     return NULL;
 }
 
+#ifdef MODULE_MSG_BUF
+static uint32_t _sweep_copy(kernel_pid_t other, size_t size)
+{
+    msg_t msg = { .type = MSG_TYPE_COPY, .content = { .value = size } };
+    xtimer_t timer = { .callback = _timer_callback };
+    uint32_t n = 0;
+
+    _flag = 0;
+    xtimer_set(&timer, SWEEP_DURATION);
+    while (!_flag) {
+        memcpy(_shared, _payload, size);
+        msg_send(&msg, other);
+        n++;
+    }
+    return n;
+}
+
+static uint32_t _sweep_msg_buf(kernel_pid_t other, size_t size)
+{
+    xtimer_t timer = { .callback = _timer_callback };
+    uint32_t n = 0;
+
+    _flag = 0;
+    xtimer_set(&timer, SWEEP_DURATION);
+    while (!_flag) {
+        msg_t msg;
+        msg_buf_t *buf = msg_buf_alloc(&_pool);
+
+        /* the receiver has higher priority and frees the buffer before
+         * msg_buf_send() returns */
+        if (buf == NULL) {
+            puts("pool exhausted");
+            return 0;
+        }
+        memcpy(buf->data, _payload, size);
+        buf->len = size;
+        msg_buf_send(&msg, MSG_TYPE_BUF, buf, other);
+        n++;
+    }
+    return n;
+}
+
+static void _sweep(kernel_pid_t other)
+{
+    msg_buf_pool_init(&_pool, _pool_data, SWEEP_PAYLOAD_MAX, 1);
+    memset(_payload, 0x5a, sizeof(_payload));
+    for (size_t size = 8; size <= SWEEP_PAYLOAD_MAX; size *= 4) {
+        uint32_t copy = _sweep_copy(other, size);
+        uint32_t zero_copy = _sweep_msg_buf(other, size);
+
+        printf("{ \"payload\" : %u, \"copy\" : %"PRIu32
+               ", \"msg_buf\" : %"PRIu32" }\n",
+               (unsigned)size, copy, zero_copy);
+    }
+}
+#endif
+
 int main(void)
 {
     printf("main starting\n");
@@ -66,7 +162,7 @@ int main(void)
     xtimer_t timer;
     timer.callback = _timer_callback;
 
-    msg_t test;
+    msg_t test = { 0 };
 
     uint32_t n = 0;
 
@@ -83,5 +179,9 @@ int main(void)
 #endif
     puts(" }");
 
+#ifdef MODULE_MSG_BUF
+    _sweep(other);
+#endif
+
     return 0;
 }
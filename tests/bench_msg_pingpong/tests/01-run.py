@@ -7,12 +7,17 @@
 # General Public License v2.1. See the file LICENSE in the top level
 # directory for more details.
 
+import os
 import sys
 from testrunner import run
 
 
 def testfunc(child):
     child.expect(r"{ \"result\" : \d+(, \"ticks\" : \d+)? }")
+    if os.environ.get("PAYLOAD_SWEEP", "1") == "1":
+        for payload in (8, 32, 128, 512):
+            child.expect(r"{{ \"payload\" : {}, \"copy\" : \d+, "
+                         r"\"msg_buf\" : [1-9]\d* }}".format(payload))
 
 
 if __name__ == "__main__":
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for the wait time of a high priority thread on a
+ *              mutex held by a low priority thread
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS        (100U)
+#endif
+
+#ifndef BENCH_HOLD_US
+#define BENCH_HOLD_US       (1000U)
+#endif
+
+#ifndef BENCH_HOG_US
+#define BENCH_HOG_US        (10000U)
+#endif
+
+/* main is the low priority thread */
+#define PRIO_LINK           (THREAD_PRIORITY_MAIN - 1)
+#define PRIO_MID            (THREAD_PRIORITY_MAIN - 2)
+#define PRIO_HIGH           (THREAD_PRIORITY_MAIN - 3)
+
+static char _link_stack[THREAD_STACKSIZE_DEFAULT];
+static char _mid_stack[THREAD_STACKSIZE_DEFAULT];
+static char _high_stack[THREAD_STACKSIZE_DEFAULT];
+
+static kernel_pid_t _link_pid, _mid_pid, _high_pid;
+
+static mutex_t _low_mtx = MUTEX_INIT;
+static mutex_t _link_mtx = MUTEX_INIT;
+static bool _chained;
+
+static uint32_t _wait_sum;
+static uint32_t _wait_max;
+
+static void _spin(uint32_t us)
+{
+    uint32_t start = xtimer_now_usec();
+
+    while ((xtimer_now_usec() - start) < us) {}
+}
+
+static void *_link(void *arg)
+{
+    (void)arg;
+    while (1) {
+        thread_sleep();
+        mutex_lock(&_link_mtx);
+        mutex_lock(&_low_mtx);
+        mutex_unlock(&_low_mtx);
+        mutex_unlock(&_link_mtx);
+    }
+    return NULL;
+}
+
+static void *_mid(void *arg)
+{
+    (void)arg;
+    while (1) {
+        thread_sleep();
+        _spin(BENCH_HOG_US);
+    }
+    return NULL;
+}
+
+static void *_high(void *arg)
+{
+    (void)arg;
+    while (1) {
+        mutex_t *mutex;
+        uint32_t wait;
+
+        thread_sleep();
+        mutex = (_chained) ? &_link_mtx : &_low_mtx;
+        wait = xtimer_now_usec();
+        mutex_lock(mutex);
+        wait = xtimer_now_usec() - wait;
+        mutex_unlock(mutex);
+        _wait_sum += wait;
+        if (wait > _wait_max) {
+            _wait_max = wait;
+        }
+    }
+    return NULL;
+}
+
+static void _run(const char *name, bool chained)
+{
+    _chained = chained;
+    _wait_sum = 0;
+    _wait_max = 0;
+    for (unsigned i = 0; i < BENCH_ROUNDS; i++) {
+        mutex_lock(&_low_mtx);
+        if (chained) {
+            /* link takes its mutex and blocks on ours */
+            thread_wakeup(_link_pid);
+        }
+        /* all threads woken up preempt us until they block or sleep */
+        thread_wakeup(_high_pid);
+        thread_wakeup(_mid_pid);
+        _spin(BENCH_HOLD_US);
+        mutex_unlock(&_low_mtx);
+    }
+    printf("{ \"scenario\" : \"%s\", \"inheritance\" : %u, \"rounds\" : %u, "
+           "\"avg_us\" : %" PRIu32 ", \"max_us\" : %" PRIu32 " }\n",
+           name, IS_USED(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE),
+           BENCH_ROUNDS, _wait_sum / BENCH_ROUNDS, _wait_max);
+}
+
+int main(void)
+{
+    puts("Mutex priority inversion latency benchmark\n");
+
+    _link_pid = thread_create(_link_stack, sizeof(_link_stack), PRIO_LINK,
+                              THREAD_CREATE_STACKTEST, _link, NULL, "link");
+    _mid_pid = thread_create(_mid_stack, sizeof(_mid_stack), PRIO_MID,
+                             THREAD_CREATE_STACKTEST, _mid, NULL, "mid");
+    _high_pid = thread_create(_high_stack, sizeof(_high_stack), PRIO_HIGH,
+                              THREAD_CREATE_STACKTEST, _high, NULL, "high");
+
+    _run("direct", false);
+    _run("chained", true);
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Request dispatch benchmark for nanocoap resource tables
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#ifndef RESOURCES_NUMOF
+#define RESOURCES_NUMOF     (500U)
+#endif
+
+#ifndef BENCH_DISPATCHES
+#define BENCH_DISPATCHES    (10000UL)
+#endif
+
+#define BENCH_REQS_NUMOF    (16U)
+#define BENCH_BUF_SIZE      (64U)
+#define BENCH_PATH_LEN      (16U)
+
+static const uint16_t _table_sizes[] = { 10, 20, 50, 100, 200, 500 };
+
+static char _paths[RESOURCES_NUMOF][BENCH_PATH_LEN];
+static coap_resource_t _resources[RESOURCES_NUMOF];
+
+static uint8_t _req_bufs[BENCH_REQS_NUMOF][BENCH_BUF_SIZE];
+static coap_pkt_t _reqs[BENCH_REQS_NUMOF];
+static uint8_t _resp_buf[BENCH_BUF_SIZE];
+
+static unsigned _handled;
+
+/* nanocoap's default request handler uses the global resource table */
+const coap_resource_t coap_resources[] = {
+    COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER,
+};
+
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static ssize_t _handler(coap_pkt_t *pkt, uint8_t *buf, size_t len, void *ctx)
+{
+    (void)pkt;
+    (void)buf;
+    (void)len;
+    (void)ctx;
+    _handled++;
+    return 0;
+}
+
+static int _cmp_resource(const void *a, const void *b)
+{
+    return strcmp(((const coap_resource_t *)a)->path,
+                  ((const coap_resource_t *)b)->path);
+}
+
+static void _fill(unsigned numof)
+{
+    /* ten resources per LwM2M-like object, sorted by path */
+    for (unsigned i = 0; i < numof; i++) {
+        snprintf(_paths[i], BENCH_PATH_LEN, "/%u/0/%u", 3300 + (i / 10),
+                 5700 + (i % 10));
+        _resources[i].path = _paths[i];
+        _resources[i].methods = COAP_GET | COAP_PUT;
+        _resources[i].handler = _handler;
+        _resources[i].context = NULL;
+    }
+    qsort(_resources, numof, sizeof(_resources[0]), _cmp_resource);
+}
+
+static int _build_reqs(unsigned numof)
+{
+    for (unsigned i = 0; i < BENCH_REQS_NUMOF; i++) {
+        const char *path = _resources[(i * 7919U) % numof].path;
+        ssize_t len = coap_build_hdr((coap_hdr_t *)_req_bufs[i], COAP_TYPE_NON,
+                                     NULL, 0, COAP_METHOD_GET, i);
+        coap_pkt_t *pkt = &_reqs[i];
+
+        coap_pkt_init(pkt, _req_bufs[i], BENCH_BUF_SIZE, len);
+        coap_opt_add_string(pkt, COAP_OPT_URI_PATH, path, '/');
+        len = coap_opt_finish(pkt, COAP_OPT_FINISH_NONE);
+        if (coap_parse(pkt, _req_bufs[i], len) < 0) {
+            printf("unable to parse request for %s\n", path);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* linear search as coap_tree_handler() did before the binary search */
+static ssize_t _linear_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
+                               unsigned resp_buf_len,
+                               const coap_resource_t *resources,
+                               size_t resources_numof)
+{
+    coap_method_flags_t method_flag = coap_method2flag(coap_get_code_detail(pkt));
+    uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
+
+    if (coap_get_uri_path(pkt, uri) <= 0) {
+        return -EBADMSG;
+    }
+    for (unsigned i = 0; i < resources_numof; i++) {
+        const coap_resource_t *resource = &resources[i];
+        if (!(resource->methods & method_flag)) {
+            continue;
+        }
+
+        int res = coap_match_path(resource, uri);
+        if (res > 0) {
+            continue;
+        }
+        else if (res < 0) {
+            break;
+        }
+        else {
+            return resource->handler(pkt, resp_buf, resp_buf_len,
+                                     resource->context);
+        }
+    }
+    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+}
+
+static int _bench(unsigned numof)
+{
+    uint32_t linear_time, time;
+
+    _fill(numof);
+    if (_build_reqs(numof) < 0) {
+        return -1;
+    }
+
+    _handled = 0;
+    linear_time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_DISPATCHES; i++) {
+        _linear_handler(&_reqs[i % BENCH_REQS_NUMOF], _resp_buf,
+                        sizeof(_resp_buf), _resources, numof);
+    }
+    linear_time = xtimer_now_usec() - linear_time;
+
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_DISPATCHES; i++) {
+        coap_tree_handler(&_reqs[i % BENCH_REQS_NUMOF], _resp_buf,
+                          sizeof(_resp_buf), _resources, numof);
+    }
+    time = xtimer_now_usec() - time;
+
+    if (_handled != 2 * BENCH_DISPATCHES) {
+        printf("only %u of %lu requests found their resource\n", _handled,
+               2 * BENCH_DISPATCHES);
+        return -1;
+    }
+
+    printf("{ \"resources\" : %u, \"requests\" : %lu, "
+           "\"ns_per_linear\" : %" PRIu32 ", \"ns_per_dispatch\" : %" PRIu32
+           " }\n", numof, BENCH_DISPATCHES,
+           (uint32_t)(((uint64_t)linear_time * NS_PER_US) / BENCH_DISPATCHES),
+           (uint32_t)(((uint64_t)time * NS_PER_US) / BENCH_DISPATCHES));
+    return 0;
+}
+
+int main(void)
+{
+    puts("CoAP request dispatch benchmark\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_table_sizes); i++) {
+        if (_table_sizes[i] > RESOURCES_NUMOF) {
+            break;
+        }
+        if (_bench(_table_sizes[i]) < 0) {
+            return 1;
+        }
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
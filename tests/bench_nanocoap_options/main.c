@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Option parsing benchmark for nanocoap
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#ifndef BENCH_REQUESTS
+#define BENCH_REQUESTS      (10000UL)
+#endif
+
+#define BENCH_BUF_SIZE      (128U)
+
+static uint8_t _req_buf[BENCH_BUF_SIZE];
+static size_t _req_len;
+static coap_pkt_t _pkt;
+static uint8_t _uri[CONFIG_NANOCOAP_URI_MAX];
+
+/* nanocoap's default request handler uses the global resource table */
+const coap_resource_t coap_resources[] = {
+    COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER,
+};
+
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static int _build_req(void)
+{
+    coap_block1_t block1 = { .blknum = 3, .szx = 2, .more = 1 };
+    coap_block1_t block2 = { .blknum = 0, .szx = 2, .more = 0 };
+    ssize_t len = coap_build_hdr((coap_hdr_t *)_req_buf, COAP_TYPE_CON,
+                                 (uint8_t *)"\x12\x34\x56\x78", 4,
+                                 COAP_METHOD_PUT, 0x1234);
+
+    coap_pkt_init(&_pkt, _req_buf, sizeof(_req_buf), len);
+    /* options must be added in ascending order of their numbers */
+    coap_opt_add_string(&_pkt, COAP_OPT_URI_HOST, "node.example", 0);
+    coap_opt_add_uint(&_pkt, COAP_OPT_OBSERVE, 0);
+    coap_opt_add_uri_path(&_pkt, "/3303/0/5700");
+    coap_opt_add_format(&_pkt, COAP_FORMAT_CBOR);
+    coap_opt_add_uri_query(&_pkt, "ep", "node");
+    coap_opt_add_uri_query(&_pkt, "lt", "300");
+    coap_opt_add_uint(&_pkt, COAP_OPT_ACCEPT, COAP_FORMAT_CBOR);
+    coap_opt_add_block2_control(&_pkt, &block2);
+    coap_opt_add_block1_control(&_pkt, &block1);
+    len = coap_opt_finish(&_pkt, COAP_OPT_FINISH_NONE);
+    if (len < 0) {
+        return -1;
+    }
+    _req_len = len;
+    return 0;
+}
+
+/* reads the options a typical handler is interested in with the getters */
+static uint32_t _read_index(const coap_pkt_t *pkt)
+{
+    coap_block1_t block1, block2;
+    uint32_t accept = 0, observe = 0;
+    uint32_t sum = 0;
+
+    sum += coap_get_uri_path(pkt, _uri);
+    sum += coap_get_uri_query(pkt, _uri);
+    sum += coap_get_content_type((coap_pkt_t *)pkt);
+    coap_opt_get_uint(pkt, COAP_OPT_ACCEPT, &accept);
+    coap_get_block1((coap_pkt_t *)pkt, &block1);
+    coap_get_block2((coap_pkt_t *)pkt, &block2);
+    coap_opt_get_uint(pkt, COAP_OPT_OBSERVE, &observe);
+    return sum + accept + observe + block1.blknum + block1.szx +
+           block2.blknum + block2.szx;
+}
+
+/* joins all options opt_num like coap_opt_get_string(), but walks all
+ * options from the start of the PDU */
+static ssize_t _walk_string(const coap_pkt_t *pkt, unsigned opt_num,
+                            uint8_t *target, size_t max_len, char separator)
+{
+    coap_optpos_t opt;
+    uint8_t *value;
+    ssize_t len;
+    size_t pos = 0;
+
+    for (bool init = true;
+         (len = coap_opt_get_next(pkt, &opt, &value, init)) >= 0;
+         init = false) {
+        if (opt.opt_num > opt_num) {
+            break;
+        }
+        if (opt.opt_num == opt_num) {
+            if ((pos + len + 2) > max_len) {
+                return -ENOSPC;
+            }
+            target[pos++] = separator;
+            memcpy(&target[pos], value, len);
+            pos += len;
+        }
+    }
+    if (pos == 0) {
+        target[pos++] = separator;
+    }
+    target[pos] = '\0';
+    return pos + 1;
+}
+
+static int _walk_uint(const coap_pkt_t *pkt, unsigned opt_num, uint32_t *target)
+{
+    coap_optpos_t opt;
+    uint8_t *value;
+    ssize_t len;
+
+    for (bool init = true;
+         (len = coap_opt_get_next(pkt, &opt, &value, init)) >= 0;
+         init = false) {
+        if (opt.opt_num > opt_num) {
+            break;
+        }
+        if (opt.opt_num == opt_num) {
+            if (len > 4) {
+                return -ENOSPC;
+            }
+            *target = 0;
+            for (ssize_t i = 0; i < len; i++) {
+                *target = (*target << 8) | value[i];
+            }
+            return 0;
+        }
+    }
+    return -ENOENT;
+}
+
+/* reads the same options as _read_index(), walking the options every time */
+static uint32_t _read_walk(const coap_pkt_t *pkt)
+{
+    uint32_t ct = COAP_FORMAT_NONE, accept = 0, observe = 0;
+    uint32_t block1 = 0, block2 = 0;
+    uint32_t sum = 0;
+
+    sum += _walk_string(pkt, COAP_OPT_URI_PATH, _uri, sizeof(_uri), '/');
+    sum += _walk_string(pkt, COAP_OPT_URI_QUERY, _uri, sizeof(_uri), '&');
+    _walk_uint(pkt, COAP_OPT_CONTENT_FORMAT, &ct);
+    _walk_uint(pkt, COAP_OPT_ACCEPT, &accept);
+    _walk_uint(pkt, COAP_OPT_BLOCK1, &block1);
+    _walk_uint(pkt, COAP_OPT_BLOCK2, &block2);
+    _walk_uint(pkt, COAP_OPT_OBSERVE, &observe);
+    return sum + ct + accept + observe +
+           (block1 >> COAP_BLOCKWISE_NUM_OFF) + (block1 & COAP_BLOCKWISE_SZX_MASK) +
+           (block2 >> COAP_BLOCKWISE_NUM_OFF) + (block2 & COAP_BLOCKWISE_SZX_MASK);
+}
+
+int main(void)
+{
+    uint32_t parse_time, index_time, walk_time;
+    uint32_t index_sum = 0, walk_sum = 0;
+
+    puts("CoAP option parsing benchmark\n");
+
+    if ((_build_req() < 0) || (coap_parse(&_pkt, _req_buf, _req_len) < 0)) {
+        puts("unable to build request");
+        return 1;
+    }
+
+    parse_time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_REQUESTS; i++) {
+        coap_parse(&_pkt, _req_buf, _req_len);
+    }
+    parse_time = xtimer_now_usec() - parse_time;
+
+    index_time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_REQUESTS; i++) {
+        index_sum += _read_index(&_pkt);
+    }
+    index_time = xtimer_now_usec() - index_time;
+
+    walk_time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_REQUESTS; i++) {
+        walk_sum += _read_walk(&_pkt);
+    }
+    walk_time = xtimer_now_usec() - walk_time;
+
+    if (index_sum != walk_sum) {
+        printf("options differ: %" PRIu32 " != %" PRIu32 "\n",
+               index_sum, walk_sum);
+        return 1;
+    }
+
+    printf("{ \"options\" : %u, \"requests\" : %lu, \"ns_per_parse\" : %" PRIu32
+           ", \"ns_per_index\" : %" PRIu32 ", \"ns_per_walk\" : %" PRIu32 " }\n",
+           _pkt.options_len, BENCH_REQUESTS,
+           (uint32_t)(((uint64_t)parse_time * NS_PER_US) / BENCH_REQUESTS),
+           (uint32_t)(((uint64_t)index_time * NS_PER_US) / BENCH_REQUESTS),
+           (uint32_t)(((uint64_t)walk_time * NS_PER_US) / BENCH_REQUESTS));
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for 6LoWPAN IPHC encoding of a single flow
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/udp.h"
+#include "net/netdev_test.h"
+#include "test_utils/expect.h"
+#include "xtimer.h"
+
+#ifndef BENCH_PACKETS
+#define BENCH_PACKETS       (10000U)
+#endif
+
+#define BENCH_CTX_ID        (1U)
+#define BENCH_PORT          (61616U)
+#define BENCH_FRAME_MAX     (127U)
+
+static const uint8_t _src_l2[] = { 0x2a, 0xab, 0xdc, 0x15,
+                                   0x54, 0x01, 0x64, 0x79 };
+static const uint8_t _dst_l2[] = { 0x5a, 0x9d, 0x93, 0x86,
+                                   0x22, 0x08, 0x65, 0x79 };
+static const uint8_t _payload[] = "6lo-bench";
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _dev;
+static gnrc_netif_t _netif;
+
+static uint8_t _first[BENCH_FRAME_MAX];
+static size_t _first_len;
+static unsigned _frames;
+static unsigned _mismatches;
+
+static int _get_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len == sizeof(gnrc_nettype_t));
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_max_pdu_size(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = 102U;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_src_l2);
+    return sizeof(uint16_t);
+}
+
+static int _get_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len >= sizeof(_src_l2));
+    memcpy(value, _src_l2, sizeof(_src_l2));
+    return sizeof(_src_l2);
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    uint8_t frame[BENCH_FRAME_MAX];
+    size_t len = 0;
+
+    (void)dev;
+    /* skip the MAC header, its sequence number changes with every frame */
+    for (iolist = iolist->iol_next; iolist; iolist = iolist->iol_next) {
+        if ((len + iolist->iol_len) > sizeof(frame)) {
+            return -EMSGSIZE;
+        }
+        memcpy(&frame[len], iolist->iol_base, iolist->iol_len);
+        len += iolist->iol_len;
+    }
+    /* ignore neighbor discovery of the IPv6 stack */
+    if ((len < sizeof(_payload)) ||
+        memcmp(&frame[len - sizeof(_payload)], _payload, sizeof(_payload))) {
+        return len;
+    }
+    if (_frames++ == 0) {
+        memcpy(_first, frame, len);
+        _first_len = len;
+    }
+    else if ((len != _first_len) || memcmp(_first, frame, len)) {
+        _mismatches++;
+    }
+    return len;
+}
+
+static void _init_netif(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_PROTO, _get_proto);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PDU_SIZE, _get_max_pdu_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS_LONG, _get_addr_long);
+    netdev_test_set_send_cb(&_dev, _send);
+    gnrc_netif_ieee802154_create(&_netif, _netif_stack, sizeof(_netif_stack),
+                                 GNRC_NETIF_PRIO, "bench",
+                                 (netdev_t *)&_dev);
+    thread_yield_higher();
+}
+
+static void _set_addr(ipv6_addr_t *addr, const ipv6_addr_t *prefix,
+                      const uint8_t *l2addr)
+{
+    memcpy(addr, prefix, sizeof(ipv6_addr_t) / 2);
+    memcpy(&addr->u8[8], l2addr, 8);
+    addr->u8[8] ^= 0x02;    /* flip universal/local bit for the IID */
+}
+
+static gnrc_pktsnip_t *_build(const ipv6_addr_t *src, const ipv6_addr_t *dst)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                          GNRC_NETTYPE_UNDEF);
+    expect(pkt != NULL);
+    pkt = gnrc_udp_hdr_build(pkt, BENCH_PORT, BENCH_PORT + 1);
+    expect(pkt != NULL);
+    pkt = gnrc_ipv6_hdr_build(pkt, src, dst);
+    expect(pkt != NULL);
+    ((ipv6_hdr_t *)pkt->data)->nh = PROTNUM_UDP;
+    ((ipv6_hdr_t *)pkt->data)->hl = 64;
+    netif = gnrc_netif_hdr_build(NULL, 0, _dst_l2, sizeof(_dst_l2));
+    expect(netif != NULL);
+    gnrc_netif_hdr_set_netif(netif->data, &_netif);
+    netif->next = pkt;
+    return netif;
+}
+
+static int _run(const char *name, const ipv6_addr_t *prefix)
+{
+    ipv6_addr_t src, dst;
+    uint32_t time;
+
+    _set_addr(&src, prefix, _src_l2);
+    _set_addr(&dst, prefix, _dst_l2);
+    _frames = 0;
+    _mismatches = 0;
+    time = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_PACKETS; i++) {
+        /* 6LoWPAN thread has higher priority, so the frame is sent when
+         * this returns */
+        gnrc_netapi_send(gnrc_sixlowpan_get_pid(), _build(&src, &dst));
+    }
+    time = xtimer_now_usec() - time;
+    if ((_frames != BENCH_PACKETS) || (_mismatches > 0)) {
+        printf("flow %s: %u of %u frames sent, %u differ from the first\n",
+               name, _frames, BENCH_PACKETS, _mismatches);
+        return 1;
+    }
+    printf("{ \"flow\" : \"%s\", \"cache\" : %u, \"packets\" : %u, "
+           "\"ns_per_packet\" : %" PRIu32 " }\n",
+           name, IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE), BENCH_PACKETS,
+           (uint32_t)(((uint64_t)time * NS_PER_US) / BENCH_PACKETS));
+    return 0;
+}
+
+int main(void)
+{
+    static const ipv6_addr_t global = { .u8 = { 0x20, 0x01, 0x0d, 0xb8 } };
+
+    puts("6LoWPAN IPHC encoding benchmark\n");
+
+    _init_netif();
+    expect(gnrc_sixlowpan_ctx_update(BENCH_CTX_ID, &global, 64, UINT16_MAX,
+                                     true) != NULL);
+    if (_run("link-local", &ipv6_addr_link_local_prefix) ||
+        _run("context", &global)) {
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
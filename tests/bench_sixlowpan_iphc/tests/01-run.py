@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("6LoWPAN IPHC encoding benchmark")
+    for _ in range(2):
+        child.expect(r"{ \"flow\" : \"[\w-]+\", \"cache\" : \d+, "
+                     r"\"packets\" : \d+, \"ns_per_packet\" : \d+ }")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -44,6 +44,9 @@
 #include "print_results.h"
 #include "spin_random.h"
 #include "bench_timers_config.h"
+#if TEST_ZTIMER_SET
+#include "ztimer_set_bench.h"
+#endif
 
 #ifndef TEST_TRACE
 #define TEST_TRACE 0
@@ -702,6 +705,9 @@ int main(void)
         return res;
     }
     random_init(seed);
+#if TEST_ZTIMER_SET
+    ztimer_set_bench(TIM_REF_DEV);
+#endif
 
 #if !(TEST_XTIMER)
     res = timer_init(TIM_TEST_DEV, TIM_TEST_FREQ, cb_timer_periph, &test_context);
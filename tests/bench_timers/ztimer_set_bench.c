@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       ztimer_set()/ztimer_remove() latency benchmark
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "fmt.h"
+#include "kernel_defines.h"
+#include "matstat.h"
+#include "random.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#include "ztimer_set_bench.h"
+
+#if TEST_ZTIMER_SET
+
+#ifndef ZTIMER_SET_BENCH_ROUNDS
+#define ZTIMER_SET_BENCH_ROUNDS     (1000U)
+#endif
+
+/* upper bound for the timeouts, in ticks of the mock clock */
+#define ZTIMER_SET_BENCH_MAX_VAL    (1000000UL)
+
+static const uint16_t _timers_numof[] = { 1, 4, 16, 64, 256 };
+
+static ztimer_t _timers[256];
+static ztimer_mock_t _mock;
+
+static void _nop(void *arg)
+{
+    (void)arg;
+}
+
+static void _print_stats(const char *op, unsigned numof,
+                         const matstat_state_t *state)
+{
+    print_str("{ \"op\" : \"");
+    print_str(op);
+    print_str("\", \"wheel\" : ");
+    print_u32_dec(IS_USED(MODULE_ZTIMER_WHEEL));
+    print_str(", \"timers\" : ");
+    print_u32_dec(numof);
+    print_str(", \"mean\" : ");
+    print_s32_dec(matstat_mean(state));
+    print_str(", \"max\" : ");
+    print_s32_dec(state->max);
+    print_str(" }\n");
+}
+
+static void _bench(tim_t ref_dev, unsigned numof)
+{
+    matstat_state_t set_state = MATSTAT_STATE_INIT;
+    matstat_state_t remove_state = MATSTAT_STATE_INIT;
+
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_set(&_mock.super, &_timers[i],
+                   random_uint32_range(0, ZTIMER_SET_BENCH_MAX_VAL));
+    }
+    for (unsigned k = 0; k < ZTIMER_SET_BENCH_ROUNDS; k++) {
+        ztimer_t *timer = &_timers[random_uint32_range(0, numof)];
+        uint32_t val = random_uint32_range(0, ZTIMER_SET_BENCH_MAX_VAL);
+        unsigned int begin;
+
+        begin = timer_read(ref_dev);
+        ztimer_remove(&_mock.super, timer);
+        matstat_add(&remove_state, timer_read(ref_dev) - begin);
+
+        begin = timer_read(ref_dev);
+        ztimer_set(&_mock.super, timer, val);
+        matstat_add(&set_state, timer_read(ref_dev) - begin);
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_remove(&_mock.super, &_timers[i]);
+    }
+    _print_stats("set", numof, &set_state);
+    _print_stats("remove", numof, &remove_state);
+}
+
+void ztimer_set_bench(tim_t ref_dev)
+{
+    print_str("ztimer_set()/ztimer_remove() latency in reference timer ticks\n");
+    ztimer_mock_init(&_mock, 32);
+    for (unsigned i = 0; i < ARRAY_SIZE(_timers); i++) {
+        _timers[i].callback = _nop;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_timers_numof); i++) {
+        _bench(ref_dev, _timers_numof[i]);
+    }
+}
+#else   /* TEST_ZTIMER_SET */
+typedef int dont_be_pedantic;
+#endif  /* TEST_ZTIMER_SET */
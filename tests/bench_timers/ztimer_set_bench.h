@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       ztimer_set()/ztimer_remove() latency benchmark declarations
+ *
+ * @}
+ */
+#ifndef ZTIMER_SET_BENCH_H
+#define ZTIMER_SET_BENCH_H
+
+#include "periph/timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Measure the latency of ztimer_set() and ztimer_remove() against the
+ *          number of timers armed on the clock
+ *
+ * The timers are armed on a mock clock that is never advanced, so only the
+ * cost of managing the timers is measured, not that of triggering them.
+ *
+ * @pre The periph_timer @p ref_dev must be initialized and running (counting).
+ *
+ * @param[in]   ref_dev     Timer device to measure the latency with, in its
+ *                          ticks
+ */
+void ztimer_set_bench(tim_t ref_dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZTIMER_SET_BENCH_H */
+/** @} */
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the lookup of request and Observe memos of gcoap
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#define PEER_PORT       (CONFIG_GCOAP_PORT + 1)
+#define OTHER_PORT      (CONFIG_GCOAP_PORT + 2)
+#define THIRD_PORT      (CONFIG_GCOAP_PORT + 3)
+#define TIMEOUT         (100U * US_PER_MS)
+#define REQ_NUMOF       (CONFIG_GCOAP_REQ_WAITING_MAX)
+
+#define CHECK(cond)     do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __func__, __LINE__, #cond); \
+            return -1; \
+        } \
+    } while (0)
+
+static ssize_t _obs_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/obs1", COAP_GET, _obs_handler, NULL },
+    { "/obs2", COAP_GET, _obs_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    &_resources[0],
+    ARRAY_SIZE(_resources),
+    NULL,
+    NULL
+};
+
+static sock_udp_t _peer;
+static sock_udp_t _other;
+static sock_udp_t _third;
+static uint8_t _buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+static uint16_t _msg_id;
+static mutex_t _resp_lock = MUTEX_INIT_LOCKED;
+static void *_resp_ctx;
+
+static ssize_t _obs_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            void *ctx)
+{
+    (void)ctx;
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote)
+{
+    (void)pdu;
+    (void)remote;
+    if (memo->state == GCOAP_MEMO_RESP) {
+        _resp_ctx = memo->context;
+        mutex_unlock(&_resp_lock);
+    }
+}
+
+static void _loopback_ep(sock_udp_ep_t *ep, uint16_t port)
+{
+    memset(ep, 0, sizeof(*ep));
+    ep->family = AF_INET6;
+    ep->netif = SOCK_ADDR_ANY_NETIF;
+    ep->port = port;
+    memcpy(ep->addr.ipv6, &ipv6_addr_loopback, sizeof(ep->addr.ipv6));
+}
+
+static void _token(uint8_t *token, unsigned num)
+{
+    memset(token, num, CONFIG_GCOAP_TOKENLEN);
+}
+
+/* sends a request with a given token to _peer through gcoap */
+static int _send_req(const uint8_t *token, void *ctx)
+{
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    sock_udp_ep_t remote;
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    _loopback_ep(&remote, PEER_PORT);
+    gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET, "/peer");
+    memcpy(pdu.token, token, CONFIG_GCOAP_TOKENLEN);
+    len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+    return (gcoap_req_send(buf, len, &remote, _resp_handler, ctx) > 0) ? 0 : -1;
+}
+
+/* receives a request sent by _send_req() */
+static int _recv_req(void)
+{
+    coap_pkt_t pdu;
+    ssize_t len = sock_udp_recv(&_peer, _buf, sizeof(_buf), TIMEOUT, NULL);
+
+    if ((len <= 0) || (coap_parse(&pdu, _buf, len) < 0)) {
+        return -1;
+    }
+    return 0;
+}
+
+/* sends a response with a token to gcoap and returns the context of the
+ * request it was matched to */
+static void *_respond(sock_udp_t *sock, const uint8_t *token)
+{
+    sock_udp_ep_t remote;
+    ssize_t len;
+
+    _loopback_ep(&remote, CONFIG_GCOAP_PORT);
+    len = coap_build_hdr((coap_hdr_t *)_buf, COAP_TYPE_NON, (uint8_t *)token,
+                         CONFIG_GCOAP_TOKENLEN, COAP_CODE_CONTENT, _msg_id++);
+    if ((len <= 0) || (sock_udp_send(sock, _buf, len, &remote) < 0)) {
+        return NULL;
+    }
+    if (xtimer_mutex_lock_timeout(&_resp_lock, TIMEOUT) < 0) {
+        return NULL;
+    }
+    return _resp_ctx;
+}
+
+/* sends an Observe request from sock to a resource of gcoap */
+static int _observe(sock_udp_t *sock, const char *path, const uint8_t *token,
+                    uint32_t observe)
+{
+    sock_udp_ep_t remote;
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    _loopback_ep(&remote, CONFIG_GCOAP_PORT);
+    gcoap_req_init(&pdu, _buf, sizeof(_buf), COAP_METHOD_GET, NULL);
+    memcpy(pdu.token, token, CONFIG_GCOAP_TOKENLEN);
+    coap_opt_add_uint(&pdu, COAP_OPT_OBSERVE, observe);
+    coap_opt_add_uri_path(&pdu, path);
+    len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+    if (sock_udp_send(sock, _buf, len, &remote) < 0) {
+        return -1;
+    }
+    /* the response tells that gcoap is done with the request */
+    return (sock_udp_recv(sock, _buf, sizeof(_buf), TIMEOUT, NULL) > 0) ? 0 : -1;
+}
+
+/* checks if a resource is observed with a token */
+static bool _observed(const coap_resource_t *resource, const uint8_t *token)
+{
+    coap_pkt_t pdu;
+
+    return (gcoap_obs_init(&pdu, _buf, sizeof(_buf), resource) == GCOAP_OBS_INIT_OK)
+        && (coap_get_token_len(&pdu) == CONFIG_GCOAP_TOKENLEN)
+        && (memcmp(pdu.token, token, CONFIG_GCOAP_TOKENLEN) == 0);
+}
+
+static bool _unobserved(const coap_resource_t *resource)
+{
+    coap_pkt_t pdu;
+
+    return gcoap_obs_init(&pdu, _buf, sizeof(_buf), resource) == GCOAP_OBS_INIT_UNUSED;
+}
+
+static int test_dup_token(void)
+{
+    uint8_t token[CONFIG_GCOAP_TOKENLEN];
+    int first, second;
+
+    _token(token, 0x5a);
+    CHECK(_send_req(token, &first) == 0);
+    CHECK(_recv_req() == 0);
+    CHECK(_send_req(token, &second) == 0);
+    CHECK(_recv_req() == 0);
+    /* both requests wait for a response with the same token, the one sent
+     * first gets the first response */
+    CHECK(_respond(&_peer, token) == &first);
+    CHECK(_respond(&_peer, token) == &second);
+    CHECK(gcoap_op_state() == 0);
+    return 0;
+}
+
+static int test_match(void)
+{
+    uint8_t tokens[REQ_NUMOF][CONFIG_GCOAP_TOKENLEN];
+    int ctxs[REQ_NUMOF];
+
+    for (unsigned i = 0; i < REQ_NUMOF; i++) {
+        _token(tokens[i], i + 1);
+        CHECK(_send_req(tokens[i], &ctxs[i]) == 0);
+        CHECK(_recv_req() == 0);
+    }
+    CHECK(gcoap_op_state() == REQ_NUMOF);
+    /* the token matches, but the response comes from another endpoint */
+    CHECK(_respond(&_other, tokens[0]) == NULL);
+    /* no request was sent with this token */
+    _token(tokens[0], REQ_NUMOF + 1);
+    CHECK(_respond(&_peer, tokens[0]) == NULL);
+    _token(tokens[0], 1);
+    CHECK(gcoap_op_state() == REQ_NUMOF);
+    /* answer in reverse order */
+    for (unsigned i = REQ_NUMOF; i > 0; i--) {
+        CHECK(_respond(&_peer, tokens[i - 1]) == &ctxs[i - 1]);
+        CHECK(gcoap_op_state() == (i - 1));
+    }
+    return 0;
+}
+
+static int test_observe(void)
+{
+    const coap_resource_t *obs1 = &_resources[0];
+    const coap_resource_t *obs2 = &_resources[1];
+    uint8_t token1[CONFIG_GCOAP_TOKENLEN];
+    uint8_t token2[CONFIG_GCOAP_TOKENLEN];
+    uint8_t token3[CONFIG_GCOAP_TOKENLEN];
+
+    _token(token1, 0x11);
+    _token(token2, 0x22);
+    _token(token3, 0x33);
+    CHECK(_unobserved(obs1));
+    CHECK(_unobserved(obs2));
+    /* one client observes both resources */
+    CHECK(_observe(&_peer, "/obs1", token1, COAP_OBS_REGISTER) == 0);
+    CHECK(_observe(&_peer, "/obs2", token2, COAP_OBS_REGISTER) == 0);
+    CHECK(_observed(obs1, token1));
+    CHECK(_observed(obs2, token2));
+    /* another client can't observe a resource that is already observed */
+    CHECK(_observe(&_other, "/obs1", token3, COAP_OBS_REGISTER) == 0);
+    CHECK(_observed(obs1, token1));
+    /* deregistration of one resource keeps the other */
+    CHECK(_observe(&_peer, "/obs1", token1, COAP_OBS_DEREGISTER) == 0);
+    CHECK(_unobserved(obs1));
+    CHECK(_observed(obs2, token2));
+    /* re-registration with a new token replaces the old token */
+    CHECK(_observe(&_peer, "/obs2", token3, COAP_OBS_REGISTER) == 0);
+    CHECK(_observed(obs2, token3));
+    CHECK(_observe(&_peer, "/obs2", token2, COAP_OBS_DEREGISTER) == 0);
+    CHECK(_observed(obs2, token3));
+    CHECK(_observe(&_peer, "/obs2", token3, COAP_OBS_DEREGISTER) == 0);
+    CHECK(_unobserved(obs2));
+    /* the first client is released, so two other clients fit */
+    CHECK(_observe(&_other, "/obs1", token1, COAP_OBS_REGISTER) == 0);
+    CHECK(_observe(&_third, "/obs2", token2, COAP_OBS_REGISTER) == 0);
+    CHECK(_observed(obs1, token1));
+    CHECK(_observed(obs2, token2));
+    CHECK(_observe(&_other, "/obs1", token1, COAP_OBS_DEREGISTER) == 0);
+    CHECK(_observe(&_third, "/obs2", token2, COAP_OBS_DEREGISTER) == 0);
+    CHECK(_unobserved(obs1));
+    CHECK(_unobserved(obs2));
+    return 0;
+}
+
+int main(void)
+{
+    sock_udp_ep_t local;
+
+    puts("gcoap memo lookup test\n");
+
+    gcoap_register_listener(&_listener);
+    _loopback_ep(&local, PEER_PORT);
+    if (sock_udp_create(&_peer, &local, NULL, 0) < 0) {
+        puts("unable to create peer socket");
+        return 1;
+    }
+    _loopback_ep(&local, OTHER_PORT);
+    if (sock_udp_create(&_other, &local, NULL, 0) < 0) {
+        puts("unable to create other socket");
+        return 1;
+    }
+    _loopback_ep(&local, THIRD_PORT);
+    if (sock_udp_create(&_third, &local, NULL, 0) < 0) {
+        puts("unable to create third socket");
+        return 1;
+    }
+    /* the first test expects all request memos unused, so they are taken in
+     * the same order with and without gcoap_hash */
+    if ((test_dup_token() < 0) || (test_match() < 0) ||
+        (test_observe() < 0)) {
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -315,6 +315,139 @@ static void test_rbuf_add__success_duplicate_fragments(void)
     _check_pktbuf(entry);
 }
 
+static void test_rbuf_add__success_merge_intervals(void)
+{
+    gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt2 = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt3 = gnrc_pktbuf_add(NULL, _fragment3, sizeof(_fragment3),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_sixlowpan_frag_rb_t *entry1, *entry2;
+
+    TEST_ASSERT_NOT_NULL(pkt1);
+    TEST_ASSERT_NOT_NULL((entry1 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt1, TEST_FRAGMENT1_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT_NOT_NULL(pkt3);
+    TEST_ASSERT_NOT_NULL((entry2 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt3, TEST_FRAGMENT3_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT(entry1 == entry2);
+    /* fragment 1 and 3 are not adjacent, so there is a gap between them */
+    TEST_ASSERT_NOT_NULL(entry1->super.ints);
+    TEST_ASSERT_NOT_NULL(entry1->super.ints->next);
+    TEST_ASSERT_NULL(entry1->super.ints->next->next);
+    TEST_ASSERT_NOT_NULL(pkt2);
+    TEST_ASSERT_NOT_NULL((entry2 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt2, TEST_FRAGMENT2_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT(entry1 == entry2);
+    /* fragment 2 closes the gap, so all three fragments are one interval */
+    _test_entry(entry1, TEST_FRAGMENT4_OFFSET,
+                TEST_FRAGMENT1_OFFSET, TEST_FRAGMENT4_OFFSET - 1);
+    _check_pktbuf(entry1);
+}
+
+static void test_rbuf_add__success_duplicate_in_interval(void)
+{
+    gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt2 = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt3 = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt4 = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_sixlowpan_frag_rb_t *entry1, *entry2;
+
+    TEST_ASSERT_NOT_NULL(pkt1);
+    TEST_ASSERT_NOT_NULL((entry1 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt1, TEST_FRAGMENT1_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT_NOT_NULL(pkt2);
+    TEST_ASSERT_NOT_NULL((entry2 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt2, TEST_FRAGMENT2_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT(entry1 == entry2);
+    /* both fragments are now covered by one merged interval, duplicates of
+     * either must be recognized within it and not be counted again */
+    TEST_ASSERT_NOT_NULL(pkt3);
+    TEST_ASSERT_NOT_NULL((entry2 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt3, TEST_FRAGMENT1_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT(entry1 == entry2);
+    _test_entry(entry1, TEST_FRAGMENT3_OFFSET,
+                TEST_FRAGMENT1_OFFSET, TEST_FRAGMENT3_OFFSET - 1);
+    TEST_ASSERT_NOT_NULL(pkt4);
+    TEST_ASSERT_NOT_NULL((entry2 = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt4, TEST_FRAGMENT2_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT(entry1 == entry2);
+    _test_entry(entry1, TEST_FRAGMENT3_OFFSET,
+                TEST_FRAGMENT1_OFFSET, TEST_FRAGMENT3_OFFSET - 1);
+    _check_pktbuf(entry1);
+}
+
+static void test_rbuf_add__success_multiple_datagrams(void)
+{
+    static const uint16_t rm_tag = TEST_TAG + 1;
+    gnrc_sixlowpan_frag_rb_t *entries[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+    gnrc_sixlowpan_frag_rb_t *entry;
+    gnrc_pktsnip_t *pkt;
+
+    /* fill the reassembly buffer with one datagram per tag */
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        _set_fragment_tag(_fragment1, TEST_TAG + i);
+        pkt = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
+                              GNRC_NETTYPE_SIXLOWPAN);
+        TEST_ASSERT_NOT_NULL(pkt);
+        TEST_ASSERT_NOT_NULL((entries[i] = gnrc_sixlowpan_frag_rb_add(
+                &_test_netif_hdr.hdr, pkt, TEST_FRAGMENT1_OFFSET, TEST_PAGE
+            )));
+        TEST_ASSERT_EQUAL_INT(TEST_TAG + i, entries[i]->super.tag);
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        TEST_ASSERT(gnrc_sixlowpan_frag_rb_exists(&_test_netif_hdr.hdr,
+                                                  TEST_TAG + i));
+    }
+    /* a subsequent fragment must end up in the entry of its own tag */
+    _set_fragment_tag(_fragment2, rm_tag);
+    pkt = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL((entry = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt, TEST_FRAGMENT2_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT(entries[1] == entry);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT3_OFFSET, entry->super.current_size);
+    /* removing one datagram must not affect the others */
+    gnrc_sixlowpan_frag_rb_rm_by_datagram(&_test_netif_hdr.hdr, rm_tag);
+    TEST_ASSERT(!gnrc_sixlowpan_frag_rb_exists(&_test_netif_hdr.hdr, rm_tag));
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if ((TEST_TAG + i) != rm_tag) {
+            TEST_ASSERT(gnrc_sixlowpan_frag_rb_exists(&_test_netif_hdr.hdr,
+                                                      TEST_TAG + i));
+        }
+    }
+    /* a fragment of the removed datagram starts a new reassembly */
+    pkt = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL((entry = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt, TEST_FRAGMENT2_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT_EQUAL_INT(rm_tag, entry->super.tag);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT3_OFFSET - TEST_FRAGMENT2_OFFSET,
+                          entry->super.current_size);
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        gnrc_sixlowpan_frag_rb_rm_by_datagram(&_test_netif_hdr.hdr,
+                                              TEST_TAG + i);
+    }
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+}
+
 static void test_rbuf_add__success_complete(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
@@ -626,6 +759,9 @@ static void run_unittests(void)
         new_TestFixture(test_rbuf_add__success_first_fragment),
         new_TestFixture(test_rbuf_add__success_subsequent_fragment),
         new_TestFixture(test_rbuf_add__success_duplicate_fragments),
+        new_TestFixture(test_rbuf_add__success_merge_intervals),
+        new_TestFixture(test_rbuf_add__success_duplicate_in_interval),
+        new_TestFixture(test_rbuf_add__success_multiple_datagrams),
         new_TestFixture(test_rbuf_add__success_complete),
         new_TestFixture(test_rbuf_add__full_rbuf),
         new_TestFixture(test_rbuf_add__too_big_fragment),
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for mutex priority inheritance
+ *
+ * The main thread holds mutexes high priority threads wait for. It must keep
+ * the inherited priority as long as it holds any mutex with a waiter, no
+ * matter in which order it unlocks them or which other mutexes it uses in
+ * between.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PRIO_HIGH               (THREAD_PRIORITY_MAIN - 2)
+#define PRIO_MID                (THREAD_PRIORITY_MAIN - 1)
+
+static char stack_high[THREAD_STACKSIZE_DEFAULT];
+static char stack_mid[THREAD_STACKSIZE_DEFAULT];
+
+static mutex_t mutex_a = MUTEX_INIT;
+static mutex_t mutex_b = MUTEX_INIT;
+
+static unsigned failures;
+
+static void *_waiter(void *arg)
+{
+    mutex_t *mutex = arg;
+
+    mutex_lock(mutex);
+    mutex_unlock(mutex);
+    return NULL;
+}
+
+static void _expect(const char *step, uint8_t priority)
+{
+    uint8_t actual = thread_get_active()->priority;
+
+    printf("%s: priority %u, expected %u\n", step, (unsigned)actual,
+           (unsigned)priority);
+    if (actual != priority) {
+        failures++;
+    }
+}
+
+static void _test_nested(int lifo)
+{
+    printf("nested, unlocking in %s order\n", lifo ? "reverse" : "locking");
+    mutex_lock(&mutex_a);
+    mutex_lock(&mutex_b);
+    thread_create(stack_high, sizeof(stack_high), PRIO_HIGH, 0, _waiter,
+                  &mutex_a, "high");
+    _expect("high waits for a", PRIO_HIGH);
+    thread_create(stack_mid, sizeof(stack_mid), PRIO_MID, 0, _waiter,
+                  &mutex_b, "mid");
+    _expect("mid waits for b", PRIO_HIGH);
+    if (lifo) {
+        mutex_unlock(&mutex_b);
+        _expect("unlocked b", PRIO_HIGH);
+        mutex_unlock(&mutex_a);
+    }
+    else {
+        mutex_unlock(&mutex_a);
+        _expect("unlocked a", PRIO_MID);
+        mutex_unlock(&mutex_b);
+    }
+    _expect("unlocked all", THREAD_PRIORITY_MAIN);
+}
+
+static void _test_sleep(void)
+{
+    puts("sleeping while holding a mutex");
+    mutex_lock(&mutex_a);
+    thread_create(stack_high, sizeof(stack_high), PRIO_HIGH, 0, _waiter,
+                  &mutex_a, "high");
+    _expect("high waits for a", PRIO_HIGH);
+    /* blocks on a mutex unlocked from the timer ISR */
+    xtimer_usleep(1000);
+    _expect("slept", PRIO_HIGH);
+    mutex_unlock(&mutex_a);
+    _expect("unlocked a", THREAD_PRIORITY_MAIN);
+}
+
+int main(void)
+{
+    puts("Mutex priority inheritance test");
+
+    _test_nested(1);
+    _test_nested(0);
+    _test_sleep();
+
+    if (failures == 0) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] %u checks failed\n", failures);
+    }
+    return 0;
+}
@@ -10,16 +10,30 @@
  * @ingroup     tests
  * @{
  * @file
- * @brief       Test thread_yield()
+ * @brief       Test thread_yield() and fairness among threads of equal
+ *              priority
  * @author      Oliver Hahm <oliver.hahm@inria.fr>
  * @author      René Kijewski <rene.kijewski@fu-berlin.de>
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include "thread.h"
+#include "ztimer.h"
+
+#ifndef FAIRNESS_WORKERS
+#define FAIRNESS_WORKERS        (3U)
+#endif
+
+#ifndef FAIRNESS_DURATION_US
+#define FAIRNESS_DURATION_US    (1000000U)
+#endif
 
 char snd_thread_stack[THREAD_STACKSIZE_MAIN];
+static char _worker_stacks[FAIRNESS_WORKERS][THREAD_STACKSIZE_DEFAULT];
+static volatile uint32_t _counts[FAIRNESS_WORKERS];
+static volatile unsigned _stop;
 
 void *snd_thread(void *unused)
 {
@@ -28,6 +42,49 @@ void *snd_thread(void *unused)
     return NULL;
 }
 
+static void *_worker(void *arg)
+{
+    volatile uint32_t *count = arg;
+
+    /* CPU-bound: never blocks or yields on its own */
+    while (!_stop) {
+        (*count)++;
+    }
+    return NULL;
+}
+
+static void _fairness(void)
+{
+    uint64_t sum = 0, sum_sq = 0;
+
+    /* workers have lower priority than main, so they only run while main
+     * sleeps */
+    for (unsigned i = 0; i < FAIRNESS_WORKERS; i++) {
+        thread_create(_worker_stacks[i], sizeof(_worker_stacks[i]),
+                      THREAD_PRIORITY_MAIN + 1, THREAD_CREATE_STACKTEST,
+                      _worker, (void *)&_counts[i], "worker");
+    }
+    ztimer_sleep(ZTIMER_USEC, FAIRNESS_DURATION_US);
+    _stop = 1;
+
+    printf("{ \"round_robin\" : %u, \"counts\" : [",
+           IS_USED(MODULE_SCHED_ROUND_ROBIN));
+    for (unsigned i = 0; i < FAIRNESS_WORKERS; i++) {
+        /* scale down so that the squares below do not overflow */
+        uint64_t count = _counts[i] >> 10;
+
+        printf("%s%" PRIu32, (i == 0) ? "" : ", ", _counts[i]);
+        sum += count;
+        sum_sq += count * count;
+    }
+    /* Jain's fairness index: 1000 if all workers got the same CPU time,
+     * 1000 / FAIRNESS_WORKERS if a single worker got all of it */
+    printf("], \"fairness_permille\" : %" PRIu32 " }\n",
+           (sum_sq == 0) ? 0
+                         : (uint32_t)(((sum * sum) / FAIRNESS_WORKERS) * 1000 /
+                                      sum_sq));
+}
+
 int main(void)
 {
     puts("The output should be: yield 1, snd_thread running, yield 2, done");
@@ -42,5 +99,7 @@ int main(void)
     thread_yield();
     puts("done");
 
+    _fairness();
+
     return 0;
 }
@@ -13,6 +13,12 @@ def testfunc(child):
     child.expect_exact('snd_thread running')
     child.expect_exact('yield 2')
     child.expect_exact('done')
+    child.expect(r'{ "round_robin" : (\d), "counts" : \[([\d, ]+)\], '
+                 r'"fairness_permille" : (\d+) }')
+    if int(child.match.group(1)):
+        counts = [int(c) for c in child.match.group(2).split(", ")]
+        assert all(c > 0 for c in counts), "a worker starved"
+        assert int(child.match.group(3)) >= 900, "unfair time slicing"
 
 
 if __name__ == "__main__":
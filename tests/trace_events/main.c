@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Structured event tracing test application
+ *
+ * A second thread exchanges messages with the main thread and competes with
+ * it for a mutex, so context switches, messages and mutex contention end up
+ * in the trace buffer.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "trace.h"
+
+#define ROUNDS      (4U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _lock = MUTEX_INIT;
+
+static void *_pong(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        /* the main thread holds the lock until it receives the reply */
+        msg_reply(&msg, &msg);
+        mutex_lock(&_lock);
+        mutex_unlock(&_lock);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1, 0, _pong, NULL,
+                                     "pong");
+
+    trace_events_enable(TRACE_EVENTS_ALL);
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        msg_t msg = { .type = i };
+
+        mutex_lock(&_lock);
+        msg_send_receive(&msg, &msg, pid);
+        mutex_unlock(&_lock);
+    }
+    trace_event(TRACE_EVENT_USER, 42);
+    trace_events_enable(0);
+
+    trace_events_dump();
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"trace_events: v1 hz=\d+ records=(\d+) lost=\d+ isr=\d+\r\n")
+    records = int(child.match.group(1))
+    assert records > 0
+    child.expect(r"trace_events: thread \d+ main\r\n")
+    child.expect(r"trace_events: thread \d+ pong\r\n")
+    lines = []
+    while len("".join(lines)) < records * 16:
+        child.expect(r"trace_events: ([0-9a-f]+)\r\n")
+        lines.append(child.match.group(1))
+    # the last record is the user event with value 42
+    last = lines[-1][-16:]
+    assert last[8:10] == "00"
+    assert last[12:16] == "2a00"
+    child.expect_exact("trace_events: end")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
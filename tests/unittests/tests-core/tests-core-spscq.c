@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "spscq.h"
+
+#include "tests-core.h"
+
+#define TEST_SPSCQ_SIZE     (4U)
+
+/* odd element size to catch alignment and stride errors */
+typedef struct {
+    uint8_t a;
+    uint16_t b;
+    uint8_t c[3];
+} test_elem_t;
+
+static uint8_t _buf[TEST_SPSCQ_SIZE * sizeof(test_elem_t)];
+static spscq_t _q;
+
+static void set_up(void)
+{
+    spscq_init(&_q, _buf, sizeof(test_elem_t), TEST_SPSCQ_SIZE);
+}
+
+static void _fill(test_elem_t *elem, unsigned i)
+{
+    memset(elem, 0, sizeof(*elem));
+    elem->a = i;
+    elem->b = 0x1000 + i;
+    memset(elem->c, 0xc0 + i, sizeof(elem->c));
+}
+
+static void test_spscq_put(void)
+{
+    test_elem_t elem;
+
+    for (unsigned i = 0; i < TEST_SPSCQ_SIZE; i++) {
+        _fill(&elem, i);
+        TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, &elem));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, spscq_put(&_q, &elem));
+}
+
+static void test_spscq_get(void)
+{
+    test_elem_t in, out;
+
+    TEST_ASSERT_EQUAL_INT(-1, spscq_get(&_q, &out));
+    _fill(&in, 42);
+    TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, &in));
+    TEST_ASSERT_EQUAL_INT(0, spscq_get(&_q, &out));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&in, &out, sizeof(in)));
+    TEST_ASSERT_EQUAL_INT(-1, spscq_get(&_q, &out));
+}
+
+static void test_spscq_wrap_around(void)
+{
+    test_elem_t in, out;
+    unsigned reads = 0, writes = 0;
+
+    /* several rounds with the queue half full, so both counters wrap around
+     * the storage repeatedly */
+    for (unsigned round = 0; round < (TEST_SPSCQ_SIZE * 5); round++) {
+        while ((writes - reads) < (TEST_SPSCQ_SIZE / 2)) {
+            _fill(&in, writes++);
+            TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, &in));
+        }
+        _fill(&in, reads++);
+        TEST_ASSERT_EQUAL_INT(0, spscq_get(&_q, &out));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(&in, &out, sizeof(in)));
+    }
+    while (reads < writes) {
+        _fill(&in, reads++);
+        TEST_ASSERT_EQUAL_INT(0, spscq_get(&_q, &out));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(&in, &out, sizeof(in)));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, spscq_get(&_q, &out));
+}
+
+static void test_spscq_full_then_empty(void)
+{
+    test_elem_t in, out;
+
+    for (unsigned i = 0; i < TEST_SPSCQ_SIZE; i++) {
+        _fill(&in, i);
+        TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, &in));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, spscq_put(&_q, &in));
+    for (unsigned i = 0; i < TEST_SPSCQ_SIZE; i++) {
+        _fill(&in, i);
+        TEST_ASSERT_EQUAL_INT(0, spscq_get(&_q, &out));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(&in, &out, sizeof(in)));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, spscq_get(&_q, &out));
+    /* a slot freed by the consumer is usable again */
+    TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, &in));
+}
+
+static void test_spscq_avail(void)
+{
+    test_elem_t elem;
+
+    _fill(&elem, 0);
+    TEST_ASSERT_EQUAL_INT(0, spscq_avail(&_q));
+    TEST_ASSERT_EQUAL_INT(0, spscq_put(&_q, &elem));
+    TEST_ASSERT_EQUAL_INT(1, spscq_avail(&_q));
+    TEST_ASSERT_EQUAL_INT(0, spscq_get(&_q, &elem));
+    TEST_ASSERT_EQUAL_INT(0, spscq_avail(&_q));
+}
+
+Test *tests_core_spscq_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_spscq_put),
+        new_TestFixture(test_spscq_get),
+        new_TestFixture(test_spscq_wrap_around),
+        new_TestFixture(test_spscq_full_then_empty),
+        new_TestFixture(test_spscq_avail),
+    };
+
+    EMB_UNIT_TESTCALLER(core_spscq_tests, set_up, NULL, fixtures);
+
+    return (Test *)&core_spscq_tests;
+}
@@ -19,4 +19,6 @@ void tests_core(void)
     TESTS_RUN(tests_core_priority_queue_tests());
     TESTS_RUN(tests_core_byteorder_tests());
     TESTS_RUN(tests_core_ringbuffer_tests());
+    TESTS_RUN(tests_core_spscq_tests());
+    TESTS_RUN(tests_core_mpscq_tests());
 }
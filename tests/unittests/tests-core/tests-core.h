@@ -92,6 +92,20 @@ Test *tests_core_byteorder_tests(void);
  */
 Test *tests_core_ringbuffer_tests(void);
 
+/**
+ * @brief   Generates tests for spscq.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_core_spscq_tests(void);
+
+/**
+ * @brief   Generates tests for mpscq.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_core_mpscq_tests(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,7 @@
 #include "embUnit.h"
 
 #include "net/gcoap.h"
+#include "net/gcoap_block.h"
 
 #include "unittests-constants.h"
 #include "tests-gcoap.h"
@@ -385,6 +386,83 @@ static void test_gcoap__server_get_resource_list(void)
     TEST_ASSERT_EQUAL_STRING(resource_list_str, (char *)res);
 }
 
+/*
+ * Helper for server_block1_sink test below.
+ * Collects the data passed on by the sink.
+ */
+static uint8_t _sink_data[48];
+static unsigned _sink_writes;
+
+static int _sink_write(void *arg, size_t offset, uint8_t *buf, size_t len,
+                       int more)
+{
+    (void)arg;
+    (void)more;
+    if (offset + len > sizeof(_sink_data)) {
+        return -1;
+    }
+    memcpy(&_sink_data[offset], buf, len);
+    _sink_writes++;
+    return 0;
+}
+
+/*
+ * Helper for server_block1_sink test below.
+ * Passes a PUT request for the given block of data to the sink and returns
+ * the response code.
+ */
+static unsigned _put_block(gcoap_block1_sink_t *sink, const char *data,
+                           uint32_t blknum, int more, coap_block1_t *ack)
+{
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    coap_block1_t block1 = { .blknum = blknum, .szx = 0, .more = more };
+    size_t data_len = more ? 16 : strlen(&data[blknum * 16]);
+    coap_pkt_t pdu;
+
+    gcoap_req_init(&pdu, &buf[0], sizeof(buf), COAP_METHOD_PUT, "/upload");
+    coap_opt_add_block1_control(&pdu, &block1);
+    ssize_t len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
+    memcpy(pdu.payload, &data[blknum * 16], data_len);
+    coap_parse(&pdu, &buf[0], len + data_len);
+
+    gcoap_block1_sink_handler(&pdu, &buf[0], sizeof(buf), sink);
+    ack->more = -1;
+    coap_get_block1(&pdu, ack);
+    return coap_get_code(&pdu);
+}
+
+/*
+ * Server Block1 upload case. Test reassembly, retransmission and gap
+ * handling of the sink.
+ */
+static void test_gcoap__server_block1_sink(void)
+{
+    const char *data = "0123456789abcdef0123456789ABCDEFxyz";
+    gcoap_block1_sink_t sink = { .cb = _sink_write };
+    coap_block1_t ack;
+
+    memset(_sink_data, 0, sizeof(_sink_data));
+    _sink_writes = 0;
+
+    TEST_ASSERT_EQUAL_INT(231, _put_block(&sink, data, 0, 1, &ack));
+    TEST_ASSERT_EQUAL_INT(0, ack.blknum);
+    TEST_ASSERT_EQUAL_INT(1, ack.more);
+    /* a gap is refused */
+    TEST_ASSERT_EQUAL_INT(408, _put_block(&sink, data, 2, 0, &ack));
+    TEST_ASSERT_EQUAL_INT(-1, ack.more);
+    TEST_ASSERT_EQUAL_INT(231, _put_block(&sink, data, 1, 1, &ack));
+    TEST_ASSERT_EQUAL_INT(1, ack.blknum);
+    /* a retransmission is acknowledged again but not written */
+    TEST_ASSERT_EQUAL_INT(231, _put_block(&sink, data, 1, 1, &ack));
+    TEST_ASSERT_EQUAL_INT(2, _sink_writes);
+    TEST_ASSERT_EQUAL_INT(204, _put_block(&sink, data, 2, 0, &ack));
+    TEST_ASSERT_EQUAL_INT(2, ack.blknum);
+    TEST_ASSERT_EQUAL_INT(0, ack.more);
+    TEST_ASSERT_EQUAL_INT(204, _put_block(&sink, data, 2, 0, &ack));
+    TEST_ASSERT_EQUAL_INT(3, _sink_writes);
+    TEST_ASSERT_EQUAL_STRING(data, (char *)_sink_data);
+}
+
 Test *tests_gcoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -398,7 +476,8 @@ Test *tests_gcoap_tests(void)
         new_TestFixture(test_gcoap__server_get_resp),
         new_TestFixture(test_gcoap__server_con_req),
         new_TestFixture(test_gcoap__server_con_resp),
-        new_TestFixture(test_gcoap__server_get_resource_list)
+        new_TestFixture(test_gcoap__server_get_resource_list),
+        new_TestFixture(test_gcoap__server_block1_sink)
     };
 
     EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
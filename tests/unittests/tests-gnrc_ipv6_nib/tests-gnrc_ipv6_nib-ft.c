@@ -13,7 +13,9 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "bitfield.h"
 #include "net/ipv6/addr.h"
@@ -34,12 +36,10 @@
 
 static void set_up(void)
 {
-    evtimer_event_t *tmp;
-
-    for (evtimer_event_t *ptr = _nib_evtimer.events;
-         (ptr != NULL) && (tmp = (ptr->next), 1);
-         ptr = tmp) {
-        evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
+    /* delete the first event until none is left, this works for all
+     * evtimer backends */
+    while (_nib_evtimer.events != NULL) {
+        evtimer_del((evtimer_t *)(&_nib_evtimer), _nib_evtimer.events);
     }
     _nib_init();
 }
@@ -718,6 +718,107 @@ static void test_nib_ft_iter__empty_pref_route_in_the_middle(void)
     TEST_ASSERT_EQUAL_INT(2, count);
 }
 
+static uint32_t _rand_state = 0x9e3779b9;
+
+/* xorshift, so the route set is the same on every platform */
+static uint32_t _rand(void)
+{
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+/* prefixes below GLOBAL_PREFIX with sparse set bits, so many of them nest or
+ * are stored as the same address with different lengths */
+static void _rand_addr(ipv6_addr_t *addr)
+{
+    static const ipv6_addr_t pfx = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+
+    memcpy(addr, &pfx, sizeof(pfx));
+    for (unsigned i = 4; i < sizeof(addr->u8); i++) {
+        addr->u8[i] = ((_rand() % 4) == 0) ? (uint8_t)_rand() : 0;
+    }
+}
+
+/* reference: the linear longest match over the forwarding table */
+static int _ft_get_linear(const ipv6_addr_t *dst, gnrc_ipv6_nib_ft_t *res)
+{
+    gnrc_ipv6_nib_ft_t fte;
+    void *iter_state = NULL;
+    uint8_t best_match = 0;
+
+    while (gnrc_ipv6_nib_ft_iter(NULL, 0, &iter_state, &fte)) {
+        uint8_t match = ipv6_addr_match_prefix(&fte.dst, dst);
+
+        if ((fte.dst_len > 0) && (match > best_match) &&
+            (match >= fte.dst_len)) {
+            memcpy(res, &fte, sizeof(fte));
+            best_match = match;
+        }
+    }
+    return (best_match > 0) ? 0 : -ENETUNREACH;
+}
+
+/*
+ * Fills the forwarding table with random nested and overlapping routes, then
+ * deletes some of them and repeats. After every change destinations within
+ * and around the routes are looked up.
+ * Expected result: gnrc_ipv6_nib_ft_get() returns the same route as a linear
+ * search for the longest match over the forwarding table
+ */
+static void test_nib_ft_get__longest_match(void)
+{
+    gnrc_ipv6_nib_ft_t routes[CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
+    ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                      { .u64 = TEST_UINT64 } } };
+
+    for (unsigned round = 0; round < 16; round++) {
+        gnrc_ipv6_nib_ft_t fte, exp;
+        void *iter_state = NULL;
+        unsigned numof = 0;
+
+        for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
+            ipv6_addr_t dst;
+            unsigned dst_len = 32 + (_rand() % 97);
+            int res;
+
+            _rand_addr(&dst);
+            next_hop.u8[15] = _rand() % 4;
+            res = gnrc_ipv6_nib_ft_add(&dst, dst_len, &next_hop, IFACE, 0);
+            TEST_ASSERT((res == 0) || (res == -ENOMEM));
+        }
+        while (gnrc_ipv6_nib_ft_iter(NULL, 0, &iter_state, &fte)) {
+            memcpy(&routes[numof++], &fte, sizeof(fte));
+        }
+        for (unsigned i = 0; i < 64; i++) {
+            ipv6_addr_t dst;
+            int res;
+
+            if ((numof > 0) && (i & 1)) {
+                /* somewhere within or just outside of an existing route */
+                memcpy(&dst, &routes[_rand() % numof].dst, sizeof(dst));
+                dst.u8[_rand() % sizeof(dst.u8)] ^= (uint8_t)_rand();
+            }
+            else {
+                _rand_addr(&dst);
+            }
+            res = _ft_get_linear(&dst, &exp);
+            TEST_ASSERT_EQUAL_INT(res, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+            if (res == 0) {
+                TEST_ASSERT(ipv6_addr_equal(&exp.dst, &fte.dst));
+                TEST_ASSERT_EQUAL_INT(exp.dst_len, fte.dst_len);
+                TEST_ASSERT(ipv6_addr_equal(&exp.next_hop, &fte.next_hop));
+            }
+        }
+        for (unsigned i = 0; i < numof; i++) {
+            if ((_rand() % 3) == 0) {
+                gnrc_ipv6_nib_ft_del(&routes[i].dst, routes[i].dst_len);
+            }
+        }
+    }
+}
+
 Test *tests_gnrc_ipv6_nib_ft_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -727,6 +828,7 @@ Test *tests_gnrc_ipv6_nib_ft_tests(void)
         new_TestFixture(test_nib_ft_get__success2),
         new_TestFixture(test_nib_ft_get__success3),
         new_TestFixture(test_nib_ft_get__success4),
+        new_TestFixture(test_nib_ft_get__longest_match),
         new_TestFixture(test_nib_ft_add__EINVAL_def_route_next_hop_NULL),
         new_TestFixture(test_nib_ft_add__EINVAL_iface0),
         new_TestFixture(test_nib_ft_add__ENOMEM_diff_def_router),
@@ -361,6 +361,46 @@ static void test_nib_get__empty(void)
     TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
 }
 
+/*
+ * Fills the NIB with entries with different IP addresses on two interfaces,
+ * clears every second one and allocates them again.
+ * Expected result: _nib_onl_get() always returns the entry for an address on
+ * its interface or on any interface and NULL for cleared entries or a
+ * different interface
+ */
+static void test_nib_get__success_full(void)
+{
+    _nib_onl_entry_t *nodes[CONFIG_GNRC_IPV6_NIB_NUMOF];
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+
+    for (int i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        addr.u64[1].u64 = TEST_UINT64 + i;
+        TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addr,
+                                                        IFACE + (i & 1))));
+        nodes[i]->mode = _NC;
+    }
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+            addr.u64[1].u64 = TEST_UINT64 + i;
+            TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, IFACE + (i & 1)));
+            TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, 0));
+            TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE + !(i & 1)));
+        }
+        for (int i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i += 2) {
+            addr.u64[1].u64 = TEST_UINT64 + i;
+            nodes[i]->mode = _EMPTY;
+            TEST_ASSERT(_nib_onl_clear(nodes[i]));
+            TEST_ASSERT_NULL(_nib_onl_get(&addr, 0));
+        }
+        for (int i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i += 2) {
+            addr.u64[1].u64 = TEST_UINT64 + i;
+            TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addr, IFACE)));
+            nodes[i]->mode = _NC;
+        }
+    }
+}
+
 /*
  * Creates CONFIG_GNRC_IPV6_NIB_NUMOF neighbor cache entries with different IP
  * addresses and a non-garbage-collectible AR state and then tries to add
@@ -2021,6 +2061,7 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_get__empty),
         new_TestFixture(test_nib_get__not_in_nib),
         new_TestFixture(test_nib_get__success),
+        new_TestFixture(test_nib_get__success_full),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_addr),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_iface),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_addr_iface),
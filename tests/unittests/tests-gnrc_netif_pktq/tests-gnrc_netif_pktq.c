@@ -13,10 +13,15 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <string.h>
+
 #include "embUnit.h"
 
 #include "net/gnrc/netif/conf.h"
+#include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/netif/pktq.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/sixlowpan/sfr.h"
 
 #include "tests-gnrc_netif_pktq.h"
 
@@ -34,7 +39,7 @@ static void test_pktq_get__empty(void)
 
 static void test_pktq_put__full(void)
 {
-    gnrc_pktsnip_t pkt;
+    gnrc_pktsnip_t pkt = { 0 };
 
     for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE; i++) {
         TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt));
@@ -44,7 +49,7 @@ static void test_pktq_put__full(void)
 
 static void test_pktq_put_get1(void)
 {
-    gnrc_pktsnip_t pkt_in, *pkt_out;
+    gnrc_pktsnip_t pkt_in = { 0 }, *pkt_out;
 
     TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt_in));
     TEST_ASSERT_NOT_NULL((pkt_out = gnrc_netif_pktq_get(&_netif)));
@@ -53,7 +58,7 @@ static void test_pktq_put_get1(void)
 
 static void test_pktq_put_get3(void)
 {
-    gnrc_pktsnip_t pkt_in[3];
+    gnrc_pktsnip_t pkt_in[3] = { 0 };
 
     for (unsigned i = 0; i < 3; i++) {
         TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt_in[i]));
@@ -68,7 +73,7 @@ static void test_pktq_put_get3(void)
 
 static void test_pktq_push_back__full(void)
 {
-    gnrc_pktsnip_t pkt;
+    gnrc_pktsnip_t pkt = { 0 };
 
     for (unsigned i = 0; i < CONFIG_GNRC_NETIF_PKTQ_POOL_SIZE; i++) {
         TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt));
@@ -78,7 +83,7 @@ static void test_pktq_push_back__full(void)
 
 static void test_pktq_push_back_get1(void)
 {
-    gnrc_pktsnip_t pkt_in, *pkt_out;
+    gnrc_pktsnip_t pkt_in = { 0 }, *pkt_out;
 
     TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_push_back(&_netif, &pkt_in));
     TEST_ASSERT_NOT_NULL((pkt_out = gnrc_netif_pktq_get(&_netif)));
@@ -87,7 +92,7 @@ static void test_pktq_push_back_get1(void)
 
 static void test_pktq_push_back_get3(void)
 {
-    gnrc_pktsnip_t pkt_in[3];
+    gnrc_pktsnip_t pkt_in[3] = { 0 };
 
     for (unsigned i = 0; i < 3; i++) {
         TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_push_back(&_netif, &pkt_in[i]));
@@ -102,7 +107,7 @@ static void test_pktq_push_back_get3(void)
 
 static void test_pktq_empty(void)
 {
-    gnrc_pktsnip_t pkt_in;
+    gnrc_pktsnip_t pkt_in = { 0 };
 
     TEST_ASSERT(gnrc_netif_pktq_empty(&_netif));
     TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &pkt_in));
@@ -115,6 +120,83 @@ static void test_pktq_empty(void)
     TEST_ASSERT(gnrc_netif_pktq_empty(&_netif));
 }
 
+static void test_pktq_put__ecn(void)
+{
+    static const uint8_t dst[][2] = { { 0x01, 0x02 }, { 0x03, 0x04 } };
+    /* one packet more than the threshold to the first destination, one to
+     * the second */
+    enum { PKTS = CONFIG_GNRC_NETIF_PKTQ_ECN_THRESHOLD + 2 };
+    uint8_t hdr[PKTS][sizeof(gnrc_netif_hdr_t) + sizeof(dst[0])];
+    sixlowpan_sfr_rfrag_t frag[PKTS];
+    gnrc_pktsnip_t netif_snip[PKTS], frag_snip[PKTS];
+
+    for (unsigned i = 0; i < PKTS; i++) {
+        const uint8_t *addr = dst[(i == (PKTS - 1)) ? 1 : 0];
+
+        gnrc_netif_hdr_init((gnrc_netif_hdr_t *)hdr[i], 0, sizeof(dst[0]));
+        gnrc_netif_hdr_set_dst_addr((gnrc_netif_hdr_t *)hdr[i], addr,
+                                    sizeof(dst[0]));
+        memset(&frag[i], 0, sizeof(frag[i]));
+        sixlowpan_sfr_rfrag_set_disp(&frag[i].base);
+        frag_snip[i] = (gnrc_pktsnip_t){ .data = &frag[i],
+                                         .size = sizeof(frag[i]),
+                                         .users = 1 };
+        netif_snip[i] = (gnrc_pktsnip_t){ .next = &frag_snip[i],
+                                          .data = hdr[i],
+                                          .size = sizeof(hdr[i]),
+                                          .type = GNRC_NETTYPE_NETIF,
+                                          .users = 1 };
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, &netif_snip[i]));
+    }
+    for (unsigned i = 0; i < PKTS; i++) {
+        bool marked = (i == CONFIG_GNRC_NETIF_PKTQ_ECN_THRESHOLD);
+
+        TEST_ASSERT(marked == sixlowpan_sfr_ecn(&frag[i].base));
+    }
+}
+
+static void test_pktq_put__ecn_shared(void)
+{
+    static const uint8_t dst[] = { 0x01, 0x02 };
+    enum { PKTS = CONFIG_GNRC_NETIF_PKTQ_ECN_THRESHOLD + 1 };
+    gnrc_pktsnip_t *pkt[PKTS], *out;
+
+    /* auto_init is disabled in the unittests */
+    gnrc_pktbuf_init();
+    for (unsigned i = 0; i < PKTS; i++) {
+        gnrc_pktsnip_t *frag = gnrc_pktbuf_add(NULL, NULL,
+                                               sizeof(sixlowpan_sfr_rfrag_t),
+                                               GNRC_NETTYPE_UNDEF);
+
+        TEST_ASSERT_NOT_NULL(frag);
+        memset(frag->data, 0, frag->size);
+        sixlowpan_sfr_rfrag_set_disp(frag->data);
+        pkt[i] = gnrc_pktbuf_add(frag, NULL,
+                                 sizeof(gnrc_netif_hdr_t) + sizeof(dst),
+                                 GNRC_NETTYPE_NETIF);
+        TEST_ASSERT_NOT_NULL(pkt[i]);
+        gnrc_netif_hdr_init(pkt[i]->data, 0, sizeof(dst));
+        gnrc_netif_hdr_set_dst_addr(pkt[i]->data, dst, sizeof(dst));
+    }
+    /* the sender keeps the last fragment e.g. for retransmission */
+    gnrc_pktbuf_hold(pkt[PKTS - 1], 1);
+    for (unsigned i = 0; i < PKTS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netif_pktq_put(&_netif, pkt[i]));
+    }
+    for (unsigned i = 0; i < (PKTS - 1); i++) {
+        TEST_ASSERT((out = gnrc_netif_pktq_get(&_netif)) == pkt[i]);
+        gnrc_pktbuf_release(out);
+    }
+    /* only the queued copy is marked */
+    TEST_ASSERT_NOT_NULL((out = gnrc_netif_pktq_get(&_netif)));
+    TEST_ASSERT(out != pkt[PKTS - 1]);
+    TEST_ASSERT(sixlowpan_sfr_ecn(out->next->data));
+    TEST_ASSERT(!sixlowpan_sfr_ecn(pkt[PKTS - 1]->next->data));
+    gnrc_pktbuf_release(out);
+    gnrc_pktbuf_release(pkt[PKTS - 1]);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static Test *test_gnrc_netif_pktq(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -126,6 +208,8 @@ static Test *test_gnrc_netif_pktq(void)
         new_TestFixture(test_pktq_push_back_get1),
         new_TestFixture(test_pktq_push_back_get3),
         new_TestFixture(test_pktq_empty),
+        new_TestFixture(test_pktq_put__ecn),
+        new_TestFixture(test_pktq_put__ecn_shared),
     };
 
     EMB_UNIT_TESTCALLER(pktq_tests, set_up, NULL, fixtures);
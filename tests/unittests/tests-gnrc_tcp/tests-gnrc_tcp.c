@@ -0,0 +1,636 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/tcp.h"
+#include "ringbuffer.h"
+#include "utlist.h"
+
+#include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_fsm.h"
+#include "include/gnrc_tcp_option.h"
+#include "include/gnrc_tcp_rcvbuf.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define TEST_SEQ            (1000U)
+#define TEST_SEG_LEN        (10U)
+#define TEST_OOO_SEGS       (CONFIG_GNRC_TCP_SACK_QUEUE_SIZE + 1)
+#define TEST_DATA_LEN       ((2 * TEST_OOO_SEGS) * TEST_SEG_LEN)
+#define TEST_RTX_SEGS       (CONFIG_GNRC_TCP_RETRANSMIT_QUEUE_SIZE)
+#define TEST_SMSS           (TEST_SEG_LEN / 2)
+
+typedef struct __attribute__((packed)) {
+    tcp_hdr_t hdr;
+    uint8_t opts[TCP_OPTION_SPACE_MAX];
+} _seg_hdr_t;
+
+static gnrc_tcp_tcb_t _tcb;
+static gnrc_tcp_tcb_t _peer;
+static char _data[TEST_DATA_LEN];
+static char _rcvd[TEST_DATA_LEN];
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    _gnrc_tcp_rcvbuf_init();
+    gnrc_tcp_tcb_init(&_tcb);
+    gnrc_tcp_tcb_init(&_peer);
+    for (unsigned i = 0; i < TEST_DATA_LEN; i++) {
+        _data[i] = 'a' + (i / TEST_SEG_LEN) % 26;
+    }
+}
+
+static tcp_hdr_t *_hdr(_seg_hdr_t *seg, uint16_t ctl, const uint8_t *opts,
+                       size_t opts_len)
+{
+    memset(seg, 0, sizeof(*seg));
+    memcpy(seg->opts, opts, opts_len);
+    seg->hdr.off_ctl = byteorder_htons(_gnrc_tcp_option_build_offset_control(
+        TCP_HDR_OFFSET_MIN + opts_len / sizeof(network_uint32_t), ctl));
+    return &seg->hdr;
+}
+
+static gnrc_pktsnip_t *_data_seg(uint32_t seq, const char *data, size_t len)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, data, len, GNRC_NETTYPE_UNDEF);
+    tcp_hdr_t hdr = { 0 };
+
+    hdr.seq_num = byteorder_htonl(seq);
+    hdr.ack_num = byteorder_htonl(_tcb.snd_una);
+    hdr.window = byteorder_htons(_tcb.snd_wnd);
+    hdr.off_ctl = byteorder_htons(_gnrc_tcp_option_build_offset_control(
+        TCP_HDR_OFFSET_MIN, MSK_ACK));
+    pkt = gnrc_pktbuf_add(pkt, &hdr, sizeof(hdr), GNRC_NETTYPE_TCP);
+    return gnrc_ipv6_hdr_build(pkt, NULL, NULL);
+}
+
+static gnrc_pktsnip_t *_ack_seg(uint32_t seq, uint32_t ack, const uint8_t *opts,
+                               size_t opts_len)
+{
+    _seg_hdr_t seg;
+    tcp_hdr_t *hdr = _hdr(&seg, MSK_ACK, opts, opts_len);
+    gnrc_pktsnip_t *pkt;
+
+    hdr->seq_num = byteorder_htonl(seq);
+    hdr->ack_num = byteorder_htonl(ack);
+    hdr->window = byteorder_htons(_tcb.snd_wnd);
+    pkt = gnrc_pktbuf_add(NULL, hdr, sizeof(*hdr) + opts_len, GNRC_NETTYPE_TCP);
+    return gnrc_ipv6_hdr_build(pkt, NULL, NULL);
+}
+
+static void _set_edge(uint8_t *opts, unsigned idx, uint32_t edge)
+{
+    network_uint32_t tmp = byteorder_htonl(edge);
+
+    memcpy(&opts[4 + idx * sizeof(tmp)], &tmp, sizeof(tmp));
+}
+
+static uint32_t _get_edge(const uint8_t *opts, unsigned idx)
+{
+    network_uint32_t tmp;
+
+    memcpy(&tmp, &opts[4 + idx * sizeof(tmp)], sizeof(tmp));
+    return byteorder_ntohl(tmp);
+}
+
+static void _establish(void)
+{
+    _gnrc_tcp_common_tcb_list_t *list = _gnrc_tcp_common_get_tcb_list();
+
+    /* Register the connection like opening it would */
+    if (list->head != &_tcb) {
+        LL_PREPEND(list->head, &_tcb);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_rcvbuf_get_buffer(&_tcb));
+    _tcb.state = FSM_STATE_ESTABLISHED;
+    _tcb.status |= STATUS_SACK;
+    _tcb.rcv_nxt = TEST_SEQ;
+    _tcb.rcv_wnd = ringbuffer_get_free(&_tcb.rcv_buf);
+    _tcb.snd_wnd = CONFIG_GNRC_TCP_DEFAULT_WINDOW;
+}
+
+static void _recv(unsigned seg)
+{
+    gnrc_pktsnip_t *pkt = _data_seg(TEST_SEQ + seg * TEST_SEG_LEN,
+                                    &_data[seg * TEST_SEG_LEN], TEST_SEG_LEN);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_RCVD_PKT, pkt, NULL, 0);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _send_queue(void)
+{
+    _establish();
+
+    /* Fill the retransmit queue like sending TEST_RTX_SEGS segments would */
+    _tcb.mss = TEST_SMSS;
+    _tcb.snd_una = TEST_SEQ;
+    _tcb.snd_nxt = TEST_SEQ + TEST_RTX_SEGS * TEST_SEG_LEN;
+    _tcb.cwnd = TEST_RTX_SEGS * TEST_SEG_LEN;
+    _tcb.ssthresh = UINT32_MAX;
+    _tcb.recover = TEST_SEQ - 1;
+    for (unsigned i = 0; i < TEST_RTX_SEGS; i++) {
+        _tcb.pkt_retransmit[i] = _data_seg(TEST_SEQ + i * TEST_SEG_LEN,
+                                           &_data[i * TEST_SEG_LEN], TEST_SEG_LEN);
+        TEST_ASSERT_NOT_NULL(_tcb.pkt_retransmit[i]);
+    }
+    _tcb.pkt_retransmit_numof = TEST_RTX_SEGS;
+}
+
+static void _ack(uint32_t ack)
+{
+    gnrc_pktsnip_t *pkt = _ack_seg(_tcb.rcv_nxt, ack, NULL, 0);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_RCVD_PKT, pkt, NULL, 0);
+    gnrc_pktbuf_release(pkt);
+}
+
+static uint32_t _rtx_seq(unsigned idx)
+{
+    gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(_tcb.pkt_retransmit[idx],
+                                                   GNRC_NETTYPE_TCP);
+
+    return byteorder_ntohl(((tcp_hdr_t *)snp->data)->seq_num);
+}
+
+static void _fast_retransmit(void)
+{
+    _send_queue();
+
+    /* The first segment got lost, the others trigger duplicate ACKs */
+    _ack(TEST_SEQ);
+    _ack(TEST_SEQ);
+    TEST_ASSERT_EQUAL_INT(2, _tcb.dup_acks);
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    _ack(TEST_SEQ);
+    TEST_ASSERT(_tcb.status & STATUS_FAST_RECOVERY);
+}
+
+static void test_gnrc_tcp_option_parse__malformed(void)
+{
+    static const uint8_t malformed[][4] = {
+        { TCP_OPTION_KIND_MSS, 3, 0x05, 0xb4 },
+        { TCP_OPTION_KIND_MSS, 8, 0x05, 0xb4 },
+        { TCP_OPTION_KIND_WS, 2, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP },
+        { TCP_OPTION_KIND_WS, 5, 0x07, TCP_OPTION_KIND_NOP },
+        { TCP_OPTION_KIND_SACK_PERM, 3, 0x00, TCP_OPTION_KIND_NOP },
+        { TCP_OPTION_KIND_SACK, 0, 0x00, 0x00 },
+        { TCP_OPTION_KIND_SACK, 3, 0x00, 0x00 },
+        { TCP_OPTION_KIND_SACK, 10, 0x00, 0x00 },
+        { 0x42, 0, 0x00, 0x00 },
+        { 0x42, 1, 0x00, 0x00 },
+        { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP, 0x42 },
+        { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+          TCP_OPTION_KIND_MSS },
+    };
+    _seg_hdr_t seg;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(malformed); i++) {
+        tcp_hdr_t *hdr = _hdr(&seg, MSK_SYN, malformed[i], sizeof(malformed[i]));
+
+        TEST_ASSERT_EQUAL_INT(-1, _gnrc_tcp_option_parse(&_tcb, hdr));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _tcb.mss);
+}
+
+static void test_gnrc_tcp_option_parse__well_formed(void)
+{
+    static const uint8_t mss[] = { TCP_OPTION_KIND_MSS, 4, 0x02, 0x00 };
+    static const uint8_t eol[] = {
+        TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_EOL, 0x42, 0x00
+    };
+    _seg_hdr_t seg;
+
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_parse(&_tcb, _hdr(&seg, MSK_SYN, mss, 0)));
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_parse(&_tcb, _hdr(&seg, MSK_SYN, mss,
+                                                                sizeof(mss))));
+    TEST_ASSERT_EQUAL_INT(512, _tcb.mss);
+    /* Nothing behind the end of the option list is parsed */
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_parse(&_tcb, _hdr(&seg, MSK_SYN, eol,
+                                                                sizeof(eol))));
+}
+
+static void test_gnrc_tcp_option__negotiation(void)
+{
+    uint8_t opts[TCP_OPTION_SPACE_MAX];
+    _seg_hdr_t seg;
+    size_t len;
+
+    /* The active opener offers window scaling and SACK with its SYN ... */
+    len = _gnrc_tcp_option_build(&_peer, MSK_SYN, opts);
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_parse(&_tcb, _hdr(&seg, MSK_SYN, opts, len)));
+    TEST_ASSERT(_tcb.status & STATUS_WINDOW_SCALE);
+    TEST_ASSERT(_tcb.status & STATUS_SACK);
+    TEST_ASSERT_EQUAL_INT(_gnrc_tcp_option_rcv_wnd_shift(), _tcb.snd_wnd_shift);
+
+    /* ... the passive opener accepts both with its SYN-ACK */
+    len = _gnrc_tcp_option_build(&_tcb, MSK_SYN_ACK, opts);
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_parse(&_peer, _hdr(&seg, MSK_SYN_ACK,
+                                                                 opts, len)));
+    TEST_ASSERT(_peer.status & STATUS_WINDOW_SCALE);
+    TEST_ASSERT(_peer.status & STATUS_SACK);
+    TEST_ASSERT_EQUAL_INT(_gnrc_tcp_option_rcv_wnd_shift(), _peer.snd_wnd_shift);
+}
+
+static void test_gnrc_tcp_option__negotiation_not_offered(void)
+{
+    static const uint8_t mss[] = { TCP_OPTION_KIND_MSS, 4, 0x02, 0x00 };
+    uint8_t opts[TCP_OPTION_SPACE_MAX];
+    _seg_hdr_t seg;
+
+    _tcb.status |= STATUS_WINDOW_SCALE | STATUS_SACK;
+    _tcb.snd_wnd_shift = 7;
+
+    /* A SYN without the options turns them off ... */
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_parse(&_tcb, _hdr(&seg, MSK_SYN, mss,
+                                                                sizeof(mss))));
+    TEST_ASSERT(!(_tcb.status & (STATUS_WINDOW_SCALE | STATUS_SACK)));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.snd_wnd_shift);
+
+    /* ... and the SYN-ACK carries nothing but the MSS */
+    TEST_ASSERT_EQUAL_INT(sizeof(network_uint32_t),
+                          _gnrc_tcp_option_build(&_tcb, MSK_SYN_ACK, opts));
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_KIND_MSS, opts[0]);
+}
+
+static void test_gnrc_tcp_option_parse__window_scale(void)
+{
+    uint8_t ws[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_WS, TCP_OPTION_LENGTH_WS,
+                     TCP_OPTION_WS_SHIFT_MAX + 1 };
+    _seg_hdr_t seg;
+
+    /* Shift counts beyond the maximum are reduced to the maximum */
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_parse(&_tcb, _hdr(&seg, MSK_SYN, ws,
+                                                                sizeof(ws))));
+    TEST_ASSERT(_tcb.status & STATUS_WINDOW_SCALE);
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_WS_SHIFT_MAX, _tcb.snd_wnd_shift);
+
+    /* The option is ignored outside of SYN segments */
+    ws[3] = 3;
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_parse(&_tcb, _hdr(&seg, MSK_ACK, ws,
+                                                                sizeof(ws))));
+    TEST_ASSERT(_tcb.status & STATUS_WINDOW_SCALE);
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_WS_SHIFT_MAX, _tcb.snd_wnd_shift);
+}
+
+static void test_gnrc_tcp_option_parse__sack(void)
+{
+    uint8_t opts[4 + TCP_OPTION_LENGTH_SACK_BLOCK] = {
+        TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_SACK,
+        TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK,
+    };
+    _seg_hdr_t seg;
+
+    for (unsigned i = 0; i < 3; i++) {
+        _tcb.pkt_retransmit[i] = _data_seg(TEST_SEQ + i * TEST_SEG_LEN,
+                                           &_data[i * TEST_SEG_LEN], TEST_SEG_LEN);
+        TEST_ASSERT_NOT_NULL(_tcb.pkt_retransmit[i]);
+    }
+    _tcb.pkt_retransmit_numof = 3;
+    _set_edge(opts, 0, TEST_SEQ + TEST_SEG_LEN);
+    _set_edge(opts, 1, TEST_SEQ + 3 * TEST_SEG_LEN);
+
+    /* Blocks are ignored, if SACK was not negotiated */
+    _gnrc_tcp_option_parse_sack(&_tcb, _hdr(&seg, MSK_ACK, opts, sizeof(opts)));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_sacked);
+
+    /* Blocks are applied only after the segment was accepted */
+    _tcb.status |= STATUS_SACK;
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_parse(&_tcb, _hdr(&seg, MSK_ACK, opts,
+                                                                sizeof(opts))));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_sacked);
+
+    /* The block covers the second and third packet */
+    _gnrc_tcp_option_parse_sack(&_tcb, _hdr(&seg, MSK_ACK, opts, sizeof(opts)));
+    TEST_ASSERT_EQUAL_INT(0x6, _tcb.pkt_retransmit_sacked);
+
+    /* A truncated block is rejected as a whole */
+    _tcb.pkt_retransmit_sacked = 0;
+    opts[3] -= 1;
+    TEST_ASSERT_EQUAL_INT(-1, _gnrc_tcp_option_parse(&_tcb, _hdr(&seg, MSK_ACK, opts,
+                                                                 sizeof(opts))));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_sacked);
+
+    for (unsigned i = 0; i < _tcb.pkt_retransmit_numof; i++) {
+        gnrc_pktbuf_release(_tcb.pkt_retransmit[i]);
+    }
+    _tcb.pkt_retransmit_numof = 0;
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_gnrc_tcp_option_build__sack_blocks(void)
+{
+    static const unsigned segs[] = { 1, 2, 4 };
+    uint8_t opts[TCP_OPTION_SPACE_MAX];
+
+    /* Blocks are only reported for out-of-order segments ... */
+    _tcb.status |= STATUS_SACK;
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_build(&_tcb, MSK_ACK, opts));
+
+    for (unsigned i = 0; i < ARRAY_SIZE(segs); i++) {
+        _tcb.pkt_ooo[i] = _data_seg(TEST_SEQ + segs[i] * TEST_SEG_LEN,
+                                    &_data[segs[i] * TEST_SEG_LEN], TEST_SEG_LEN);
+        TEST_ASSERT_NOT_NULL(_tcb.pkt_ooo[i]);
+    }
+    _tcb.pkt_ooo_numof = ARRAY_SIZE(segs);
+
+    /* ... adjacent segments form one block, the latest block comes first */
+    _tcb.ooo_last_seq = TEST_SEQ + 4 * TEST_SEG_LEN;
+    TEST_ASSERT_EQUAL_INT(4 + 2 * TCP_OPTION_LENGTH_SACK_BLOCK,
+                          _gnrc_tcp_option_build(&_tcb, MSK_ACK, opts));
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_KIND_NOP, opts[0]);
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_KIND_NOP, opts[1]);
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_KIND_SACK, opts[2]);
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_LENGTH_MIN + 2 * TCP_OPTION_LENGTH_SACK_BLOCK,
+                          opts[3]);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 4 * TEST_SEG_LEN, _get_edge(opts, 0));
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 5 * TEST_SEG_LEN, _get_edge(opts, 1));
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 1 * TEST_SEG_LEN, _get_edge(opts, 2));
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 3 * TEST_SEG_LEN, _get_edge(opts, 3));
+
+    _tcb.ooo_last_seq = TEST_SEQ + 2 * TEST_SEG_LEN;
+    TEST_ASSERT_EQUAL_INT(4 + 2 * TCP_OPTION_LENGTH_SACK_BLOCK,
+                          _gnrc_tcp_option_build(&_tcb, MSK_ACK, opts));
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 1 * TEST_SEG_LEN, _get_edge(opts, 0));
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 3 * TEST_SEG_LEN, _get_edge(opts, 1));
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 4 * TEST_SEG_LEN, _get_edge(opts, 2));
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 5 * TEST_SEG_LEN, _get_edge(opts, 3));
+
+    /* Resets carry no blocks, neither do connections without SACK */
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_build(&_tcb, MSK_RST_ACK, opts));
+    _tcb.status &= ~STATUS_SACK;
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_tcp_option_build(&_tcb, MSK_ACK, opts));
+}
+
+static void test_gnrc_tcp_fsm__ooo_reassembly(void)
+{
+    _establish();
+
+    /* Segments behind a gap are kept once, sorted by sequence number */
+    _recv(3);
+    _recv(1);
+    _recv(3);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ, _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(2, _tcb.pkt_ooo_numof);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + TEST_SEG_LEN, _tcb.ooo_last_seq);
+
+    /* Filling a gap appends the segments that became contiguous */
+    _recv(0);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 2 * TEST_SEG_LEN, _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(1, _tcb.pkt_ooo_numof);
+    _recv(2);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 4 * TEST_SEG_LEN, _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_ooo_numof);
+    TEST_ASSERT_EQUAL_INT(ringbuffer_get_free(&_tcb.rcv_buf), _tcb.rcv_wnd);
+
+    TEST_ASSERT_EQUAL_INT(4 * TEST_SEG_LEN,
+                          ringbuffer_get(&_tcb.rcv_buf, _rcvd, sizeof(_rcvd)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, _rcvd, 4 * TEST_SEG_LEN));
+
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_gnrc_tcp_fsm__ooo_overflow(void)
+{
+    _establish();
+
+    /* Every odd segment arrives, the last one finds the queue full */
+    for (unsigned i = 0; i < TEST_OOO_SEGS; i++) {
+        _recv(2 * i + 1);
+    }
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_TCP_SACK_QUEUE_SIZE, _tcb.pkt_ooo_numof);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + (2 * TEST_OOO_SEGS - 3) * TEST_SEG_LEN,
+                          _tcb.ooo_last_seq);
+
+    /* Filling the gaps delivers everything but the dropped segment */
+    for (unsigned i = 0; i < TEST_OOO_SEGS; i++) {
+        _recv(2 * i);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_ooo_numof);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + (2 * TEST_OOO_SEGS - 1) * TEST_SEG_LEN, _tcb.rcv_nxt);
+
+    /* The peer has to retransmit it */
+    _recv(2 * TEST_OOO_SEGS - 1);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + TEST_DATA_LEN, _tcb.rcv_nxt);
+
+    TEST_ASSERT_EQUAL_INT(TEST_DATA_LEN,
+                          ringbuffer_get(&_tcb.rcv_buf, _rcvd, sizeof(_rcvd)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, _rcvd, TEST_DATA_LEN));
+
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_gnrc_tcp_fsm__sack_unacceptable(void)
+{
+    uint8_t opts[4 + TCP_OPTION_LENGTH_SACK_BLOCK] = {
+        TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_SACK,
+        TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK,
+    };
+    gnrc_pktsnip_t *pkt;
+
+    _establish();
+    _tcb.snd_una = TEST_SEQ;
+    _tcb.snd_nxt = TEST_SEQ + 3 * TEST_SEG_LEN;
+    for (unsigned i = 0; i < 3; i++) {
+        _tcb.pkt_retransmit[i] = _data_seg(TEST_SEQ + i * TEST_SEG_LEN,
+                                           &_data[i * TEST_SEG_LEN], TEST_SEG_LEN);
+        TEST_ASSERT_NOT_NULL(_tcb.pkt_retransmit[i]);
+    }
+    _tcb.pkt_retransmit_numof = 3;
+    _set_edge(opts, 0, TEST_SEQ + TEST_SEG_LEN);
+    _set_edge(opts, 1, TEST_SEQ + 3 * TEST_SEG_LEN);
+
+    /* A segment outside of the receive window must not mark anything */
+    pkt = _ack_seg(_tcb.rcv_nxt + _tcb.rcv_wnd, _tcb.snd_una, opts, sizeof(opts));
+    TEST_ASSERT_NOT_NULL(pkt);
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_RCVD_PKT, pkt, NULL, 0);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_sacked);
+
+    /* Neither must a segment acknowledging data that was never sent */
+    pkt = _ack_seg(_tcb.rcv_nxt, TEST_SEQ + 4 * TEST_SEG_LEN, opts, sizeof(opts));
+    TEST_ASSERT_NOT_NULL(pkt);
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_RCVD_PKT, pkt, NULL, 0);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_sacked);
+
+    /* The same blocks in an acceptable segment are applied */
+    pkt = _ack_seg(_tcb.rcv_nxt, _tcb.snd_una, opts, sizeof(opts));
+    TEST_ASSERT_NOT_NULL(pkt);
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_RCVD_PKT, pkt, NULL, 0);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(0x6, _tcb.pkt_retransmit_sacked);
+
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_gnrc_tcp_fsm__retransmit_cumulative_ack(void)
+{
+    _send_queue();
+    _tcb.pkt_retransmit_sacked = 1 << (TEST_RTX_SEGS - 1);
+
+    /* Every packet covered by the ACK is released */
+    _ack(TEST_SEQ + 2 * TEST_SEG_LEN);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 2 * TEST_SEG_LEN, _tcb.snd_una);
+    TEST_ASSERT_EQUAL_INT(TEST_RTX_SEGS - 2, _tcb.pkt_retransmit_numof);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 2 * TEST_SEG_LEN, _rtx_seq(0));
+    TEST_ASSERT_EQUAL_INT(1 << (TEST_RTX_SEGS - 3), _tcb.pkt_retransmit_sacked);
+
+    /* A packet acknowledged in parts stays in the queue */
+    _ack(TEST_SEQ + 2 * TEST_SEG_LEN + TEST_SEG_LEN / 2);
+    TEST_ASSERT_EQUAL_INT(TEST_RTX_SEGS - 2, _tcb.pkt_retransmit_numof);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 2 * TEST_SEG_LEN, _rtx_seq(0));
+
+    _ack(_tcb.snd_nxt);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_numof);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.retries);
+    TEST_ASSERT_EQUAL_INT(_tcb.snd_nxt, _tcb.snd_una);
+
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_gnrc_tcp_fsm__fast_retransmit(void)
+{
+    uint32_t flight = TEST_RTX_SEGS * TEST_SEG_LEN;
+
+    /* The third duplicate ACK retransmits the first segment */
+    _fast_retransmit();
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + TEST_SEG_LEN, _tcb.high_rxt);
+    TEST_ASSERT_EQUAL_INT(_tcb.snd_nxt, _tcb.recover);
+    TEST_ASSERT_EQUAL_INT(flight / 2, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(flight / 2 + 3 * TEST_SMSS, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(TEST_RTX_SEGS, _tcb.pkt_retransmit_numof);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.retries);
+
+    /* Further duplicate ACKs inflate the window, but retransmit nothing */
+    _ack(TEST_SEQ);
+    TEST_ASSERT_EQUAL_INT(flight / 2 + 4 * TEST_SMSS, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + TEST_SEG_LEN, _tcb.high_rxt);
+
+    /* A full acknowledgment deflates the window and ends fast recovery */
+    _ack(_tcb.snd_nxt);
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    TEST_ASSERT_EQUAL_INT(2 * TEST_SMSS, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_numof);
+
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_gnrc_tcp_fsm__partial_ack(void)
+{
+    uint32_t cwnd;
+
+    _fast_retransmit();
+    cwnd = _tcb.cwnd;
+
+    /* A partial acknowledgment retransmits the next segment at once */
+    _ack(TEST_SEQ + TEST_SEG_LEN);
+    TEST_ASSERT(_tcb.status & STATUS_FAST_RECOVERY);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 2 * TEST_SEG_LEN, _tcb.high_rxt);
+    TEST_ASSERT_EQUAL_INT(cwnd - TEST_SEG_LEN + TEST_SMSS, _tcb.cwnd);
+    TEST_ASSERT_EQUAL_INT(TEST_RTX_SEGS - 1, _tcb.pkt_retransmit_numof);
+
+    /* Each one until the recovery point is acknowledged */
+    _ack(TEST_SEQ + 2 * TEST_SEG_LEN);
+    TEST_ASSERT(_tcb.status & STATUS_FAST_RECOVERY);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 3 * TEST_SEG_LEN, _tcb.high_rxt);
+    _ack(_tcb.recover);
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_numof);
+
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_gnrc_tcp_fsm__rto_after_fast_retransmit(void)
+{
+    uint32_t flight;
+
+    _fast_retransmit();
+    _ack(TEST_SEQ + TEST_SEG_LEN);
+    flight = _tcb.snd_nxt - _tcb.snd_una;
+
+    /* The fast retransmits were no timeouts, so the first timeout reduces
+     * the slow start threshold to half of what is in flight now */
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_TIMEOUT_RETRANSMIT, NULL, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(1, _tcb.retries);
+    TEST_ASSERT_EQUAL_INT(flight / 2, _tcb.ssthresh);
+    TEST_ASSERT_EQUAL_INT(TEST_SMSS, _tcb.cwnd);
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    TEST_ASSERT(_tcb.status & STATUS_RTO_RECOVERY);
+    TEST_ASSERT_EQUAL_INT(_tcb.snd_nxt, _tcb.recover);
+
+    /* Duplicate ACKs for data sent before the timeout start no fast retransmit */
+    for (unsigned i = 0; i < 3; i++) {
+        _ack(_tcb.snd_una);
+    }
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+
+    /* An ACK after the timeout retransmits the next segment in flight */
+    _ack(TEST_SEQ + 2 * TEST_SEG_LEN);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.retries);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ + 3 * TEST_SEG_LEN, _tcb.high_rxt);
+    TEST_ASSERT(_tcb.status & STATUS_RTO_RECOVERY);
+    _ack(_tcb.snd_nxt);
+    TEST_ASSERT(!(_tcb.status & STATUS_RTO_RECOVERY));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_numof);
+
+    _gnrc_tcp_fsm(&_tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+Test *tests_gnrc_tcp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_tcp_option_parse__malformed),
+        new_TestFixture(test_gnrc_tcp_option_parse__well_formed),
+        new_TestFixture(test_gnrc_tcp_option__negotiation),
+        new_TestFixture(test_gnrc_tcp_option__negotiation_not_offered),
+        new_TestFixture(test_gnrc_tcp_option_parse__window_scale),
+        new_TestFixture(test_gnrc_tcp_option_parse__sack),
+        new_TestFixture(test_gnrc_tcp_option_build__sack_blocks),
+        new_TestFixture(test_gnrc_tcp_fsm__ooo_reassembly),
+        new_TestFixture(test_gnrc_tcp_fsm__ooo_overflow),
+        new_TestFixture(test_gnrc_tcp_fsm__sack_unacceptable),
+        new_TestFixture(test_gnrc_tcp_fsm__retransmit_cumulative_ack),
+        new_TestFixture(test_gnrc_tcp_fsm__fast_retransmit),
+        new_TestFixture(test_gnrc_tcp_fsm__partial_ack),
+        new_TestFixture(test_gnrc_tcp_fsm__rto_after_fast_retransmit),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_tcp_tests;
+}
+
+void tests_gnrc_tcp(void)
+{
+    TESTS_RUN(tests_gnrc_tcp_tests());
+}
+/** @} */
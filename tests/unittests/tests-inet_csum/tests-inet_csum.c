@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,80 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* byte-wise reference implementation */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *buf, size_t len)
+{
+    uint32_t csum = sum;
+
+    for (size_t i = 0; i < len; i++) {
+        csum += (i & 1) ? buf[i] : (buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void _fill_pattern(uint8_t *buf, size_t len)
+{
+    uint8_t val = 0x5a;
+
+    for (size_t i = 0; i < len; i++) {
+        val = (val * 37) + 11;
+        buf[i] = (i & 0x10) ? 0xff - val : val;
+    }
+}
+
+static void test_inet_csum__alignments(void)
+{
+    /* make sure word-wise summing is not thrown off by the start address or
+     * length of the buffer */
+    uint32_t data_aligned[24];
+    uint8_t *data = (uint8_t *)data_aligned;
+
+    _fill_pattern(data, sizeof(data_aligned));
+    for (unsigned offset = 0; offset < 8; offset++) {
+        for (unsigned len = 0; len <= (sizeof(data_aligned) - offset); len++) {
+            TEST_ASSERT_EQUAL_INT(_ref_csum(0x1234, data + offset, len),
+                                  inet_csum(0x1234, data + offset, len));
+        }
+    }
+}
+
+static void test_inet_csum__all_ones(void)
+{
+    uint8_t data[70];
+
+    memset(data, 0xff, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0xffff, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0, data + 1, sizeof(data) - 2));
+    memset(data, 0, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0, inet_csum(0, data + 1, sizeof(data) - 1));
+}
+
+static void test_inet_csum__slices(void)
+{
+    /* summing up a buffer in slices of arbitrary sizes needs to result in
+     * the same checksum as summing it up at once */
+    uint32_t data_aligned[16];
+    uint8_t *data = (uint8_t *)data_aligned;
+    uint16_t expected;
+
+    _fill_pattern(data, sizeof(data_aligned));
+    expected = inet_csum(0, data, sizeof(data_aligned));
+    for (unsigned split = 0; split <= sizeof(data_aligned); split++) {
+        for (unsigned split2 = split; split2 <= sizeof(data_aligned);
+             split2 += 7) {
+            uint16_t sum = inet_csum_slice(0, data, split, 0);
+
+            sum = inet_csum_slice(sum, data + split, split2 - split, split);
+            sum = inet_csum_slice(sum, data + split2,
+                                  sizeof(data_aligned) - split2, split2);
+            TEST_ASSERT_EQUAL_INT(expected, sum);
+        }
+    }
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +251,9 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__alignments),
+        new_TestFixture(test_inet_csum__all_ones),
+        new_TestFixture(test_inet_csum__slices),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "malloc_monitor.h"
+#include "memarray.h"
+#include "net/gnrc/pktbuf.h"
+#include "thread.h"
+#include "tests-malloc_monitor.h"
+
+#define TEST_ELEM_SIZE      (32U)
+#define TEST_ELEM_NUM       (2U)
+#define TEST_SIZE           (100U)
+#define TEST_TAG            (3U)
+/* other modules may use the heap meanwhile, so only use the pktbuf source
+ * for fake allocations */
+#define TEST_SRC            MALLOC_MONITOR_SRC_PKTBUF
+
+static uint8_t _mem_data[TEST_ELEM_SIZE * TEST_ELEM_NUM];
+static memarray_t _mem;
+static uint8_t _buf[CONFIG_MALLOC_MONITOR_SLOTS + 1];
+static malloc_monitor_stats_t _before;
+
+static void set_up(void)
+{
+    /* the module is never reset, so all tests compare against a snapshot */
+    malloc_monitor_reset_peaks();
+    malloc_monitor_get_stats(TEST_SRC, &_before);
+}
+
+static void test_malloc_monitor_memarray(void)
+{
+    malloc_monitor_stats_t before, after;
+    malloc_monitor_usage_t thread_before, thread_after;
+    void *a, *b;
+
+    memarray_init(&_mem, _mem_data, TEST_ELEM_SIZE, TEST_ELEM_NUM);
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_MEMARRAY, &before);
+    malloc_monitor_get_thread_usage(MALLOC_MONITOR_SRC_MEMARRAY,
+                                    thread_getpid(), &thread_before);
+    a = memarray_alloc(&_mem);
+    b = memarray_alloc(&_mem);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NULL(memarray_alloc(&_mem));
+    memarray_free(&_mem, a);
+
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_MEMARRAY, &after);
+    malloc_monitor_get_thread_usage(MALLOC_MONITOR_SRC_MEMARRAY,
+                                    thread_getpid(), &thread_after);
+    TEST_ASSERT_EQUAL_INT(before.allocs + 2, after.allocs);
+    TEST_ASSERT_EQUAL_INT(before.frees + 1, after.frees);
+    TEST_ASSERT_EQUAL_INT(before.failed + 1, after.failed);
+    /* bucket 1 holds allocations of 17 to 32 bytes */
+    TEST_ASSERT_EQUAL_INT(before.hist[1] + 2, after.hist[1]);
+    TEST_ASSERT_EQUAL_INT(before.usage.current + TEST_ELEM_SIZE,
+                          after.usage.current);
+    TEST_ASSERT(after.usage.peak >= before.usage.current + 2 * TEST_ELEM_SIZE);
+    TEST_ASSERT_EQUAL_INT(thread_before.current + TEST_ELEM_SIZE,
+                          thread_after.current);
+    memarray_free(&_mem, b);
+}
+
+static void test_malloc_monitor_tag(void)
+{
+    malloc_monitor_usage_t usage;
+    uint8_t old;
+
+    old = malloc_monitor_tag_set(TEST_TAG);
+    malloc_monitor_record_alloc(TEST_SRC, _buf, TEST_SIZE);
+    TEST_ASSERT_EQUAL_INT(TEST_TAG, malloc_monitor_tag_set(old));
+
+    malloc_monitor_get_tag_usage(TEST_SRC, TEST_TAG, &usage);
+    TEST_ASSERT_EQUAL_INT(TEST_SIZE, usage.current);
+    TEST_ASSERT_EQUAL_INT(TEST_SIZE, usage.peak);
+
+    /* the free is attributed to the allocating tag */
+    malloc_monitor_record_free(TEST_SRC, _buf, 0);
+    malloc_monitor_get_tag_usage(TEST_SRC, TEST_TAG, &usage);
+    TEST_ASSERT_EQUAL_INT(0, usage.current);
+    TEST_ASSERT_EQUAL_INT(TEST_SIZE, usage.peak);
+
+    malloc_monitor_reset_peaks();
+    malloc_monitor_get_tag_usage(TEST_SRC, TEST_TAG, &usage);
+    TEST_ASSERT_EQUAL_INT(0, usage.peak);
+}
+
+static void test_malloc_monitor_partial_free(void)
+{
+    malloc_monitor_stats_t stats;
+
+    malloc_monitor_record_alloc(TEST_SRC, _buf, 64);
+    /* release the tail of the allocation */
+    malloc_monitor_record_free(TEST_SRC, &_buf[48], 16);
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current + 48, stats.usage.current);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current + 64, stats.usage.peak);
+    TEST_ASSERT_EQUAL_INT(_before.frees, stats.frees);
+    /* the released tail is not part of the allocation anymore */
+    malloc_monitor_record_free(TEST_SRC, &_buf[48], 16);
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current + 48, stats.usage.current);
+
+    malloc_monitor_record_free(TEST_SRC, _buf, 48);
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current, stats.usage.current);
+    TEST_ASSERT_EQUAL_INT(_before.frees + 1, stats.frees);
+}
+
+static void test_malloc_monitor_partial_free_head(void)
+{
+    malloc_monitor_stats_t stats;
+
+    malloc_monitor_record_alloc(TEST_SRC, _buf, 64);
+    /* release the head, the middle and the tail in that order */
+    malloc_monitor_record_free(TEST_SRC, _buf, 16);
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current + 48, stats.usage.current);
+    /* a new allocation at the released head is recorded on its own */
+    malloc_monitor_record_alloc(TEST_SRC, _buf, 8);
+    malloc_monitor_record_free(TEST_SRC, _buf, 8);
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current + 48, stats.usage.current);
+    TEST_ASSERT_EQUAL_INT(_before.frees + 1, stats.frees);
+    malloc_monitor_record_free(TEST_SRC, &_buf[24], 32);
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current + 16, stats.usage.current);
+    malloc_monitor_record_free(TEST_SRC, &_buf[56], 8);
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current + 8, stats.usage.current);
+    TEST_ASSERT_EQUAL_INT(_before.frees + 1, stats.frees);
+    malloc_monitor_record_free(TEST_SRC, &_buf[16], 8);
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current, stats.usage.current);
+    TEST_ASSERT_EQUAL_INT(_before.frees + 2, stats.frees);
+}
+
+static void test_malloc_monitor_pktbuf_mark(void)
+{
+    malloc_monitor_stats_t stats;
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    /* auto_init is disabled in the unittests */
+    gnrc_pktbuf_init();
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_PKTBUF, &_before);
+    pkt = gnrc_pktbuf_add(NULL, NULL, 64, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* an aligned header is marked in place, splitting the data */
+    hdr = gnrc_pktbuf_mark(pkt, 16, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    /* release the header before the payload, as e.g. 6LoWPAN does */
+    pkt = gnrc_pktbuf_remove_snip(pkt, hdr);
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_PKTBUF, &stats);
+    TEST_ASSERT(stats.usage.current > _before.usage.current);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_PKTBUF, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current, stats.usage.current);
+    TEST_ASSERT_EQUAL_INT(stats.allocs - _before.allocs,
+                          stats.frees - _before.frees);
+    TEST_ASSERT_EQUAL_INT(_before.untracked, stats.untracked);
+}
+
+static void test_malloc_monitor_hist(void)
+{
+    static const size_t sizes[] = { 1, 16, 17, 1024, 4096 };
+    static const unsigned buckets[] = {
+        0, 0, 1, 6, CONFIG_MALLOC_MONITOR_HIST_BUCKETS - 1
+    };
+    malloc_monitor_stats_t stats;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(sizes); i++) {
+        malloc_monitor_get_stats(TEST_SRC, &_before);
+        malloc_monitor_record_alloc(TEST_SRC, _buf, sizes[i]);
+        malloc_monitor_record_free(TEST_SRC, _buf, 0);
+        malloc_monitor_get_stats(TEST_SRC, &stats);
+        TEST_ASSERT_EQUAL_INT(_before.hist[buckets[i]] + 1,
+                              stats.hist[buckets[i]]);
+    }
+}
+
+static void test_malloc_monitor_untracked(void)
+{
+    malloc_monitor_stats_t stats;
+    unsigned num = 0;
+
+    /* other sources may hold slots already */
+    do {
+        TEST_ASSERT(num < sizeof(_buf));
+        malloc_monitor_record_alloc(TEST_SRC, &_buf[num++], 1);
+        malloc_monitor_get_stats(TEST_SRC, &stats);
+    } while (stats.untracked == _before.untracked);
+    TEST_ASSERT_EQUAL_INT(_before.allocs + num, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current + num - 1,
+                          stats.usage.current);
+    /* freeing an unrecorded allocation is ignored */
+    for (unsigned i = 0; i < num; i++) {
+        malloc_monitor_record_free(TEST_SRC, &_buf[i], 0);
+    }
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.usage.current, stats.usage.current);
+    TEST_ASSERT_EQUAL_INT(_before.frees + num - 1, stats.frees);
+}
+
+static void test_malloc_monitor_zero_size(void)
+{
+    malloc_monitor_stats_t stats;
+
+    /* allocations of 0 bytes must not occupy a slot once released */
+    for (unsigned i = 0; i <= CONFIG_MALLOC_MONITOR_SLOTS; i++) {
+        malloc_monitor_record_alloc(TEST_SRC, _buf, 0);
+        malloc_monitor_record_free(TEST_SRC, _buf, 0);
+    }
+    malloc_monitor_get_stats(TEST_SRC, &stats);
+    TEST_ASSERT_EQUAL_INT(_before.allocs + CONFIG_MALLOC_MONITOR_SLOTS + 1,
+                          stats.allocs);
+    TEST_ASSERT_EQUAL_INT(_before.frees + CONFIG_MALLOC_MONITOR_SLOTS + 1,
+                          stats.frees);
+    TEST_ASSERT_EQUAL_INT(_before.untracked, stats.untracked);
+}
+
+static void test_malloc_monitor_heap(void)
+{
+    /* keep the compiler from rejecting the failing allocation */
+    volatile size_t huge = SIZE_MAX / 2;
+    malloc_monitor_stats_t before, stats;
+    malloc_monitor_usage_t usage;
+    void *p, *q, *r;
+
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_HEAP, &before);
+    p = malloc(40);
+    q = calloc(4, 8);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_NOT_NULL(q);
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_HEAP, &stats);
+    TEST_ASSERT_EQUAL_INT(before.allocs + 2, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(before.usage.current + 72, stats.usage.current);
+
+    /* grow */
+    p = realloc(p, 400);
+    TEST_ASSERT_NOT_NULL(p);
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_HEAP, &stats);
+    TEST_ASSERT_EQUAL_INT(before.allocs + 3, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(before.frees + 1, stats.frees);
+    TEST_ASSERT_EQUAL_INT(before.usage.current + 432, stats.usage.current);
+
+    /* shrink */
+    p = realloc(p, 20);
+    TEST_ASSERT_NOT_NULL(p);
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_HEAP, &stats);
+    TEST_ASSERT_EQUAL_INT(before.allocs + 4, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(before.frees + 2, stats.frees);
+    TEST_ASSERT_EQUAL_INT(before.usage.current + 52, stats.usage.current);
+    TEST_ASSERT(stats.usage.peak >= before.usage.current + 432);
+
+    /* failure leaves the old allocation recorded */
+    r = realloc(p, huge);
+    TEST_ASSERT_NULL(r);
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_HEAP, &stats);
+    TEST_ASSERT_EQUAL_INT(before.failed + 1, stats.failed);
+    TEST_ASSERT_EQUAL_INT(before.frees + 2, stats.frees);
+    TEST_ASSERT_EQUAL_INT(before.usage.current + 52, stats.usage.current);
+    malloc_monitor_get_thread_usage(MALLOC_MONITOR_SRC_HEAP, thread_getpid(),
+                                    &usage);
+    TEST_ASSERT(usage.current >= 52);
+
+    free(p);
+    free(q);
+    malloc_monitor_get_stats(MALLOC_MONITOR_SRC_HEAP, &stats);
+    TEST_ASSERT_EQUAL_INT(before.frees + 4, stats.frees);
+    TEST_ASSERT_EQUAL_INT(before.usage.current, stats.usage.current);
+}
+
+static Test *tests_malloc_monitor_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_malloc_monitor_memarray),
+        new_TestFixture(test_malloc_monitor_tag),
+        new_TestFixture(test_malloc_monitor_partial_free),
+        new_TestFixture(test_malloc_monitor_partial_free_head),
+        new_TestFixture(test_malloc_monitor_pktbuf_mark),
+        new_TestFixture(test_malloc_monitor_hist),
+        new_TestFixture(test_malloc_monitor_untracked),
+        new_TestFixture(test_malloc_monitor_zero_size),
+        new_TestFixture(test_malloc_monitor_heap),
+    };
+
+    EMB_UNIT_TESTCALLER(malloc_monitor_tests, set_up, NULL, fixtures);
+
+    return (Test *)&malloc_monitor_tests;
+}
+
+void tests_malloc_monitor(void)
+{
+    TESTS_RUN(tests_malloc_monitor_tests());
+}
+/** @} */
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the memory allocation monitor
+ */
+#ifndef TESTS_MALLOC_MONITOR_H
+#define TESTS_MALLOC_MONITOR_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Entry point of the test suite
+ */
+void tests_malloc_monitor(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_MALLOC_MONITOR_H */
+/** @} */
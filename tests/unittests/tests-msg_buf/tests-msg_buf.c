@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "mbox.h"
+#include "msg_buf.h"
+#include "unittests-constants.h"
+#include "tests-msg_buf.h"
+
+#define TEST_BUF_SIZE       (13U)   /* intentionally not pointer aligned */
+#define TEST_BUF_NUM        (3U)
+#define TEST_MSG_TYPE       (0x6b6d)
+#define TEST_MBOX_SIZE      (2U)
+
+MSG_BUF_POOL(_pool_data, TEST_BUF_SIZE, TEST_BUF_NUM);
+static msg_buf_pool_t _pool;
+static msg_t _mbox_queue[TEST_MBOX_SIZE];
+static mbox_t _mbox;
+
+static void set_up(void)
+{
+    memset(_pool_data, 0, sizeof(_pool_data));
+    msg_buf_pool_init(&_pool, _pool_data, TEST_BUF_SIZE, TEST_BUF_NUM);
+    mbox_init(&_mbox, _mbox_queue, TEST_MBOX_SIZE);
+}
+
+static void test_msg_buf_alloc(void)
+{
+    msg_buf_t *bufs[TEST_BUF_NUM];
+
+    for (unsigned i = 0; i < TEST_BUF_NUM; i++) {
+        bufs[i] = msg_buf_alloc(&_pool);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        TEST_ASSERT(bufs[i]->pool == &_pool);
+        TEST_ASSERT_EQUAL_INT(TEST_BUF_SIZE, bufs[i]->size);
+        TEST_ASSERT_EQUAL_INT(0, bufs[i]->len);
+        TEST_ASSERT_EQUAL_INT(0, (uintptr_t)bufs[i] % sizeof(void *));
+        TEST_ASSERT((uint8_t *)bufs[i] >= (uint8_t *)_pool_data);
+        TEST_ASSERT((uint8_t *)&bufs[i]->data[TEST_BUF_SIZE] <=
+                    (uint8_t *)_pool_data + sizeof(_pool_data));
+        /* fill whole payload to detect overlapping buffers */
+        memset(bufs[i]->data, i, TEST_BUF_SIZE);
+    }
+    for (unsigned i = 0; i < TEST_BUF_NUM; i++) {
+        for (unsigned j = 0; j < TEST_BUF_SIZE; j++) {
+            TEST_ASSERT_EQUAL_INT(i, bufs[i]->data[j]);
+        }
+    }
+    TEST_ASSERT_NULL(msg_buf_alloc(&_pool));
+}
+
+static void test_msg_buf_free(void)
+{
+    msg_buf_t *bufs[TEST_BUF_NUM];
+
+    for (unsigned i = 0; i < TEST_BUF_NUM; i++) {
+        bufs[i] = msg_buf_alloc(&_pool);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        bufs[i]->len = TEST_BUF_SIZE;
+    }
+    msg_buf_free(bufs[1]);
+    /* the released buffer is reused and reset */
+    TEST_ASSERT(msg_buf_alloc(&_pool) == bufs[1]);
+    TEST_ASSERT_EQUAL_INT(0, bufs[1]->len);
+    for (unsigned i = 0; i < TEST_BUF_NUM; i++) {
+        msg_buf_free(bufs[i]);
+    }
+    for (unsigned i = 0; i < TEST_BUF_NUM; i++) {
+        TEST_ASSERT_NOT_NULL(msg_buf_alloc(&_pool));
+    }
+    TEST_ASSERT_NULL(msg_buf_alloc(&_pool));
+}
+
+static void test_msg_buf_wrap_get(void)
+{
+    msg_buf_t *buf = msg_buf_alloc(&_pool);
+    msg_t msg;
+
+    TEST_ASSERT_NOT_NULL(buf);
+    msg_buf_wrap(&msg, TEST_MSG_TYPE, buf);
+    TEST_ASSERT_EQUAL_INT(TEST_MSG_TYPE, msg.type);
+    TEST_ASSERT(msg_buf_get(&msg) == buf);
+}
+
+static void test_msg_buf_mbox(void)
+{
+    msg_buf_t *bufs[TEST_BUF_NUM];
+    msg_t msg;
+
+    for (unsigned i = 0; i < TEST_BUF_NUM; i++) {
+        bufs[i] = msg_buf_alloc(&_pool);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        memcpy(bufs[i]->data, TEST_STRING8, sizeof(TEST_STRING8) - 1);
+        bufs[i]->len = sizeof(TEST_STRING8) - 1;
+    }
+    for (unsigned i = 0; i < TEST_MBOX_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(1, msg_buf_mbox_try_put(&_mbox, TEST_MSG_TYPE,
+                                                      bufs[i]));
+    }
+    /* mailbox is full, so the caller keeps the buffer */
+    TEST_ASSERT_EQUAL_INT(0, msg_buf_mbox_try_put(&_mbox, TEST_MSG_TYPE,
+                                                  bufs[TEST_MBOX_SIZE]));
+    msg_buf_free(bufs[TEST_MBOX_SIZE]);
+    for (unsigned i = 0; i < TEST_MBOX_SIZE; i++) {
+        msg_buf_t *buf;
+
+        TEST_ASSERT_EQUAL_INT(1, mbox_try_get(&_mbox, &msg));
+        TEST_ASSERT_EQUAL_INT(TEST_MSG_TYPE, msg.type);
+        buf = msg_buf_get(&msg);
+        /* no copy was made */
+        TEST_ASSERT(buf == bufs[i]);
+        TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING8) - 1, buf->len);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING8, buf->data, buf->len));
+        msg_buf_free(buf);
+    }
+    TEST_ASSERT_EQUAL_INT(0, mbox_try_get(&_mbox, &msg));
+    for (unsigned i = 0; i < TEST_BUF_NUM; i++) {
+        TEST_ASSERT_NOT_NULL(msg_buf_alloc(&_pool));
+    }
+}
+
+static Test *tests_msg_buf_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_msg_buf_alloc),
+        new_TestFixture(test_msg_buf_free),
+        new_TestFixture(test_msg_buf_wrap_get),
+        new_TestFixture(test_msg_buf_mbox),
+    };
+
+    EMB_UNIT_TESTCALLER(msg_buf_tests, set_up, NULL, fixtures);
+
+    return (Test *)&msg_buf_tests;
+}
+
+void tests_msg_buf(void)
+{
+    TESTS_RUN(tests_msg_buf_tests());
+}
+/** @} */
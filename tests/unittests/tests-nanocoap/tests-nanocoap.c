@@ -836,6 +836,67 @@ static void test_nanocoap__token_length_over_limit(void)
     TEST_ASSERT_EQUAL_INT(-EBADMSG, res);
 }
 
+/*
+ * Verifies coap_find_resource() returns the first matching resource, as a
+ * linear search with coap_match_path() would.
+ */
+static void test_nanocoap__find_resource(void)
+{
+    static const coap_resource_t resources[] = {
+        { .path = "/a", .methods = COAP_GET | COAP_MATCH_SUBTREE },
+        { .path = "/a/b", .methods = COAP_GET },
+        { .path = "/a/b", .methods = COAP_POST },
+        { .path = "/ab", .methods = COAP_GET },
+        { .path = "/b", .methods = COAP_PUT },
+        { .path = "/b/c/", .methods = COAP_GET | COAP_MATCH_SUBTREE },
+        { .path = "/b/c/d", .methods = COAP_GET | COAP_POST },
+    };
+    const coap_resource_t *res = NULL;
+    const unsigned numof = ARRAY_SIZE(resources);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources, numof,
+                                                (uint8_t *)"/a/b", COAP_GET,
+                                                &res));
+    TEST_ASSERT(res == &resources[0]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources, numof,
+                                                (uint8_t *)"/a/b", COAP_POST,
+                                                &res));
+    TEST_ASSERT(res == &resources[2]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources, numof,
+                                                (uint8_t *)"/ab", COAP_GET,
+                                                &res));
+    TEST_ASSERT(res == &resources[0]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources, numof,
+                                                (uint8_t *)"/b/c/d", COAP_GET,
+                                                &res));
+    TEST_ASSERT(res == &resources[5]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources, numof,
+                                                (uint8_t *)"/b/c/d", COAP_POST,
+                                                &res));
+    TEST_ASSERT(res == &resources[6]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources, numof,
+                                                (uint8_t *)"/b/c/e", COAP_GET,
+                                                &res));
+    TEST_ASSERT(res == &resources[5]);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP,
+                          coap_find_resource(resources, numof,
+                                             (uint8_t *)"/ab", COAP_POST,
+                                             &res));
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP,
+                          coap_find_resource(resources, numof,
+                                             (uint8_t *)"/b", COAP_GET, &res));
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          coap_find_resource(resources, numof,
+                                             (uint8_t *)"/b/c", COAP_GET,
+                                             &res));
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          coap_find_resource(resources, numof,
+                                             (uint8_t *)"/", COAP_GET, &res));
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          coap_find_resource(resources, 0,
+                                             (uint8_t *)"/a", COAP_GET, &res));
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -863,6 +924,7 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__add_path_unterminated_string),
         new_TestFixture(test_nanocoap__add_get_proxy_uri),
         new_TestFixture(test_nanocoap__token_length_over_limit),
+        new_TestFixture(test_nanocoap__find_resource),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
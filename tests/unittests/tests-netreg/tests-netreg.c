@@ -26,6 +26,13 @@ static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
 
+/* contexts in the same and in another hash bucket than TEST_UINT16 */
+static gnrc_netreg_entry_t others[] = {
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16 + CONFIG_GNRC_NETREG_HASH_BUCKETS,
+                               TEST_UINT8 + 2),
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16 + 1, TEST_UINT8 + 3)
+};
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +146,29 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup__other_ctx(void)
+{
+    gnrc_netreg_entry_t *res = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &others[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &others[1]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                   others[0].demux_ctx)));
+    TEST_ASSERT(res == &others[0]);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                   others[1].demux_ctx)));
+    TEST_ASSERT(res == &others[1]);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &others[0]);
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, others[0].demux_ctx));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, others[1].demux_ctx));
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -149,6 +179,7 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_unregister__success3),
         new_TestFixture(test_netreg_lookup__wrong_type_undef),
         new_TestFixture(test_netreg_lookup__wrong_type_numof),
+        new_TestFixture(test_netreg_lookup__other_ctx),
         new_TestFixture(test_netreg_num__empty),
         new_TestFixture(test_netreg_num__wrong_type_undef),
         new_TestFixture(test_netreg_num__wrong_type_numof),
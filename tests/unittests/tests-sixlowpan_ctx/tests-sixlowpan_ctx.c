@@ -195,6 +195,55 @@ static void test_sixlowpan_ctx_remove(void)
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
 }
 
+static void test_sixlowpan_ctx_remove__wrong_id(void)
+{
+    uint32_t gen = gnrc_sixlowpan_ctx_generation();
+
+    gnrc_sixlowpan_ctx_remove(GNRC_SIXLOWPAN_CTX_SIZE);
+    TEST_ASSERT_EQUAL_INT(gen, gnrc_sixlowpan_ctx_generation());
+}
+
+static void test_sixlowpan_ctx_generation__unchanged(void)
+{
+    uint32_t gen;
+
+    test_sixlowpan_ctx_update__success();
+    gen = gnrc_sixlowpan_ctx_generation();
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_lookup_id(DEFAULT_TEST_ID));
+    TEST_ASSERT_EQUAL_INT(gen, gnrc_sixlowpan_ctx_generation());
+}
+
+static void test_sixlowpan_ctx_generation__update(void)
+{
+    uint32_t gen = gnrc_sixlowpan_ctx_generation();
+
+    test_sixlowpan_ctx_update__success();
+    TEST_ASSERT(gen != gnrc_sixlowpan_ctx_generation());
+}
+
+static void test_sixlowpan_ctx_generation__remove(void)
+{
+    uint32_t gen;
+
+    test_sixlowpan_ctx_update__success();
+    gen = gnrc_sixlowpan_ctx_generation();
+    gnrc_sixlowpan_ctx_remove(DEFAULT_TEST_ID);
+    TEST_ASSERT(gen != gnrc_sixlowpan_ctx_generation());
+}
+
+static void test_sixlowpan_ctx_generation__try_remove(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_PREFIX;
+    uint32_t gen;
+
+    test_sixlowpan_ctx_update__success();
+    gen = gnrc_sixlowpan_ctx_generation();
+    TEST_ASSERT(gnrc_sixlowpan_ctx_try_remove(DEFAULT_TEST_ID));
+    TEST_ASSERT(gen != gnrc_sixlowpan_ctx_generation());
+    TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_id(DEFAULT_TEST_ID));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
+}
+
 Test *tests_sixlowpan_ctx_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -211,6 +260,11 @@ Test *tests_sixlowpan_ctx_tests(void)
         new_TestFixture(test_sixlowpan_ctx_lookup_id__wrong_id),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__success),
         new_TestFixture(test_sixlowpan_ctx_remove),
+        new_TestFixture(test_sixlowpan_ctx_remove__wrong_id),
+        new_TestFixture(test_sixlowpan_ctx_generation__unchanged),
+        new_TestFixture(test_sixlowpan_ctx_generation__update),
+        new_TestFixture(test_sixlowpan_ctx_generation__remove),
+        new_TestFixture(test_sixlowpan_ctx_generation__try_remove),
     };
 
     EMB_UNIT_TESTCALLER(sixlowpan_ctx_tests, NULL, tear_down, fixtures);